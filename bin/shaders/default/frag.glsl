@@ -9,7 +9,7 @@
  *               Fragment shader.
  * PROGRAMMER  : CGSG-SummerCamp'2025.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 04.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -32,15 +32,24 @@ void main( void )
 {
   vec3 L = -CamDirProjDist.xyz;
 
+#if !defined(TEX_VARIANTS) || defined(HAS_TEX0)
   vec4 T = texture(Tex, vec2(DrawTexCoord.x, DrawTexCoord.y));
   
   if (T.w < 0.102)
     discard;
+#endif /* !TEX_VARIANTS || HAS_TEX0 */
 
   vec3 Kdf = Shade(DrawPos, normalize(DrawNormal), KdTrans.xyz, KsPh.xyz, KsPh.w, 
     normalize(L), vec3(1, 1, 1));
+#ifdef TEX_VARIANTS
+  /* Texture slots are known at compile time (material selected variant) */
+#ifdef HAS_TEX0
+  Kdf *= T.xyz;
+#endif /* HAS_TEX0 */
+#else
   if (TextureFlags[0])
     Kdf *= T.xyz;
+#endif /* TEX_VARIANTS */
 
   OutColor = vec4(Kdf, KdTrans.w);
 } /* End of 'main' function */
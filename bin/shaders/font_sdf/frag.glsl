@@ -0,0 +1,43 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+ 
+/* FILE NAME   : frag.glsl
+ * PURPOSE     : Animation project.
+ *               Font (signed distance field) shader program module.
+ *               Fragment shader.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+
+layout(binding = 0) uniform sampler2D Tex;
+
+layout(location = 0) out vec4 OutColor;
+
+in vec4 DrawColor;
+in vec3 DrawNormal;
+in vec3 DrawPos;
+in vec3 DrawWPos;
+in vec2 DrawTexCoord;
+
+/* The main program function */
+void main( void )
+{
+  /* Distance 0.5 is glyph edge: antialias over one screen pixel at any size */
+  float d = texture(Tex, DrawTexCoord).r;
+  float w = max(fwidth(d) * 0.5, 0.0001);
+  float a = smoothstep(0.5 - w, 0.5 + w, d);
+ 
+  if (a < 0.01)
+    discard;
+  OutColor = vec4(DrawColor.rgb, DrawColor.a * a);
+} /* End of 'main' function */
+
+/* END OF 'frag.glsl' FILE */
@@ -9,7 +9,7 @@
  *               Main implementation module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7)
- * LAST UPDATE : 01.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -59,22 +59,78 @@ std::string & tse::anim::Path( VOID )
  */
 VOID tse::anim::Render( VOID )
 {
+  /* Frame pacing (before input to keep latency low) */
+  render::FrameWait();
+
   /* Response */
-  if (IsActive)
-    input::Response();
+  {
+    TSE_PROFILE("Input");
+    if (IsActive)
+      input::Response();
+  }
+  /* Idle gaps between on demand frames are not frame times */
+  IsFrameTimesRecord = FrameMode != frame_mode::ON_DEMAND;
   timer::Response();
-  Units.Walk([]( unit *Uni )
+
+  /* Thread safe units run on workers while the rest run here */
+  auto Dispatch = [this]( auto Call )
     {
-      Uni->Response();
-    });
+      job_system::counter cnt {0};
+      Units.Walk([&]( unit *Uni )
+        {
+          if (Uni->IsConcurrent)
+            Jobs.Spawn(cnt, [Uni, Call]( VOID ){ TSE_PROFILE(Uni->Name); Call(Uni); });
+          else
+          {
+            TSE_PROFILE(Uni->Name);
+            Call(Uni);
+          }
+        });
+      Jobs.Wait(cnt);
+    };
+
+  /* Fixed step simulation (rendering interpolates with 'SimAlpha') */
+  for (INT i = 0; i < SimSteps; i++, SimTime += SimStep, SimTick++)
+  {
+    TSE_PROFILE("Simulate");
+    Dispatch([this]( unit *Uni ){ Uni->Simulate(SimStep); });
+  }
+  {
+    TSE_PROFILE("Response");
+    Dispatch([]( unit *Uni ){ Uni->Response(); });
+  }
+  {
+    TSE_PROFILE("Scene");
+    Scene.Update();
+    SceneBVH.Sync(Scene);
+
+    /* Camera is final after units response */
+    for (INT node : VisibleNodes)
+      NodeVisible[node] = 0;
+    VisibleNodes.clear();
+    SceneBVH.Cull(Cam.VP, VisibleNodes);
+    for (INT node : VisibleNodes)
+    {
+      if (node >= (INT)NodeVisible.size())
+        NodeVisible.resize(node + 1);
+      NodeVisible[node] = 1;
+    }
+  }
 
   /* Render */
   render::FrameStart();
-  Units.Walk([]( unit *Uni )
-    {
-      Uni->Render();
-    });
+  {
+    TSE_PROFILE("Render");
+    Units.Walk([this]( unit *Uni )
+      {
+        TSE_PROFILE(Uni->Name);
+        GPUProf.Begin(Uni->Name);
+        Uni->Render();
+        GPUProf.End();
+      });
+  }
   render::FrameEnd();
+  profiler::FrameMark();
 } /* End of 'tse::anim::Render' function */
 
 /* Start window message loop function.
@@ -93,19 +149,1081 @@ VOID tse::anim::Run( VOID )
         break;
       else
       {
-        /* Displatch message to window */
+        /* Displatch message to window (any message may change picture) */
         TranslateMessage(&msg);
         DispatchMessage(&msg);
+        IsRedraw = TRUE;
       }
+    else if (FrameMode == frame_mode::ON_DEMAND && !IsRedraw)
+    {
+      /* Sleep until message, slow heartbeat keeps hot reload and loading visible */
+      if (MsgWaitForMultipleObjects(0, nullptr, FALSE, 250, QS_ALLINPUT) == WAIT_TIMEOUT)
+        IsRedraw = TRUE;
+    }
     else
     {
-      /* Idle... */
+      /* The only place frames are produced */
+      IsRedraw = FALSE;
       Render();
       Idle();
     }
   }
 } /* End of 'tse::anim::Run' function */
 
+/* Run headless (offscreen) benchmark function.
+ * ARGUMENTS:
+ *   - run parameters:
+ *       const HEADLESS_PARAMS &Params;
+ * RETURNS:
+ *   (INT) error level (0 for success).
+ */
+INT tse::anim::RunHeadless( const HEADLESS_PARAMS &Params )
+{
+  if (!render::InitHeadless(Params.W, Params.H))
+    return 1;
+  win::W = Params.W;
+  win::H = Params.H;
+  IsActive = FALSE;
+  IsVariantsEnabled = Params.IsVariants;
+  for (auto &u : Params.Units)
+    *this << u;
+  /* Measured frames should not use fallback shaders (warm-up frame selects lazy variants)
+   * nor placeholder resources */
+  shader_manager::WaitAll();
+  resource_loader::LoaderWaitAll();
+  texture_manager::TexStreamWaitAll();
+  Render();
+  shader_manager::WaitAll();
+
+  std::ofstream f(Params.OutPrefix + ".csv");
+  if (!f.is_open())
+    tse::logger::Warn("Cannot write headless timings: " + Params.OutPrefix + ".csv");
+  f << "frame;frame_ms;cpu_ms;gpu_wait_ms;present_ms;hitch\n";
+
+  std::vector<DBL> cpu;
+  profiler::Enable(Params.IsProfile);
+  auto start = std::chrono::steady_clock::now();
+  for (INT i = 0; i < Params.Frames; i++)
+  {
+    Render();
+    cpu.push_back(FrameStats.CPUFrameTime);
+    f << std::format("{};{:.4f};{:.4f};{:.4f};{:.4f};{}\n",
+      i, FrameTime(), FrameStats.CPUFrameTime, FrameStats.GPUWaitTime, FrameStats.PresentTime, IsHitch ? 1 : 0);
+  }
+  glFinish();
+  DBL total = std::chrono::duration<DBL>(std::chrono::steady_clock::now() - start).count();
+
+  /* Summary */
+  std::sort(cpu.begin(), cpu.end());
+  gpu_profiler::STATS gpu = GPUProf.Stats(GPUProf.Zone("Frame"));
+  if (!cpu.empty())
+    tse::logger::Info(std::format("Headless: {} frames in {:.3f} s ({:.1f} FPS), CPU p50 {:.3f} p99 {:.3f} ms, "
+      "GPU avg {:.3f} p99 {:.3f} ms, shader variants {}", Params.Frames, total, Params.Frames / total,
+      cpu[(cpu.size() - 1) / 2], cpu[(cpu.size() - 1) * 99 / 100], gpu.Avg, gpu.P99,
+      Params.IsVariants ? "on" : "off"));
+  FRAME_TIME_STATS ft = FrameTimeStats(Params.Frames);
+  tse::logger::Info(std::format("Headless frame times: avg {:.3f} p50 {:.3f} p95 {:.3f} p99 {:.3f} max {:.3f} ms, "
+    "{} hitches", ft.Avg, ft.P50, ft.P95, ft.P99, ft.Max, ft.Hitches));
+  GPUProf.Dump(Params.OutPrefix + "_gpu.csv");
+  FrameTimesDump(Params.OutPrefix + "_frames.csv");
+
+  /* CPU profile: recorded zones cost against measured frame time */
+  if (Params.IsProfile)
+  {
+    INT events = profiler::NumOfEvents();
+    tse::logger::Info("Headless CPU profile (per frame):\n" + profiler::Report());
+    if (profiler::DumpTrace(Params.OutPrefix + "_trace.json"))
+      tse::logger::Info("CPU trace saved: " + Params.OutPrefix + "_trace.json");
+    DBL zone_ns = profiler::ZoneCost();
+    tse::logger::Info(std::format("CPU profiler overhead: {:.1f} ns/zone, {:.1f} zones/frame, {:.3f}% of frame time",
+      zone_ns, (DBL)events / Params.Frames, 100 * zone_ns * 1e-6 * events / (total * 1000)));
+    profiler::Enable(FALSE);
+  }
+
+  if (Screenshot().SavePNG(Params.OutPrefix + ".png"))
+    tse::logger::Info("Last frame saved: " + Params.OutPrefix + ".png");
+  render::Close();
+  return 0;
+} /* End of 'tse::anim::RunHeadless' function */
+
+/* Run draw submission CPU cost benchmark function.
+ * ARGUMENTS:
+ *   - number of measured draws:
+ *       INT Count;
+ *   - output files prefix (command trace):
+ *       const std::string &OutPrefix;
+ * RETURNS:
+ *   (INT) error level (0 for success).
+ */
+INT tse::anim::RunSubmitBench( INT Count, const std::string &OutPrefix )
+{
+  if (!render::InitHeadless(640, 480))
+    return 1;
+  std::vector<vertex_std4> V
+  {
+    {{0, 0, 0}, {0, 0}, {0, 0, 1}, {1, 1, 1, 1}},
+    {{1, 0, 0}, {1, 0}, {0, 0, 1}, {1, 1, 1, 1}},
+    {{0, 1, 0}, {0, 1}, {0, 0, 1}, {1, 1, 1, 1}},
+  };
+  prim *pr = PrimCreate<vertex_std4>(nullptr, prim_type::TRIMESH, V, {});
+  font *fnt = FntCreate("Book");
+  fnt->Load("bin/fonts/Book.g3df");
+  shader_manager::WaitAll();
+  const std::string str = "FPS: 123.456789";
+
+  /* Measure 'Count' calls of submission function */
+  auto Measure = [&]( const CHAR *Name, INT N, INT Items, const std::function<VOID( VOID )> &F )
+    {
+      render::FrameStart();
+#ifdef TSE_NULL_RENDER
+      gl_null::Reset();
+#endif /* TSE_NULL_RENDER */
+      auto start = std::chrono::steady_clock::now();
+      for (INT i = 0; i < N; i++)
+        F();
+      font_manager::Flush();
+      DBL ns = std::chrono::duration<DBL, std::nano>(std::chrono::steady_clock::now() - start).count();
+      tse::logger::Info(std::format("{}: {} calls, {:.1f} ns/call, {:.1f} ns/item", Name, N, ns / N, ns / N / Items));
+#ifdef TSE_NULL_RENDER
+      tse::logger::LogLn(std::format("  GL calls per call: {:.2f}, draws per call: {:.2f}",
+        (DBL)gl_null::TotalCalls() / N, (DBL)gl_null::Counters.DrawCalls / N));
+#endif /* TSE_NULL_RENDER */
+      render::FrameEnd();
+    };
+  Measure("render::Draw", Count, 1, [&]( VOID ){ render::Draw(pr); });
+  Measure("font::Draw", Count / 10 + 1, (INT)str.size(), [&]( VOID ){ fnt->Draw(str, vec3(0), 16); });
+
+#ifdef TSE_NULL_RENDER
+  /* Record command streams of single calls */
+  gl_null::Reset();
+  gl_null::IsTracing = TRUE;
+  render::Draw(pr);
+  gl_null::SaveTrace(OutPrefix + "_draw.trace");
+  gl_null::Reset();
+  fnt->Draw(str, vec3(0), 16);
+  font_manager::Flush();
+  gl_null::SaveTrace(OutPrefix + "_font.trace");
+  gl_null::IsTracing = FALSE;
+  tse::logger::LogLn("Single font::Draw commands:\n" + gl_null::Report());
+#endif /* TSE_NULL_RENDER */
+
+  PrimFree(pr);
+  font_manager::Delete(fnt);
+  render::Close();
+  return 0;
+} /* End of 'tse::anim::RunSubmitBench' function */
+
+/* Run shader programs cold/warm (binary cache) load benchmark function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (INT) error level (0 for success).
+ */
+INT tse::anim::RunShaderBench( VOID )
+{
+  if (!render::InitHeadless(64, 64))
+    return 1;
+
+  /* Every shader directory except includes and service ('~') ones */
+  std::vector<std::string> names;
+  std::error_code ec;
+  for (auto &e : std::filesystem::directory_iterator(Path() + "bin/shaders", ec))
+    if (std::string name = e.path().filename().string();
+        e.is_directory() && name != "includes" && name[0] != '~')
+      names.push_back(name);
+
+  /* Load all programs, returns total time in ms */
+  auto LoadAll = [&]( const CHAR *Pass )
+    {
+      DBL total = 0;
+      INT hits = 0;
+      for (auto &name : names)
+      {
+        shader shd(name);
+        shd.Load();
+        total += shd.LoadTime;
+        hits += shd.IsFromCache;
+        shd.Free();
+      }
+      tse::logger::Info(std::format("{} load: {} programs, {} from cache, {:.2f} ms",
+        Pass, names.size(), hits, total));
+      return total;
+    };
+  std::filesystem::remove_all(Path() + "bin/shaders/~cache", ec);
+  DBL cold = LoadAll("Cold");
+  DBL warm = LoadAll("Warm");
+  tse::logger::Info(std::format("Shader binary cache speedup: {:.1f}x", warm > 0 ? cold / warm : 0.0));
+
+  render::Close();
+  return 0;
+} /* End of 'tse::anim::RunShaderBench' function */
+
+/* Run shared vertex arrays setup benchmark function.
+ * ARGUMENTS:
+ *   - number of primitives:
+ *       INT Count;
+ * RETURNS:
+ *   (INT) error level (0 for success).
+ */
+INT tse::anim::RunVAOBench( INT Count )
+{
+  if (!render::InitHeadless(640, 480))
+    return 1;
+  shader_manager::WaitAll();
+
+  /* Two vertex formats mixed in scene */
+  struct vertex_pc
+  {
+    vec3 P; // Position
+    vec4 C; // Color
+  };
+  std::vector<vertex_std4> v4
+  {
+    {{0, 0, 0}, {0, 0}, {0, 0, 1}, {1, 1, 1, 1}},
+    {{1, 0, 0}, {1, 0}, {0, 0, 1}, {1, 1, 1, 1}},
+    {{0, 1, 0}, {0, 1}, {0, 0, 1}, {1, 1, 1, 1}},
+  };
+  std::vector<vertex_pc> vpc
+  {
+    {{0, 0, 0}, {1, 0, 0, 1}},
+    {{1, 0, 0}, {0, 1, 0, 1}},
+    {{0, 1, 0}, {0, 0, 1, 1}},
+  };
+  std::vector<prim *> prims;
+  for (INT i = 0; i < Count; i++)
+    prims.push_back(i % 2 == 0 ?
+      PrimCreate<vertex_std4>(nullptr, prim_type::TRIMESH, v4, {}) :
+      PrimCreate<vertex_pc>(nullptr, prim_type::TRIMESH, vpc, {}));
+
+  /* First pass creates vertex arrays, second one only reuses them */
+  auto Pass = [&]( VOID )
+    {
+      render::FrameStart();
+      auto start = std::chrono::steady_clock::now();
+      for (auto *pr : prims)
+        render::Draw(pr);
+      DBL ms = std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - start).count();
+      render::FrameEnd();
+      return ms;
+    };
+  DBL first = Pass(), second = Pass();
+  tse::logger::Info(std::format("VAO bench: {} primitives, {} shared vertex arrays (one per primitive before), "
+    "setup {:.3f} ms, first pass {:.2f} ms, second pass {:.2f} ms",
+    Count, NumOfVertexArrays(), VertexArraysSetupTime, first, second));
+
+  render::Close();
+  return 0;
+} /* End of 'tse::anim::RunVAOBench' function */
+
+/* Run job system scheduler micro benchmark function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (INT) error level (0 for success).
+ */
+INT tse::anim::RunJobBench( VOID )
+{
+  auto Ms = []( auto Start )
+    {
+      return std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - Start).count();
+    };
+  tse::logger::Info(std::format("JOB bench: {} workers", Jobs.NumOfWorkers()));
+
+  /* Spawn cost: empty jobs from external thread */
+  const INT num_of_jobs = 1000000;
+  job_system::counter cnt {0};
+  Jobs.ResetStats();
+  auto start = std::chrono::steady_clock::now();
+  for (INT i = 0; i < num_of_jobs; i++)
+    Jobs.Spawn(cnt, []( VOID ){});
+  DBL spawn_ms = Ms(start);
+  Jobs.Wait(cnt);
+  DBL total_ms = Ms(start);
+  job_system::STATS st = Jobs.Stats();
+  tse::logger::Info(std::format("JOB spawn: {:.1f} ns/job spawn, {:.1f} ns/job spawn+run, stolen {:.1f}%",
+    spawn_ms * 1e6 / num_of_jobs, total_ms * 1e6 / num_of_jobs, 100.0 * st.Stolen / std::max(1ull, st.Executed)));
+
+  /* Parallel for scaling: per element simulation step */
+  std::vector<matr> objs(1 << 18, matr::Identity());
+  matr rot = matr::RotateY(1);
+  auto Simulate = [&]( INT Begin, INT End )
+    {
+      for (INT i = Begin; i < End; i++)
+        for (INT k = 0; k < 16; k++)
+          objs[i] = objs[i] * rot;
+    };
+  start = std::chrono::steady_clock::now();
+  Simulate(0, (INT)objs.size());
+  DBL serial_ms = Ms(start);
+  start = std::chrono::steady_clock::now();
+  Jobs.ParallelFor(0, (INT)objs.size(), Simulate);
+  DBL parallel_ms = Ms(start);
+  tse::logger::Info(std::format("JOB parallel for: {} elements, serial {:.2f} ms, parallel {:.2f} ms, speedup {:.2f}x",
+    objs.size(), serial_ms, parallel_ms, serial_ms / parallel_ms));
+
+  /* Recursive fork-join: work spreads only through stealing */
+  std::function<INT( INT )> Fib = [&]( INT N ) -> INT
+    {
+      if (N < 16)
+      {
+        INT a = 0, b = 1;
+        for (INT i = 0; i < N; i++)
+          b = std::exchange(a, b) + b;
+        return a;
+      }
+      job_system::counter c {0};
+      INT x = 0;
+      Jobs.Spawn(c, [&]( VOID ){ x = Fib(N - 1); });
+      INT y = Fib(N - 2);
+      Jobs.Wait(c);
+      return x + y;
+    };
+  Jobs.ResetStats();
+  start = std::chrono::steady_clock::now();
+  INT fib = Fib(32);
+  DBL fib_ms = Ms(start);
+  st = Jobs.Stats();
+  tse::logger::Info(std::format("JOB fork-join: fib(32) = {} in {:.2f} ms, {} jobs, {} stolen ({:.1f}%), "
+    "steal success {:.1f}% of {} attempts",
+    fib, fib_ms, st.Executed, st.Stolen, 100.0 * st.Stolen / std::max(1ull, st.Executed),
+    100.0 * st.Stolen / std::max(1ull, st.StealAttempts), st.StealAttempts));
+
+  /* Task graph: layered dependencies rerun as every frame */
+  task_graph graph;
+  std::vector<INT> layer, prev;
+  std::atomic_int runs {0};
+  for (INT l = 0; l < 8; l++, prev = std::exchange(layer, {}))
+    for (INT i = 0; i < 32; i++)
+      if (prev.empty())
+        layer.push_back(graph.Add([&]( VOID ){ runs++; }));
+      else
+        layer.push_back(graph.Add([&]( VOID ){ runs++; }, {prev[i], prev[(i + 1) % prev.size()]}));
+  const INT num_of_runs = 1000;
+  start = std::chrono::steady_clock::now();
+  for (INT i = 0; i < num_of_runs; i++)
+    graph.Run(Jobs);
+  tse::logger::Info(std::format("JOB task graph: 256 tasks in 8 layers of 32, {:.1f} us/run, {} tasks run",
+    Ms(start) * 1000 / num_of_runs, runs.load()));
+  return 0;
+} /* End of 'tse::anim::RunJobBench' function */
+
+/* Run synchronous vs asynchronous logging benchmark function.
+ * ARGUMENTS:
+ *   - number of messages:
+ *       INT Count;
+ * RETURNS:
+ *   (INT) error level (0 for success).
+ */
+INT tse::anim::RunLogBench( INT Count )
+{
+  std::string file_name = Path() + "bin/logbench.log";
+  FILE *F = std::fopen(file_name.c_str(), "w");
+  if (F == nullptr)
+  {
+    tse::logger::Err("LOG bench: can't create " + file_name);
+    return 1;
+  }
+
+  auto Sec = []( VOID )
+    {
+      return std::chrono::duration<DBL>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    };
+
+  /* Call latency percentiles (in microseconds) */
+  auto Percentiles = []( std::vector<DBL> &Lat )
+    {
+      std::sort(Lat.begin(), Lat.end());
+      return std::pair(Lat[Lat.size() / 2] * 1e6, Lat[Lat.size() * 99 / 100] * 1e6);
+    };
+  Count = std::max(Count, 100);
+  std::vector<DBL> lat(Count);
+
+  /* Synchronous baseline: format, write and flush on caller thread */
+  DBL start = Sec();
+  for (INT i = 0; i < Count; i++)
+  {
+    DBL t = Sec();
+    std::fputs(std::format("[INFO] frame {} unit {} took {:.3f} ms\n", i, i % 17, i * 0.001).c_str(), F);
+    std::fflush(F);
+    lat[i] = Sec() - t;
+  }
+  DBL sync_time = Sec() - start;
+  DBL text_size = std::ftell(F);
+  auto [sync_p50, sync_p99] = Percentiles(lat);
+
+  /* Asynchronous logger from one thread.
+   * Bursts fit in half of ring and are flushed out of timed calls, so every
+   * message is written (dropped calls are cheap and would inflate rates) */
+  const INT burst = logger::RingSize / 2;
+  tse::logger::SetOutput(F);
+  logger::STATS st0 = tse::logger::Stats();
+  DBL async_time = 0, async_flush_time = 0;
+  for (INT i = 0; i < Count; i++)
+  {
+    DBL t = Sec();
+    tse::logger::Info(std::format("frame {} unit {} took {:.3f} ms", i, i % 17, i * 0.001));
+    lat[i] = Sec() - t;
+    async_time += lat[i];
+    if ((i + 1) % burst == 0 || i == Count - 1)
+    {
+      t = Sec();
+      tse::logger::Flush();
+      async_flush_time += Sec() - t;
+    }
+  }
+  async_flush_time += async_time;
+  auto [async_p50, async_p99] = Percentiles(lat);
+
+  /* Asynchronous logger from several threads (burst is shared by threads) */
+  const INT num_of_threads = 4, mt_count = Count / num_of_threads, mt_burst = burst / num_of_threads;
+  DBL mt_flush_time = 0;
+  std::barrier sync(num_of_threads, [&]( VOID ) noexcept
+    {
+      DBL t = Sec();
+      tse::logger::Flush();
+      mt_flush_time += Sec() - t;
+    });
+  std::vector<std::thread> threads;
+  start = Sec();
+  for (INT t = 0; t < num_of_threads; t++)
+    threads.emplace_back([&, t]( VOID )
+      {
+        for (INT i = 0; i < mt_count; i++)
+        {
+          tse::logger::Info(std::format("thread {} message {}", t, i));
+          if ((i + 1) % mt_burst == 0 || i == mt_count - 1)
+            sync.arrive_and_wait();
+        }
+      });
+  for (std::thread &th : threads)
+    th.join();
+  DBL mt_time = Sec() - start - mt_flush_time;
+  logger::STATS st = tse::logger::Stats();
+  tse::logger::SetOutput(nullptr);
+  std::fclose(F);
+
+  /* Binary structured log: arguments only, formatting is left to decoder */
+  std::string bin_name = Path() + "bin/logbench.tlog";
+  if (!tse::logger::SetBinaryOutput(bin_name))
+  {
+    tse::logger::Err("LOG bench: can't create " + bin_name);
+    return 1;
+  }
+  UINT64 bin_events0, bin_events, bin_bytes;
+  binlog::Stats(bin_events0, bin_bytes);
+  start = Sec();
+  for (INT i = 0; i < Count; i++)
+  {
+    DBL t = Sec();
+    TSE_LOGF(INFO, "frame {} unit {} took {:.3f} ms", i, i % 17, i * 0.001);
+    lat[i] = Sec() - t;
+  }
+  DBL bin_time = Sec() - start;
+  auto [bin_p50, bin_p99] = Percentiles(lat);
+  tse::logger::Flush();
+  binlog::Stats(bin_events, bin_bytes);
+  bin_events -= bin_events0;
+  tse::logger::SetBinaryOutput("");
+  UINT64 bin_size = std::filesystem::file_size(bin_name);
+
+  /* Rates are valid for written messages only */
+  if (UINT64 dropped = st.Dropped - st0.Dropped; dropped != 0)
+    tse::logger::Warn(std::format("LOG bench: {} async messages dropped, rates are overstated", dropped));
+  if (bin_events != (UINT64)Count)
+    tse::logger::Warn(std::format("LOG bench: {} of {} binary events recorded", bin_events, Count));
+
+  tse::logger::Info(std::format("LOG sync fprintf+fflush: {:.0f} msg/s, call p50 {:.2f} us, p99 {:.2f} us",
+    Count / sync_time, sync_p50, sync_p99));
+  tse::logger::Info(std::format("LOG async: {:.0f} msg/s ({:.0f} msg/s including flush), call p50 {:.2f} us, p99 {:.2f} us",
+    Count / async_time, Count / async_flush_time, async_p50, async_p99));
+  tse::logger::Info(std::format("LOG async {} threads: {:.0f} msg/s", num_of_threads,
+    mt_count * num_of_threads / mt_time));
+  tse::logger::Info(std::format("LOG async written {}, dropped {} (ring {} messages), {:.1f} messages per write",
+    st.Written - st0.Written, st.Dropped - st0.Dropped, logger::RingSize,
+    DBL(st.Written - st0.Written) / std::max(1ull, st.Batches - st0.Batches)));
+  tse::logger::Info(std::format("LOG binary: {:.0f} msg/s, call p50 {:.2f} us, p99 {:.2f} us, "
+    "{:.1f} bytes/msg vs {:.1f} text bytes/msg (decode: -logdecode {})",
+    Count / bin_time, bin_p50, bin_p99, DBL(bin_size - 16) / std::max(1ull, bin_events), text_size / Count,
+    bin_name));
+  return 0;
+} /* End of 'tse::anim::RunLogBench' function */
+
+/* Create synthetic loading benchmark assets function.
+ * Files are created in 'bin/loadbench/' once and reused by next runs.
+ * ARGUMENTS:
+ *   - number of textures and models:
+ *       INT Count;
+ *   - assets parameters and result files:
+ *       BENCH_ASSETS &Assets;
+ * RETURNS:
+ *   (BOOL) TRUE if success.
+ */
+BOOL tse::anim::CreateBenchAssets( INT Count, BENCH_ASSETS &Assets )
+{
+  std::string dir = Path() + "bin/loadbench/";
+  std::filesystem::create_directories(dir);
+  const INT tex_size = Assets.TexSize, mdl_tex_size = Assets.MdlTexSize,
+    prims_per_model = Assets.PrimsPerModel, grid = Assets.Grid;
+  for (INT i = 0; i < Count; i++)
+  {
+    std::string name = std::format("{}tex{}.png", dir, i);
+    if (!std::filesystem::exists(name))
+    {
+      image img(tex_size, tex_size);
+      for (INT y = 0; y < tex_size; y++)
+        for (INT x = 0; x < tex_size; x++)
+        {
+          BYTE *c = img.RowsB[y][x];
+          c[0] = (BYTE)(x * 7 + i * 13), c[1] = (BYTE)(y * 5 + x * y), c[2] = (BYTE)(x ^ y ^ i), c[3] = 255;
+        }
+      if (!img.SavePNG(name))
+      {
+        tse::logger::Err("LOAD bench: can't create " + name);
+        return FALSE;
+      }
+    }
+    Assets.Textures.push_back(name);
+    Assets.Bytes += std::filesystem::file_size(name);
+
+    name = std::format("{}model{}.g3dm", dir, i);
+    if (!std::filesystem::exists(name))
+    {
+      std::ofstream f(name, std::ios::binary);
+      auto Put = [&f]( const auto &Val ){ f.write((const CHAR *)&Val, sizeof(Val)); };
+      f.write("G3DM", 4);
+      Put((INT)prims_per_model), Put((INT)1), Put((INT)1);
+      for (INT p = 0; p < prims_per_model; p++)
+      {
+        std::vector<vertex_std4> V;
+        std::vector<INT> Ind;
+        for (INT y = 0; y < grid; y++)
+          for (INT x = 0; x < grid; x++)
+            V.push_back({{(FLT)x, (FLT)y, (FLT)p}, {(FLT)x / grid, (FLT)y / grid}, {0, 0, 1}, {1, 1, 1, 1}});
+        for (INT y = 0; y < grid - 1; y++)
+          for (INT x = 0; x < grid - 1; x++)
+            for (INT k : {0, 1, grid, 1, grid + 1, grid})
+              Ind.push_back(y * grid + x + k);
+        Put((UINT)V.size()), Put((UINT)Ind.size()), Put((INT)0);
+        f.write((const CHAR *)V.data(), V.size() * sizeof(vertex_std4));
+        f.write((const CHAR *)Ind.data(), Ind.size() * sizeof(INT));
+      }
+      model::STORE_MATERIAL sm {};
+      std::strcpy(sm.Name, "Mtl");
+      sm.Ka = mth::vec3<FLT>(0.1), sm.Kd = mth::vec3<FLT>(0.9), sm.Ks = mth::vec3<FLT>(0);
+      sm.Ph = 30, sm.Trans = 1;
+      for (INT &t : sm.Tex)
+        t = -1;
+      sm.Tex[0] = 0;
+      Put(sm);
+      CHAR tex_name[300] {"Tex"};
+      f.write(tex_name, sizeof(tex_name));
+      Put((INT)mdl_tex_size), Put((INT)mdl_tex_size), Put((INT)4);
+      std::vector<BYTE> pixels(mdl_tex_size * mdl_tex_size * 4, (BYTE)(i * 17));
+      f.write((const CHAR *)pixels.data(), pixels.size());
+    }
+    Assets.Models.push_back(name);
+    Assets.Bytes += std::filesystem::file_size(name);
+  }
+  return TRUE;
+} /* End of 'tse::anim::CreateBenchAssets' function */
+
+/* Run synchronous vs asynchronous resources loading benchmark function.
+ * ARGUMENTS:
+ *   - number of textures and models:
+ *       INT Count;
+ * RETURNS:
+ *   (INT) error level (0 for success).
+ */
+INT tse::anim::RunLoadBench( INT Count )
+{
+  if (!render::InitHeadless(640, 480))
+    return 1;
+  shader_manager::WaitAll();
+  Count = std::max(Count, 1);
+
+  /* Synthetic assets: PNG textures and G3DM models with embedded texture */
+  BENCH_ASSETS assets;
+  if (!CreateBenchAssets(Count, assets))
+  {
+    render::Close();
+    return 1;
+  }
+  const INT tex_size = assets.TexSize, mdl_tex_size = assets.MdlTexSize, prims_per_model = assets.PrimsPerModel;
+  const std::vector<std::string> &tex_names = assets.Textures, &mdl_names = assets.Models;
+  UINT64 file_bytes = assets.Bytes;
+
+  auto Ms = []( std::chrono::steady_clock::time_point Start )
+    {
+      return std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - Start).count();
+    };
+  std::vector<texture *> texs;
+  std::vector<std::unique_ptr<model>> mdls;
+  auto FreeAll = [&]( VOID )
+    {
+      for (auto *tex : texs)
+        texture_manager::Delete(tex);
+      for (auto &m : mdls)
+        for (auto *pr : m->Prims)
+          PrimFree(pr);
+      texs.clear();
+      mdls.clear();
+    };
+
+  /* Synchronous loading: each load is a frame hitch */
+  DBL sync_max = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (INT i = 0; i < Count; i++)
+  {
+    auto t = std::chrono::steady_clock::now();
+    texs.push_back(TexCreate(tex_names[i]));
+    sync_max = std::max(sync_max, Ms(t));
+    t = std::chrono::steady_clock::now();
+    mdls.push_back(std::make_unique<model>());
+    mdls.back()->Load(mdl_names[i]);
+    sync_max = std::max(sync_max, Ms(t));
+  }
+  glFinish();
+  DBL sync_time = Ms(start);
+  FreeAll();
+
+  /* Asynchronous streaming while frames are rendered */
+  LoaderStats = {};
+  StreamStats = {};
+  INT frames = 0;
+  start = std::chrono::steady_clock::now();
+  for (INT i = 0; i < Count; i++)
+  {
+    texs.push_back(TexLoadAsync(tex_names[i]));
+    mdls.push_back(std::make_unique<model>());
+    mdls.back()->LoadAsync(mdl_names[i]);
+  }
+  DBL issue_time = Ms(start);
+  while (NumOfPendingLoads() > 0 || NumOfStreams() > 0)
+  {
+    render::FrameStart();
+    render::FrameEnd();
+    frames++;
+  }
+  glFinish();
+  DBL async_time = Ms(start);
+  LOADER_STATS st = LoaderStats;
+  STREAM_STATS ss = StreamStats;
+
+  /* Eviction under half budget and reload on use */
+  texture_manager::USAGE before = texture_manager::Usage();
+  texture_manager::Budget = std::max<SIZE_T>(before.Bytes / 2, 1);
+  for (INT i = 0; i < 3; i++)
+  {
+    render::FrameStart();
+    render::FrameEnd();
+  }
+  texture_manager::USAGE evicted = texture_manager::Usage();
+  texture_manager::Budget = 0;
+  start = std::chrono::steady_clock::now();
+  for (auto *tex : texs)
+    tex->Apply();
+  while (NumOfPendingLoads() > 0 || NumOfStreams() > 0)
+  {
+    render::FrameStart();
+    render::FrameEnd();
+  }
+  glFinish();
+  DBL reload_time = Ms(start);
+  texture_manager::USAGE reloaded = texture_manager::Usage();
+  std::string report = ResourcesReport();
+  FreeAll();
+
+  tse::logger::Info(std::format("LOAD bench: {} textures ({}x{}) + {} models ({} primitives, {}x{} texture), {:.1f} MB of files",
+    Count, tex_size, tex_size, Count, prims_per_model, mdl_tex_size, mdl_tex_size, file_bytes / 1048576.0));
+  tse::logger::Info(std::format("LOAD sync: {:.1f} ms, {:.1f} MB/s, worst single load (frame hitch) {:.2f} ms",
+    sync_time, file_bytes / 1048576.0 / (sync_time / 1000), sync_max));
+  tse::logger::Info(std::format("LOAD async: {:.1f} ms ({:.2f} ms to issue), {:.1f} MB/s ({:.1f} MB decoded), {} frames, "
+    "worst frame {:.2f} ms, worst frame upload {:.2f} ms (budget {:.1f} ms), {} failed",
+    async_time, issue_time, file_bytes / 1048576.0 / (async_time / 1000), st.BytesRead / 1048576.0, frames,
+    st.MaxStreamFrame, st.MaxFrameUpload, UploadBudget, st.Failed));
+  tse::logger::Info(std::format("LOAD texture streaming: {:.1f} MB in {} slices over {} frames, {:.1f} MB/s CPU staging rate, "
+    "max {:.2f} MB/frame (budget {:.2f} MB), worst frame {:.2f} ms, avg {:.2f} ms/frame, {} staging stalls",
+    ss.Bytes / 1048576.0, ss.Slices, ss.Frames, ss.Bytes / 1048576.0 / std::max(ss.Time / 1000, 1e-9),
+    ss.MaxFrameBytes / 1048576.0, StreamBudget / 1048576.0, ss.MaxFrameTime, ss.Time / std::max(ss.Frames, 1), ss.Stalls));
+  tse::logger::Info(std::format("LOAD eviction: {:.1f} MB resident, budget {:.1f} MB -> {:.1f} MB after {} evictions, "
+    "{} reloads in {:.1f} ms -> {:.1f} MB resident",
+    before.Bytes / 1048576.0, before.Bytes / 2 / 1048576.0, evicted.Bytes / 1048576.0, evicted.Evictions,
+    reloaded.Reloads, reload_time, reloaded.Bytes / 1048576.0));
+  tse::logger::Info("LOAD resources usage:\n" + report);
+
+  render::Close();
+  return 0;
+} /* End of 'tse::anim::RunLoadBench' function */
+
+/* Run scene warm-up (dependency graph parallel loading) benchmark function.
+ * ARGUMENTS:
+ *   - scene manifest file name (empty for synthetic scene):
+ *       const std::string &Manifest;
+ *   - number of synthetic scene textures and models:
+ *       INT Count;
+ * RETURNS:
+ *   (INT) error level (0 for success).
+ */
+INT tse::anim::RunWarmupBench( const std::string &Manifest, INT Count )
+{
+  if (!render::InitHeadless(640, 480))
+    return 1;
+  shader_manager::WaitAll();
+  Count = std::max(Count, 1);
+
+  /* Synthetic scene: models, materials sharing textures pairwise and fonts */
+  std::string manifest = Manifest;
+  if (manifest.empty())
+  {
+    BENCH_ASSETS assets;
+    if (!CreateBenchAssets(Count, assets))
+    {
+      render::Close();
+      return 1;
+    }
+    auto Rel = []( const std::string &FileName ){ return FileName.substr(Path().size()); };
+    manifest = "bin/loadbench/scene.manifest";
+    std::ofstream f(manifest);
+    f << "# Synthetic warm-up benchmark scene\n";
+    for (INT i = 0; i < Count; i++)
+      f << "model " << Rel(assets.Models[i]) << "\n";
+    for (INT i = 0; i < Count; i++)
+      f << std::format("material WarmupMtl{} texture {} texture {}\n",
+        i, Rel(assets.Textures[i]), Rel(assets.Textures[(i + 1) % Count]));
+    f << "font bin/fonts/Book.g3df\n" << "font bin/fonts/Consolas.g3df\n";
+  }
+
+  resource_graph graph(*this);
+  if (!graph.LoadManifest(manifest))
+  {
+    render::Close();
+    return 1;
+  }
+
+  /* First pass warms file system cache (and creates shared shaders) */
+  graph.Warmup(Jobs);
+  graph.Clear();
+  resource_graph::WARMUP_STATS serial = graph.Warmup(Jobs, FALSE);
+  graph.Clear();
+  resource_graph::WARMUP_STATS parallel = graph.Warmup(Jobs);
+  graph.Clear();
+
+  std::string path;
+  for (auto &name : parallel.Path)
+    path += (path.empty() ? "" : " -> ") + name;
+  tse::logger::Info(std::format("WARMUP scene {}: {} resources from {} references ({} deduplicated), "
+    "{} already loaded, {} failed",
+    manifest, parallel.Nodes, parallel.Refs, parallel.Refs - parallel.Nodes, parallel.Existing, parallel.Failed));
+  tse::logger::Info(std::format("WARMUP serial: {:.1f} ms (read {:.1f} ms + create {:.1f} ms)",
+    serial.WallTime, serial.ReadTime, serial.CreateTime));
+  tse::logger::Info(std::format("WARMUP parallel ({} workers): {:.1f} ms, {:.2f}x speedup; stages sum {:.1f} ms, "
+    "critical path {:.1f} ms, render thread creation {:.1f} ms (bound {:.2f}x), shaders wait {:.1f} ms",
+    Jobs.NumOfWorkers(), parallel.WallTime, serial.WallTime / std::max(parallel.WallTime, 1e-9),
+    parallel.SerialTime, parallel.CriticalPath, parallel.CreateTime,
+    parallel.SerialTime / std::max(std::max(parallel.CriticalPath, parallel.CreateTime), 1e-9), parallel.ShaderWait));
+  tse::logger::Info("WARMUP critical path: " + path);
+
+  render::Close();
+  return 0;
+} /* End of 'tse::anim::RunWarmupBench' function */
+
+/* Build assets pack and compare its reading with loose files function.
+ * ARGUMENTS:
+ *   - directory to pack:
+ *       const std::string &Dir;
+ *   - pack file name:
+ *       const std::string &PackFileName;
+ *   - entries compression flag:
+ *       BOOL IsCompress;
+ * RETURNS:
+ *   (INT) error level (0 for success).
+ */
+INT tse::anim::RunPackBuild( const std::string &Dir, const std::string &PackFileName, BOOL IsCompress )
+{
+  /* Pack being rebuilt may be mounted at startup */
+  vfs::Unmount();
+  vfs::BUILD_STATS stats;
+  if (!vfs::Build(Dir, PackFileName, IsCompress, stats) || !vfs::Mount(PackFileName))
+  {
+    tse::logger::Err("PACK can't build " + PackFileName);
+    return 1;
+  }
+  tse::logger::Info(std::format("PACK {} from {}: {} files ({} compressed), {:.2f} MB -> {:.2f} MB stored ({:.1f}%), "
+    "pack {:.2f} MB, {:.1f} ms",
+    PackFileName, Dir, stats.Files, stats.Compressed, stats.Bytes / 1048576.0, stats.StoredBytes / 1048576.0,
+    stats.StoredBytes * 100.0 / std::max<UINT64>(stats.Bytes, 1), stats.PackSize / 1048576.0, stats.Time));
+
+  /* Read every file loose, then from pack (mapping included), data should match */
+  std::vector<std::string> names = vfs::List();
+  vfs::Unmount();
+  std::vector<std::vector<BYTE>> loose(names.size()), packed(names.size());
+  auto ReadAll = [&names]( std::vector<std::vector<BYTE>> &Data )
+    {
+      for (SIZE_T i = 0; i < names.size(); i++)
+        vfs::Read(names[i], Data[i]);
+    };
+
+  auto start = std::chrono::steady_clock::now();
+  ReadAll(loose);
+  DBL loose_time = std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - start).count();
+  start = std::chrono::steady_clock::now();
+  vfs::Mount(PackFileName);
+  ReadAll(packed);
+  DBL pack_time = std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - start).count();
+  vfs::Unmount();
+
+  INT mismatches = 0;
+  for (SIZE_T i = 0; i < names.size(); i++)
+    mismatches += loose[i] != packed[i];
+  tse::logger::Info(std::format("PACK read all: loose {:.1f} ms ({} opens), packed {:.1f} ms (1 mapping), "
+    "{} mismatches", loose_time, names.size(), pack_time, mismatches));
+  return mismatches != 0;
+} /* End of 'tse::anim::RunPackBuild' function */
+
+/* Run scene graph transforms update benchmark function.
+ * ARGUMENTS:
+ *   - number of nodes:
+ *       INT Count;
+ *   - number of frames:
+ *       INT Frames;
+ * RETURNS:
+ *   (INT) error level (0 for success).
+ */
+INT tse::anim::RunSceneBench( INT Count, INT Frames )
+{
+  auto Ms = []( auto Start )
+    {
+      return std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - Start).count();
+    };
+  Count = std::max(Count, 24);
+  Frames = std::max(Frames, 1);
+
+  /* Ships: root, hull, 4 engines, 6 turrets with 2 barrels each */
+  scene_graph scene;
+  std::vector<scene_graph::node> nodes;
+  std::vector<INT> parent;
+  std::vector<matr> local;
+  std::vector<vec3> origin;
+  std::mt19937 rng(30);
+  std::uniform_real_distribution<FLT> pos(-1000, 1000);
+  auto AddNode = [&]( INT Parent, const matr &Local )
+    {
+      nodes.push_back(scene.Add(Parent == -1 ? scene_graph::None : nodes[Parent], Local, vec3(-1), vec3(1)));
+      parent.push_back(Parent);
+      local.push_back(Local);
+      origin.push_back(vec3(Local.M[3][0], Local.M[3][1], Local.M[3][2]));
+      return (INT)nodes.size() - 1;
+    };
+  while ((INT)nodes.size() + 24 <= Count)
+  {
+    INT ship = AddNode(-1, matr::Translate(pos(rng), pos(rng), pos(rng)));
+    AddNode(ship, matr::Scale(4, 1, 8));
+    for (INT i = 0; i < 4; i++)
+      AddNode(ship, matr::Translate(i * 2 - 3, 0, 8));
+    for (INT i = 0; i < 6; i++)
+    {
+      INT turret = AddNode(ship, matr::Translate(i % 2 * 4 - 2, 1, i / 2 * 4 - 4));
+      AddNode(turret, matr::Translate(-0.3, 0, -1));
+      AddNode(turret, matr::Translate(0.3, 0, -1));
+    }
+  }
+  Count = (INT)nodes.size();
+
+  /* 1% of nodes change per frame, same changes sequence for all methods */
+  INT num_of_changes = std::max(Count / 100, 1);
+  INT64 recomputed = 0;
+  auto Run = [&]( auto Set, auto Update )
+    {
+      std::mt19937 frame_rng(47);
+      auto start = std::chrono::steady_clock::now();
+      for (INT f = 0; f < Frames; f++)
+      {
+        for (INT k = 0; k < num_of_changes; k++)
+        {
+          INT i = (INT)(frame_rng() % Count);
+          Set(i, matr::RotateY(f + k) * matr::Translate(origin[i]));
+        }
+        Update();
+      }
+      return Ms(start);
+    };
+  scene.UpdateAll();
+
+  /* Dirty flags: changed subtrees only */
+  DBL dirty_ms = Run([&]( INT I, const matr &M ){ scene.SetLocal(nodes[I], M); },
+    [&]( VOID ){ scene.Update(); recomputed += scene.Stats().Recomputed; });
+
+  /* All nodes each frame (SSE) */
+  DBL all_ms = Run([&]( INT I, const matr &M ){ scene.SetLocal(nodes[I], M); },
+    [&]( VOID ){ scene.UpdateAll(); });
+
+  /* All nodes each frame through 'matr' products (as units do) */
+  std::vector<matr> world(Count);
+  DBL matr_ms = Run([&]( INT I, const matr &M ){ local[I] = M; },
+    [&]( VOID )
+    {
+      for (INT i = 0; i < Count; i++)
+        world[i] = parent[i] == -1 ? local[i] : local[i] * world[parent[i]];
+    });
+
+  /* Results should match */
+  DBL max_diff = 0;
+  for (INT i = 0; i < Count; i++)
+  {
+    matr m = scene.GetWorld(nodes[i]);
+    for (INT k = 0; k < 16; k++)
+      max_diff = std::max(max_diff, (DBL)fabs(m.M[k / 4][k % 4] - world[i].M[k / 4][k % 4]));
+  }
+
+  tse::logger::Info(std::format("SCENE bench: {} nodes, {} frames, {} changes per frame", Count, Frames, num_of_changes));
+  tse::logger::Info(std::format("SCENE dirty flags: {:.3f} ms/frame, {:.0f} nodes recomputed per frame ({:.1f}%)",
+    dirty_ms / Frames, (DBL)recomputed / Frames, recomputed * 100.0 / Frames / Count));
+  tse::logger::Info(std::format("SCENE all nodes SSE: {:.3f} ms/frame, 'matr' products: {:.3f} ms/frame, "
+    "dirty flags speedup {:.1f}x, max difference {:g}",
+    all_ms / Frames, matr_ms / Frames, matr_ms / std::max(dirty_ms, 1e-9), max_diff));
+  return max_diff > 1e-2;
+} /* End of 'tse::anim::RunSceneBench' function */
+
+/* Run bounding volume hierarchy benchmark function.
+ * ARGUMENTS:
+ *   - number of objects (0 for 10K, 100K and 1M):
+ *       INT Count;
+ * RETURNS:
+ *   (INT) error level (0 for success).
+ */
+INT tse::anim::RunBVHBench( INT Count )
+{
+  auto Ms = []( auto Start )
+    {
+      return std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - Start).count();
+    };
+  INT errors = 0;
+  std::vector<INT> counts {10000, 100000, 1000000};
+  if (Count > 0)
+    counts = {Count};
+
+  for (INT n : counts)
+  {
+    /* Random boxes with the same density for all sizes */
+    std::mt19937 rng(30);
+    FLT side = 20 * std::cbrt((FLT)n);
+    std::uniform_real_distribution<FLT> pos(-side / 2, side / 2), size(0.5, 2);
+    std::vector<vec3> mn(n), mx(n);
+    for (INT i = 0; i < n; i++)
+    {
+      mn[i] = vec3(pos(rng), pos(rng), pos(rng));
+      mx[i] = mn[i] + vec3(size(rng), size(rng), size(rng));
+    }
+
+    /* Incremental insertion and full rebuild */
+    bvh tree;
+    std::vector<bvh::proxy> proxies(n);
+    auto start = std::chrono::steady_clock::now();
+    for (INT i = 0; i < n; i++)
+      proxies[i] = tree.Insert(mn[i], mx[i], i);
+    DBL insert_ms = Ms(start);
+    DBL insert_cost = tree.Stats().Cost;
+    start = std::chrono::steady_clock::now();
+    tree.Build();
+    DBL build_ms = Ms(start);
+    bvh::STATS built = tree.Stats();
+
+    /* 10% of objects move, refit keeps topology */
+    INT num_of_moves = n / 10;
+    for (INT k = 0; k < num_of_moves; k++)
+    {
+      INT i = (INT)(rng() % n);
+      vec3 d(pos(rng) / 20, pos(rng) / 20, pos(rng) / 20);
+      mn[i] += d;
+      mx[i] += d;
+      tree.Move(proxies[i], mn[i], mx[i]);
+    }
+    start = std::chrono::steady_clock::now();
+    tree.Refit();
+    DBL refit_ms = Ms(start);
+    DBL refit_cost = tree.Stats().Cost;
+
+    /* 1% of objects removed and inserted again */
+    INT num_of_reinserts = std::max(n / 100, 1);
+    start = std::chrono::steady_clock::now();
+    for (INT k = 0; k < num_of_reinserts; k++)
+    {
+      INT i = (INT)(rng() % n);
+      tree.Remove(proxies[i]);
+      proxies[i] = tree.Insert(mn[i], mx[i], i);
+    }
+    DBL reinsert_ms = Ms(start);
+
+    /* Frustum culling of camera flying around, compared with brute force */
+    const INT NumOfFrames = 100;
+    camera cam;
+    cam.Resize(1920, 1080);
+    std::vector<INT> visible;
+    INT64 num_visible = 0, num_visited = 0;
+    DBL cull_ms = 0, brute_cull_ms = 0;
+    for (INT f = 0; f < NumOfFrames; f++)
+    {
+      FLT a = f * 2 * PI / NumOfFrames;
+      cam.SetLocAtUp(vec3(std::cos(a), 0.3, std::sin(a)) * side * 0.3, vec3(0));
+      visible.clear();
+      start = std::chrono::steady_clock::now();
+      num_visited += tree.Cull(cam.VP, visible);
+      cull_ms += Ms(start);
+      num_visible += visible.size();
+
+      start = std::chrono::steady_clock::now();
+      bvh::FRUSTUM fr(cam.VP);
+      INT brute = 0;
+      for (INT i = 0; i < n; i++)
+        brute += !fr.IsOutside(mn[i], mx[i]);
+      brute_cull_ms += Ms(start);
+      if (brute != (INT)visible.size())
+        errors++;
+    }
+
+    /* Picking through random screen points, checked by brute force on part of rays */
+    const INT NumOfRays = 10000, NumOfChecks = 100;
+    std::uniform_real_distribution<FLT> xs(0, 1920), ys(0, 1080);
+    INT num_of_hits = 0;
+    DBL pick_ms = 0, brute_pick_ms = 0;
+    for (INT r = 0; r < NumOfRays; r++)
+    {
+      ray R = cam.FrameRay(xs(rng), ys(rng));
+      FLT t = 0;
+      start = std::chrono::steady_clock::now();
+      INT hit = tree.Pick(R, t);
+      pick_ms += Ms(start);
+      num_of_hits += hit != -1;
+      if (r >= NumOfChecks)
+        continue;
+
+      start = std::chrono::steady_clock::now();
+      vec3 inv(1 / R.Dir.X, 1 / R.Dir.Y, 1 / R.Dir.Z);
+      FLT best = std::numeric_limits<FLT>::max(), bt;
+      INT brute = -1;
+      for (INT i = 0; i < n; i++)
+        if (bvh::Intersect(R, inv, mn[i], mx[i], bt) && bt < best)
+          best = bt, brute = i;
+      brute_pick_ms += Ms(start);
+      /* Equally near boxes may differ, distance may not */
+      if ((hit == -1) != (brute == -1) || (hit != -1 && fabs(t - best) > 1e-3 * (1 + best)))
+        errors++;
+    }
+
+    tse::logger::Info(std::format("BVH bench: {} objects, {} nodes, depth {}", n, built.Nodes, built.Depth));
+    tse::logger::Info(std::format("BVH build: {:.1f} ms (cost {:.1f}), incremental insert: {:.1f} ms (cost {:.1f})",
+      build_ms, built.Cost, insert_ms, insert_cost));
+    tse::logger::Info(std::format("BVH refit of {} moved: {:.2f} ms (cost {:.1f}, {:+.1f}% to build), "
+      "{} remove/insert: {:.2f} ms",
+      num_of_moves, refit_ms, refit_cost, (refit_cost / built.Cost - 1) * 100, num_of_reinserts, reinsert_ms));
+    tse::logger::Info(std::format("BVH cull: {:.3f} ms/frame ({} visible, {} nodes visited), brute force: {:.3f} ms/frame",
+      cull_ms / NumOfFrames, num_visible / NumOfFrames, num_visited / NumOfFrames, brute_cull_ms / NumOfFrames));
+    tse::logger::Info(std::format("BVH pick: {:.2f} us/ray ({:.0f}% hit), brute force: {:.2f} us/ray",
+      pick_ms * 1000 / NumOfRays, num_of_hits * 100.0 / NumOfRays, brute_pick_ms * 1000 / NumOfChecks));
+  }
+  if (errors != 0)
+    tse::logger::Err(std::format("BVH queries differ from brute force {} times", errors));
+  return errors != 0;
+} /* End of 'tse::anim::RunBVHBench' function */
+
 /* WM_CREATE window message handle function.
  * ARGUMENTS:
  *   - structure with creation data:
@@ -116,7 +1234,6 @@ VOID tse::anim::Run( VOID )
 BOOL tse::anim::OnCreate( CREATESTRUCT *CS )
 {
   render::Init();
-  SetTimer(hWnd, 47, 2, nullptr);
   return TRUE;
 } /* End of 'tse::anim::OnCreate' function */
 
@@ -131,6 +1248,9 @@ BOOL tse::anim::OnCreate( CREATESTRUCT *CS )
 VOID tse::anim::OnSize( UINT State, INT W, INT H )
 {
   render::Resize(W, H);
+  /* Message loop is blocked by system modal sizing loop: keep picture alive */
+  if (IsSizeMove)
+    Render();
 } /* End of 'tse::anim::OnSize' function */
 
 /* WM_DESTROY window message handle function.
@@ -141,21 +1261,9 @@ VOID tse::anim::OnDestroy( VOID )
 {
   tse::logger::Aim("Finishing up...");
   render::Close();
-  KillTimer(hWnd, 47);
   PostQuitMessage(30);
 } /* End of 'tse::anim::OnDestroy' function */
 
-/* WM_TIMER window message handle function.
- * ARGUMENTS:
- *   - specified the timer identifier.
- *       INT Id;
- * RETURNS: None.
- */
-VOID tse::anim::OnTimer( INT Id )
-{
-  Render();
-} /* End of 'tse::anim::OnTimer' function */
-
 /* WM_ERASEBKGND window message handle function.
  * ARGUMENTS:
  *   - device context of client area:
@@ -227,6 +1335,7 @@ VOID tse::anim::OnMouseWheel( INT X, INT Y, INT Z, UINT Keys )
  */
 VOID tse::anim::OnExitSizeMove( VOID )
 {
+  IsSizeMove = FALSE;
 } /* End of 'tse::anim::OnExitSizeMove' function */
 
 /* WM_ENTERSIZEMOVE window message handle function.
@@ -235,6 +1344,7 @@ VOID tse::anim::OnExitSizeMove( VOID )
  */
 VOID tse::anim::OnEnterSizeMove( VOID )
 {
+  IsSizeMove = TRUE;
 } /* End of 'tse::anim::OnEnterSizeMove' function */
 
 /* WM_ACTIVATE window message handle function.
@@ -9,7 +9,7 @@
  *               Common definitions module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 01.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -22,6 +22,8 @@
 #include "input/input.h"
 #include "input/timer.h"
 #include "rnd/render.h"
+#include "scene/scene.h"
+#include "scene/bvh.h"
 
 /* Main program namespace */
 namespace tse
@@ -30,11 +32,24 @@ namespace tse
   class unit
   {
   public:
+    std::string Name;          // Unit name (set on registration)
+    BOOL IsConcurrent = FALSE; // 'Simulate' and 'Response' are thread safe and may run on job system workers
+
     /* Class destructor function */
     virtual ~unit( VOID )
     {
     } /* End of '~unit' function */
 
+    /* Fixed step unit simulation function.
+     * ARGUMENTS:
+     *   - simulation step in seconds (constant):
+     *       DBL Step;
+     * RETURNS: None.
+     */
+    virtual VOID Simulate( DBL Step )
+    {
+    } /* End of 'Simulate' function */
+
     /* Response unit function
      * ARGUMENTS: None.
      * RETURNS: None.
@@ -56,7 +71,13 @@ namespace tse
   /* Animation representation class */
   class anim : public win, public input, public timer, public render
   {
-    stock<unit *> Units; // Unit stock
+    stock<unit *> Units;      // Unit stock
+    BOOL IsRedraw = TRUE;     // Redraw request flag (on demand frame mode)
+    BOOL IsSizeMove = FALSE;  // Window modal sizing/moving loop flag
+    std::vector<INT>
+      VisibleNodes;           // Tracked scene graph nodes visible by camera (culled after scene update)
+    std::vector<BYTE>
+      NodeVisible;            // Tracked scene graph nodes visibility flags (by node handle)
 
     /* Type constructor function.
      * ARGUMENTS:
@@ -65,7 +86,35 @@ namespace tse
      */
     anim( HINSTANCE hInst = GetModuleHandle(nullptr) );
 
+    /* Synthetic loading benchmark assets structure */
+    struct BENCH_ASSETS
+    {
+      INT TexSize = 512;                // Textures size
+      INT MdlTexSize = 256;             // Models embedded texture size
+      INT PrimsPerModel = 4, Grid = 64; // Models primitives and their grid size
+      std::vector<std::string>
+        Textures,                       // Texture files (*.PNG)
+        Models;                         // Model files (*.G3DM)
+      UINT64 Bytes = 0;                 // Total files size
+    }; /* End of 'BENCH_ASSETS' structure */
+
+    /* Create synthetic loading benchmark assets function.
+     * Files are created in 'bin/loadbench/' once and reused by next runs.
+     * ARGUMENTS:
+     *   - number of textures and models:
+     *       INT Count;
+     *   - assets parameters and result files:
+     *       BENCH_ASSETS &Assets;
+     * RETURNS:
+     *   (BOOL) TRUE if success.
+     */
+    BOOL CreateBenchAssets( INT Count, BENCH_ASSETS &Assets );
+
   public:
+    job_system Jobs;   // Frame jobs worker pool (see 'unit::IsConcurrent')
+    scene_graph Scene; // Scene graph (updated after units response)
+    bvh SceneBVH;      // Tracked scene graph nodes hierarchy (synchronized after scene update)
+
     /* Get animation path function */
     static std::string & Path( VOID );
 
@@ -109,7 +158,12 @@ namespace tse
     anim & operator<<( const std::string &UnitName )
     {
       if (UnitNames.find(UnitName) != UnitNames.end())
-        *this << UnitNames[UnitName](), tse::logger::Info("UNIT added: " + UnitName);;
+      {
+        unit *uni = UnitNames[UnitName]();
+        uni->Name = UnitName;
+        *this << uni;
+        tse::logger::Info("UNIT added: " + UnitName);
+      }
       return *this;
     } /* End of 'operator<<' function */
 
@@ -122,8 +176,12 @@ namespace tse
      */
     anim & operator<<( unit *Uni )
     {
-      if (Uni != nullptr)
-        Units << Uni;
+      if (Uni == nullptr)
+        return *this;
+      /* Unnamed units get type and address label (keeps profiler zones apart) */
+      if (Uni->Name == "")
+        Uni->Name = std::format("{}@{}", typeid(*Uni).name(), (VOID *)Uni);
+      Units << Uni;
       return *this;
     } /* End of 'operator<<' function */
 
@@ -157,12 +215,151 @@ namespace tse
      */
     VOID Render( VOID );
 
+    /* Request frame redraw (on demand frame mode) function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Redraw( VOID )
+    {
+      IsRedraw = TRUE;
+    } /* End of 'Redraw' function */
+
+    /* Check scene graph node visibility by last frame culling function.
+     * ARGUMENTS:
+     *   - node:
+     *       scene_graph::node Node;
+     * RETURNS:
+     *   (BOOL) TRUE if node bound box is in camera frustum or node is not tracked by 'SceneBVH'.
+     */
+    BOOL IsVisible( scene_graph::node Node ) const
+    {
+      return
+        SceneBVH.Tracked(Node) == bvh::None ||
+        (Node < (INT)NodeVisible.size() && NodeVisible[Node]);
+    } /* End of 'IsVisible' function */
+
     /* Start window message loop function.
      * ARGUMENTS: None.
      * RETURNS: None.
      */
     virtual VOID Run( VOID ) override;
 
+    /* Headless benchmark run parameters structure */
+    struct HEADLESS_PARAMS
+    {
+      INT W = 1280, H = 720;                  // Frame buffer size
+      INT Frames = 300;                       // Number of frames to render
+      std::vector<std::string> Units;         // Units to add
+      std::string OutPrefix = "bin/headless"; // Output files prefix ('.csv' and '.png' added)
+      BOOL IsVariants = TRUE;                 // Texture slots shader variants enable flag
+      BOOL IsProfile = FALSE;                 // CPU profiler capture flag ('_trace.json' added)
+    }; /* End of 'HEADLESS_PARAMS' structure */
+
+    /* Run headless (offscreen) benchmark function.
+     * ARGUMENTS:
+     *   - run parameters:
+     *       const HEADLESS_PARAMS &Params;
+     * RETURNS:
+     *   (INT) error level (0 for success).
+     */
+    INT RunHeadless( const HEADLESS_PARAMS &Params );
+
+    /* Run draw submission CPU cost benchmark function.
+     * ARGUMENTS:
+     *   - number of measured draws:
+     *       INT Count;
+     *   - output files prefix (command trace):
+     *       const std::string &OutPrefix;
+     * RETURNS:
+     *   (INT) error level (0 for success).
+     */
+    INT RunSubmitBench( INT Count, const std::string &OutPrefix );
+
+    /* Run shader programs cold/warm (binary cache) load benchmark function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) error level (0 for success).
+     */
+    INT RunShaderBench( VOID );
+
+    /* Run shared vertex arrays setup benchmark function.
+     * ARGUMENTS:
+     *   - number of primitives:
+     *       INT Count;
+     * RETURNS:
+     *   (INT) error level (0 for success).
+     */
+    INT RunVAOBench( INT Count );
+
+    /* Run job system scheduler micro benchmark function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) error level (0 for success).
+     */
+    INT RunJobBench( VOID );
+
+    /* Run synchronous vs asynchronous logging benchmark function.
+     * ARGUMENTS:
+     *   - number of messages:
+     *       INT Count;
+     * RETURNS:
+     *   (INT) error level (0 for success).
+     */
+    INT RunLogBench( INT Count );
+
+    /* Run synchronous vs asynchronous resources loading benchmark function.
+     * ARGUMENTS:
+     *   - number of textures and models:
+     *       INT Count;
+     * RETURNS:
+     *   (INT) error level (0 for success).
+     */
+    INT RunLoadBench( INT Count );
+
+    /* Run scene warm-up (dependency graph parallel loading) benchmark function.
+     * ARGUMENTS:
+     *   - scene manifest file name (empty for synthetic scene):
+     *       const std::string &Manifest;
+     *   - number of synthetic scene textures and models:
+     *       INT Count;
+     * RETURNS:
+     *   (INT) error level (0 for success).
+     */
+    INT RunWarmupBench( const std::string &Manifest, INT Count );
+
+    /* Build assets pack and compare its reading with loose files function.
+     * ARGUMENTS:
+     *   - directory to pack:
+     *       const std::string &Dir;
+     *   - pack file name:
+     *       const std::string &PackFileName;
+     *   - entries compression flag:
+     *       BOOL IsCompress;
+     * RETURNS:
+     *   (INT) error level (0 for success).
+     */
+    INT RunPackBuild( const std::string &Dir, const std::string &PackFileName, BOOL IsCompress );
+
+    /* Run scene graph transforms update benchmark function.
+     * ARGUMENTS:
+     *   - number of nodes:
+     *       INT Count;
+     *   - number of frames:
+     *       INT Frames;
+     * RETURNS:
+     *   (INT) error level (0 for success).
+     */
+    INT RunSceneBench( INT Count, INT Frames );
+
+    /* Run bounding volume hierarchy benchmark function.
+     * ARGUMENTS:
+     *   - number of objects (0 for 10K, 100K and 1M):
+     *       INT Count;
+     * RETURNS:
+     *   (INT) error level (0 for success).
+     */
+    INT RunBVHBench( INT Count );
+
     /* WM_CREATE window message handle function.
      * ARGUMENTS:
      *   - structure with creation data:
@@ -188,14 +385,6 @@ namespace tse
      */
     virtual VOID OnDestroy( VOID ) override;
 
-    /* WM_TIMER window message handle function.
-     * ARGUMENTS:
-     *   - specified the timer identifier.
-     *       INT Id;
-     * RETURNS: None.
-     */
-    virtual VOID OnTimer( INT Id ) override;
-
     /* WM_ERASEBKGND window message handle function.
      * ARGUMENTS:
      *   - device context of client area:
@@ -9,7 +9,7 @@
  *               Timer handle.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 31.07.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -32,7 +32,40 @@ namespace tse
       OldTimeFPS,   // Old time FPS measurement
       PauseTime,    // Time during pause period
       TimePerSec,   // Timer resolution
-      FrameCounter; // Frames counted from last measure
+      FrameCounter, // Frames counted from last measure
+      OldCPUTime;   // Process CPU time at last FPS measure (100 ns units)
+
+    /* Obtain process CPU time function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) user and kernel time of all process threads (100 ns units).
+     */
+    static UINT64 ProcessCPUTime( VOID )
+    {
+#ifdef _WIN32
+      FILETIME creation, exit, kernel, user;
+      if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        return 0;
+      return ((UINT64)kernel.dwHighDateTime << 32 | kernel.dwLowDateTime) +
+             ((UINT64)user.dwHighDateTime << 32 | user.dwLowDateTime);
+#else
+      return (UINT64)std::clock() * 10000000 / CLOCKS_PER_SEC;
+#endif /* _WIN32 */
+    } /* End of 'ProcessCPUTime' function */
+
+    /* Obtain current time function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) monotonic clock ticks ('TimePerSec' per second).
+     */
+    static UINT64 Now( VOID )
+    {
+      return std::chrono::steady_clock::now().time_since_epoch().count();
+    } /* End of 'Now' function */
+
+    std::vector<DBL> FrameTimes; // Last frame times ring buffer (milliseconds)
+    INT FrameTimesPos = 0;       // Frame times ring write position
+    UINT64 NumOfFrameTimes = 0;  // Total recorded frame times
 
   public:
     BOOL IsPause;      // Pause flag
@@ -41,21 +74,52 @@ namespace tse
       GlobalDeltaTime, // Global time difference
       Time,            // Unpaused time
       DeltaTime,       // Unpaused time difference
-      FPS;             // Frames per second
+      FPS,             // Frames per second
+      CPUUsage;        // Process CPU usage over last FPS measure (percent of one core)
+
+    /* Fixed step simulation (decoupled from frame rate) */
+    DBL
+      SimStep,         // Simulation step duration (1 / ticks per second)
+      SimTime,         // Simulated time (advanced by whole steps)
+      SimAccum,        // Not yet simulated unpaused time
+      SimAlpha;        // Render interpolation factor between two last simulation states [0, 1)
+    INT
+      SimSteps,        // Simulation steps to perform this frame
+      MaxSimSteps;     // Steps per frame limit (slow frames drop time instead of spiraling)
+    UINT64
+      SimTick;         // Simulation steps performed
+
+    /* Frame times history */
+    static const INT FrameTimesSize = 512; // Number of frame times kept
+    BOOL IsFrameTimesRecord = TRUE;        // Frame times recording flag
+    DBL
+      FrameTimeAvg = 0,                    // Frame time moving average (milliseconds)
+      HitchFactor = 2;                     // Hitch threshold (times moving average)
+    BOOL IsHitch = FALSE;                  // Last frame was a hitch flag
+    UINT64 NumOfHitches = 0;               // Detected hitches counter
+
+    /* Frame times statistics structure (all times in milliseconds) */
+    struct FRAME_TIME_STATS
+    {
+      DBL Avg, Max;      // Average and maximum time
+      DBL P50, P95, P99; // Percentiles
+      INT Count;         // Number of samples
+      UINT64 Hitches;    // Hitches detected since start
+    }; /* End of 'FRAME_TIME_STATS' structure */
 
     /* Default type constructor.
      * ARGUMENTS: None.
      */
     timer( VOID ) : StartTime(0), OldTime(0), OldTimeFPS(0),
-      PauseTime(0), TimePerSec(0), FrameCounter(0),
+      PauseTime(0), TimePerSec(0), FrameCounter(0), OldCPUTime(ProcessCPUTime()),
       IsPause(FALSE), GlobalTime(0), GlobalDeltaTime(30),
-      Time(0), DeltaTime(30), FPS(102.30)
+      Time(0), DeltaTime(30), FPS(102.30), CPUUsage(0),
+      SimStep(1.0 / 60), SimTime(0), SimAccum(0), SimAlpha(0),
+      SimSteps(0), MaxSimSteps(8), SimTick(0)
     {
-      LARGE_INTEGER t {};
-      QueryPerformanceFrequency(&t);
-      TimePerSec = t.QuadPart;
-      QueryPerformanceCounter(&t);
-      StartTime = OldTime = OldTimeFPS = t.QuadPart;
+      TimePerSec = std::chrono::steady_clock::period::den / std::chrono::steady_clock::period::num;
+      StartTime = OldTime = OldTimeFPS = Now();
+      FrameTimes.resize(FrameTimesSize);
     } /* End of 'timer' function */
 
     /* Perform response function.
@@ -64,31 +128,130 @@ namespace tse
      */
     VOID Response( VOID )
     {
-      LARGE_INTEGER t {};
-      QueryPerformanceCounter(&t);
+      UINT64 t = Now();
 
       /* Global time */
-      GlobalTime = (DBL)(t.QuadPart - StartTime) / TimePerSec;
-      GlobalDeltaTime = (DBL)(t.QuadPart - OldTime) / TimePerSec;
+      GlobalTime = (DBL)(t - StartTime) / TimePerSec;
+      GlobalDeltaTime = (DBL)(t - OldTime) / TimePerSec;
       /* Unpaused time */
       if (IsPause)
-        DeltaTime = 0, PauseTime += t.QuadPart - OldTime;
+        DeltaTime = 0, PauseTime += t - OldTime;
       else
       {
         DeltaTime = GlobalDeltaTime;
-        Time = (DBL)(t.QuadPart - PauseTime - StartTime) / TimePerSec;
+        Time = (DBL)(t - PauseTime - StartTime) / TimePerSec;
       }
       /* Frames per second */
       FrameCounter++;
-      if (t.QuadPart - OldTimeFPS > TimePerSec)
+      if (t - OldTimeFPS > TimePerSec)
       {
-        FPS = FrameCounter * TimePerSec / (DBL)(t.QuadPart - OldTimeFPS);
-        OldTimeFPS = t.QuadPart;
+        FPS = FrameCounter * TimePerSec / (DBL)(t - OldTimeFPS);
+        UINT64 cpu = ProcessCPUTime();
+        CPUUsage = 100.0 * (cpu - OldCPUTime) / 1e7 * TimePerSec / (DBL)(t - OldTimeFPS);
+        OldCPUTime = cpu;
+        OldTimeFPS = t;
         FrameCounter = 0;
       }
-      OldTime = t.QuadPart;
+      OldTime = t;
+
+      /* Frame times history and hitches (frame much longer than recent average) */
+      if (IsFrameTimesRecord)
+      {
+        DBL ms = GlobalDeltaTime * 1000;
+        IsHitch = NumOfFrameTimes > 8 && ms > FrameTimeAvg * HitchFactor;
+        NumOfHitches += IsHitch;
+        FrameTimeAvg = NumOfFrameTimes == 0 ? ms : FrameTimeAvg * 0.95 + ms * 0.05;
+        FrameTimes[FrameTimesPos] = ms;
+        FrameTimesPos = (FrameTimesPos + 1) % FrameTimesSize;
+        NumOfFrameTimes++;
+      }
+
+      /* Fixed simulation steps for this frame */
+      SimAccum = std::min(SimAccum + DeltaTime, SimStep * MaxSimSteps);
+      SimSteps = (INT)(SimAccum / SimStep);
+      SimAccum -= SimSteps * SimStep;
+      SimAlpha = SimAccum / SimStep;
     } /* End of 'Response' function */
 
+    /* Set simulation rate function.
+     * ARGUMENTS:
+     *   - simulation ticks per second:
+     *       DBL Rate;
+     * RETURNS: None.
+     */
+    VOID SetSimRate( DBL Rate )
+    {
+      if (Rate > 0)
+        SimStep = 1 / Rate;
+    } /* End of 'SetSimRate' function */
+
+    /* Obtain recent frame time function.
+     * ARGUMENTS:
+     *   - number of frames back (0 for last frame):
+     *       INT Back;
+     * RETURNS:
+     *   (DBL) frame time in milliseconds (0 if not recorded).
+     */
+    DBL FrameTime( INT Back = 0 ) const
+    {
+      if (Back < 0 || Back >= FrameTimesSize || (UINT64)Back >= NumOfFrameTimes)
+        return 0;
+      return FrameTimes[(FrameTimesPos - 1 - Back + FrameTimesSize) % FrameTimesSize];
+    } /* End of 'FrameTime' function */
+
+    /* Obtain frame times statistics function.
+     * ARGUMENTS:
+     *   - number of last frames to use (0 for whole history):
+     *       INT Count;
+     * RETURNS:
+     *   (FRAME_TIME_STATS) statistics.
+     */
+    FRAME_TIME_STATS FrameTimeStats( INT Count = 0 ) const
+    {
+      FRAME_TIME_STATS st {};
+      INT n = (INT)std::min<UINT64>(NumOfFrameTimes, FrameTimesSize);
+      if (Count > 0 && Count < n)
+        n = Count;
+      st.Hitches = NumOfHitches;
+      if ((st.Count = n) == 0)
+        return st;
+
+      std::vector<DBL> s(n);
+      for (INT i = 0; i < n; i++)
+        s[i] = FrameTime(i);
+      std::sort(s.begin(), s.end());
+      for (auto t : s)
+        st.Avg += t;
+      st.Avg /= n;
+      st.Max = s.back();
+      st.P50 = s[(n - 1) * 50 / 100];
+      st.P95 = s[(n - 1) * 95 / 100];
+      st.P99 = s[(n - 1) * 99 / 100];
+      return st;
+    } /* End of 'FrameTimeStats' function */
+
+    /* Dump frame times history to file function.
+     * ARGUMENTS:
+     *   - file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if success, FALSE otherwise.
+     */
+    BOOL FrameTimesDump( const std::string &FileName ) const
+    {
+      std::ofstream f(FileName);
+      if (!f.is_open())
+        return FALSE;
+      INT n = (INT)std::min<UINT64>(NumOfFrameTimes, FrameTimesSize);
+      f << "frame;frame_ms\n";
+      for (INT i = n - 1; i >= 0; i--)
+        f << std::format("{};{:.4f}\n", NumOfFrameTimes - 1 - i, FrameTime(i));
+      FRAME_TIME_STATS st = FrameTimeStats();
+      f << std::format("# avg {:.4f} p50 {:.4f} p95 {:.4f} p99 {:.4f} max {:.4f} hitches {}\n",
+        st.Avg, st.P50, st.P95, st.P99, st.Max, st.Hitches);
+      return TRUE;
+    } /* End of 'FrameTimesDump' function */
+
   }; /* End of 'timer' class */
 
 } /* end of 'tse' namespace */
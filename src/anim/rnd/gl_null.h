@@ -0,0 +1,649 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : gl_null.h
+ * PURPOSE     : Tough Space Exploration project.
+ *               Render system module.
+ *               Null (counting/recording) OpenGL backend module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Enabled by 'TSE_NULL_RENDER' compile definition
+ *               ('NullRenderDebug'/'NullRenderRelease' configurations):
+ *               every OpenGL call of render system is replaced by no-op
+ *               stub which only counts and (optionally) records the
+ *               command. New OpenGL calls should be added to the list.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __gl_null_h_
+#define __gl_null_h_
+
+#include <array>
+#include <type_traits>
+
+/* List of OpenGL commands used by render system (name without 'gl' prefix) */
+#define TSE_GL_NULL_COMMANDS(CMD) \
+  CMD(ActiveTexture) CMD(AttachShader) CMD(BindBuffer) CMD(BindBufferBase)             \
+  CMD(BindFramebuffer) CMD(BindTexture) CMD(BindVertexArray) CMD(BindVertexBuffer)     \
+  CMD(BlendFunc) CMD(BufferData) CMD(BufferStorage) CMD(BufferSubData)                 \
+  CMD(CheckNamedFramebufferStatus)                                                     \
+  CMD(ClearBufferfv) CMD(ClientWaitSync) CMD(CompileShader) CMD(CreateFramebuffers)    \
+  CMD(CreateProgram) CMD(CreateRenderbuffers) CMD(CreateShader) CMD(CreateTextures)    \
+  CMD(CullFace) CMD(DebugMessageCallback) CMD(DebugMessageControl) CMD(DeleteBuffers)  \
+  CMD(DeleteFramebuffers) CMD(DeleteProgram) CMD(DeleteQueries)                        \
+  CMD(DeleteRenderbuffers) CMD(DeleteShader) CMD(DeleteSync) CMD(DeleteTextures)       \
+  CMD(DeleteVertexArrays) CMD(DepthMask) CMD(DetachShader) CMD(Disable)                \
+  CMD(DrawArrays) CMD(DrawElements) CMD(Enable) CMD(EnableVertexAttribArray)           \
+  CMD(FenceSync) CMD(Finish) CMD(Flush) CMD(GenBuffers) CMD(GenQueries)                \
+  CMD(GenTextures) CMD(GenVertexArrays) CMD(GenerateMipmap) CMD(GetActiveAttrib)       \
+  CMD(GetActiveUniform) CMD(GetAttachedShaders) CMD(GetAttribLocation)                 \
+  CMD(GetIntegerv) CMD(GetProgramBinary) CMD(GetProgramInfoLog)                        \
+  CMD(GetProgramInterfaceiv)                                                           \
+  CMD(GetProgramResourceIndex) CMD(GetProgramResourceName) CMD(GetProgramResourceiv)   \
+  CMD(GetProgramiv) CMD(GetQueryObjectiv) CMD(GetQueryObjectui64v)                     \
+  CMD(GetShaderInfoLog) CMD(GetShaderiv) CMD(GetString) CMD(GetUniformLocation)        \
+  CMD(IsProgram) CMD(IsShader) CMD(LinkProgram) CMD(MapBufferRange)                    \
+  CMD(MaxShaderCompilerThreadsKHR)                                                     \
+  CMD(NamedFramebufferRenderbuffer)                                                    \
+  CMD(NamedFramebufferTexture) CMD(NamedRenderbufferStorage) CMD(PixelStorei)          \
+  CMD(PolygonMode) CMD(PrimitiveRestartIndex) CMD(ProgramBinary)                       \
+  CMD(ProgramParameteri) CMD(QueryCounter) CMD(ReadBuffer)                             \
+  CMD(ReadPixels) CMD(ShaderSource) CMD(TexParameteri) CMD(TexStorage2D)               \
+  CMD(TexSubImage2D) CMD(TextureStorage2D) CMD(UnmapBuffer) CMD(UseProgram)            \
+  CMD(VertexAttribBinding)                                                             \
+  CMD(VertexAttribFormat) CMD(VertexAttribIFormat)                                     \
+  CMD(Viewport) CMD(Present)
+
+/* Main program namespace */
+namespace tse
+{
+  /* Null OpenGL backend class (static only) */
+  class gl_null
+  {
+  public:
+#define TSE_GL_NULL_ENUM(Name) Name,
+    /* Command identifiers */
+    enum struct cmd : WORD
+    {
+      TSE_GL_NULL_COMMANDS(TSE_GL_NULL_ENUM)
+      Count
+    }; /* End of 'cmd' enumeration */
+#undef TSE_GL_NULL_ENUM
+
+    /* Submission counters structure */
+    struct COUNTERS
+    {
+      UINT64 Calls[(INT)cmd::Count]; // Per command calls number
+      UINT64 DrawCalls;              // Number of draw calls
+      UINT64 Vertices;               // Number of submitted vertices/indices
+      UINT64 UploadBytes;            // Number of bytes passed to buffer uploads
+    }; /* End of 'COUNTERS' structure */
+
+    inline static COUNTERS Counters {};        // Current counters
+    inline static BOOL IsTracing = FALSE;      // Command trace record flag
+    inline static std::vector<BYTE> Trace;     // Recorded command trace
+    inline static UINT NextId = 0;             // Next generated object name
+    inline static std::vector<BYTE> MapMemory; // Mapped buffer memory (one mapping at a time)
+
+    /* Get command name function.
+     * ARGUMENTS:
+     *   - command identifier:
+     *       cmd Cmd;
+     * RETURNS:
+     *   (const CHAR *) command name.
+     */
+    static const CHAR * Name( cmd Cmd )
+    {
+#define TSE_GL_NULL_NAME(Name) "gl" #Name,
+      static const CHAR *names[] {TSE_GL_NULL_COMMANDS(TSE_GL_NULL_NAME)};
+#undef TSE_GL_NULL_NAME
+      return Cmd < cmd::Count ? names[(INT)Cmd] : "<unknown>";
+    } /* End of 'Name' function */
+
+    /* Reset counters (and trace) function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    static VOID Reset( VOID )
+    {
+      Counters = {};
+      Trace.clear();
+    } /* End of 'Reset' function */
+
+    /* Obtain total number of OpenGL calls function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) calls number.
+     */
+    static UINT64 TotalCalls( VOID )
+    {
+      UINT64 sum = 0;
+      for (auto c : Counters.Calls)
+        sum += c;
+      return sum;
+    } /* End of 'TotalCalls' function */
+
+    /* Build counters report function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (std::string) report text (one non-zero command per line).
+     */
+    static std::string Report( VOID )
+    {
+      std::string rep = std::format("calls: {}, draws: {}, vertices: {}, upload: {} bytes\n",
+        TotalCalls(), Counters.DrawCalls, Counters.Vertices, Counters.UploadBytes);
+      for (INT i = 0; i < (INT)cmd::Count; i++)
+        if (Counters.Calls[i] != 0)
+          rep += std::format("  {:<32} {}\n", Name((cmd)i), Counters.Calls[i]);
+      return rep;
+    } /* End of 'Report' function */
+
+    /* Save recorded trace to file function.
+     * Format: "TSEGLTR1", then records of
+     *   WORD command, WORD number of arguments, UINT64 arguments[].
+     * Pointer arguments are stored as 0/1 (null/non-null) to keep traces
+     * comparable between runs, floats are stored as double bits.
+     * ARGUMENTS:
+     *   - file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if success, FALSE otherwise.
+     */
+    static BOOL SaveTrace( const std::string &FileName )
+    {
+      std::fstream f(FileName, std::fstream::out | std::fstream::binary);
+      if (!f.is_open())
+        return FALSE;
+      f.write("TSEGLTR1", 8);
+      f.write((CHAR *)Trace.data(), Trace.size());
+      return TRUE;
+    } /* End of 'SaveTrace' function */
+
+    /* Convert command argument to trace value function.
+     * ARGUMENTS:
+     *   - argument:
+     *       type X;
+     * RETURNS:
+     *   (UINT64) trace value.
+     */
+    template<typename type>
+      static UINT64 Arg( type X )
+      {
+        if constexpr (std::is_pointer_v<type> || std::is_null_pointer_v<type>)
+          return X != nullptr;
+        else if constexpr (std::is_floating_point_v<type>)
+        {
+          DBL d = X;
+          UINT64 u;
+          memcpy(&u, &d, sizeof(u));
+          return u;
+        }
+        else
+          return (UINT64)X;
+      } /* End of 'Arg' function */
+
+    /* Count and record command function.
+     * ARGUMENTS:
+     *   - command identifier:
+     *       cmd Cmd;
+     *   - command arguments:
+     *       args ... Args;
+     * RETURNS: None.
+     */
+    template<typename ... args>
+      static VOID Record( cmd Cmd, args ... Args )
+      {
+        Counters.Calls[(INT)Cmd]++;
+        if (!IsTracing)
+          return;
+        std::array<UINT64, sizeof...(args)> a {Arg(Args)...};
+        WORD hdr[2] {(WORD)Cmd, (WORD)a.size()};
+        Trace.insert(Trace.end(), (BYTE *)hdr, (BYTE *)(hdr + 2));
+        Trace.insert(Trace.end(), (BYTE *)a.data(), (BYTE *)(a.data() + a.size()));
+      } /* End of 'Record' function */
+
+    /* Generic command without result stub function.
+     * ARGUMENTS:
+     *   - command arguments:
+     *       args ... Args;
+     * RETURNS: None.
+     */
+    template<cmd Cmd, typename ... args>
+      static VOID Call( args ... Args )
+      {
+        Record(Cmd, Args...);
+      } /* End of 'Call' function */
+
+    /* Object names generation command stub function.
+     * ARGUMENTS:
+     *   - number of names:
+     *       GLsizei N;
+     *   - names array:
+     *       GLuint *Names;
+     * RETURNS: None.
+     */
+    template<cmd Cmd>
+      static VOID Gen( GLsizei N, GLuint *Names )
+      {
+        Record(Cmd, N, Names);
+        for (INT i = 0; i < N; i++)
+          Names[i] = ++NextId;
+      } /* End of 'Gen' function */
+
+    /* Object creation command stub function.
+     * ARGUMENTS:
+     *   - command arguments:
+     *       args ... Args;
+     * RETURNS:
+     *   (GLuint) object name.
+     */
+    template<cmd Cmd, typename ... args>
+      static GLuint Create( args ... Args )
+      {
+        Record(Cmd, Args...);
+        return ++NextId;
+      } /* End of 'Create' function */
+
+    /* Integer query command stub function (all queries succeed with zero counts).
+     * ARGUMENTS:
+     *   - object name:
+     *       GLuint Obj;
+     *   - parameter name:
+     *       GLenum PName;
+     *   - result:
+     *       GLint *Params;
+     * RETURNS: None.
+     */
+    template<cmd Cmd>
+      static VOID GetObjectiv( GLuint Obj, GLenum PName, GLint *Params )
+      {
+        Record(Cmd, Obj, PName, Params);
+        *Params =
+          PName == GL_COMPILE_STATUS || PName == GL_LINK_STATUS ||
+          PName == GL_COMPLETION_STATUS_KHR || PName == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+      } /* End of 'GetObjectiv' function */
+
+    /* Info log command stub function.
+     * ARGUMENTS:
+     *   - object name:
+     *       GLuint Obj;
+     *   - buffer size:
+     *       GLsizei BufSize;
+     *   - result length:
+     *       GLsizei *Length;
+     *   - result text:
+     *       GLchar *Log;
+     * RETURNS: None.
+     */
+    template<cmd Cmd>
+      static VOID GetInfoLog( GLuint Obj, GLsizei BufSize, GLsizei *Length, GLchar *Log )
+      {
+        Record(Cmd, Obj, BufSize, Length, Log);
+        if (Length != nullptr)
+          *Length = 0;
+        if (Log != nullptr && BufSize > 0)
+          Log[0] = 0;
+      } /* End of 'GetInfoLog' function */
+
+    /* 'glDrawArrays' command stub function (arguments as in OpenGL). */
+    static VOID DrawArrays( GLenum Mode, GLint First, GLsizei Count )
+    {
+      Record(cmd::DrawArrays, Mode, First, Count);
+      Counters.DrawCalls++;
+      Counters.Vertices += Count;
+    } /* End of 'DrawArrays' function */
+
+    /* 'glDrawElements' command stub function (arguments as in OpenGL). */
+    static VOID DrawElements( GLenum Mode, GLsizei Count, GLenum Type, const VOID *Indices )
+    {
+      Record(cmd::DrawElements, Mode, Count, Type, Indices);
+      Counters.DrawCalls++;
+      Counters.Vertices += Count;
+    } /* End of 'DrawElements' function */
+
+    /* 'glBufferData' command stub function (arguments as in OpenGL). */
+    static VOID BufferData( GLenum Target, GLsizeiptr Size, const VOID *Data, GLenum Usage )
+    {
+      Record(cmd::BufferData, Target, Size, Data, Usage);
+      Counters.UploadBytes += Data != nullptr ? Size : 0;
+    } /* End of 'BufferData' function */
+
+    /* 'glBufferSubData' command stub function (arguments as in OpenGL). */
+    static VOID BufferSubData( GLenum Target, GLintptr Offset, GLsizeiptr Size, const VOID *Data )
+    {
+      Record(cmd::BufferSubData, Target, Offset, Size, Data);
+      Counters.UploadBytes += Size;
+    } /* End of 'BufferSubData' function */
+
+    /* 'glBufferStorage' command stub function (arguments as in OpenGL). */
+    static VOID BufferStorage( GLenum Target, GLsizeiptr Size, const VOID *Data, GLbitfield Flags )
+    {
+      Record(cmd::BufferStorage, Target, Size, Data, Flags);
+      Counters.UploadBytes += Data != nullptr ? Size : 0;
+    } /* End of 'BufferStorage' function */
+
+    /* 'glMapBufferRange' command stub function (arguments as in OpenGL). */
+    static VOID * MapBufferRange( GLenum Target, GLintptr Offset, GLsizeiptr Length, GLbitfield Access )
+    {
+      Record(cmd::MapBufferRange, Target, Offset, Length, Access);
+      MapMemory.resize(Length);
+      return MapMemory.data();
+    } /* End of 'MapBufferRange' function */
+
+    /* 'glTexSubImage2D' command stub function (arguments as in OpenGL). */
+    static VOID TexSubImage2D( GLenum Target, GLint Level, GLint X, GLint Y, GLsizei W, GLsizei H,
+                               GLenum Format, GLenum Type, const VOID *Pixels )
+    {
+      Record(cmd::TexSubImage2D, Target, Level, X, Y, W, H, Format, Type, Pixels);
+      Counters.UploadBytes += (UINT64)W * H * (Format == GL_BGRA ? 4 : Format == GL_BGR ? 3 : 1);
+    } /* End of 'TexSubImage2D' function */
+
+    /* 'glGetString' command stub function (arguments as in OpenGL). */
+    static const GLubyte * GetString( GLenum Name )
+    {
+      Record(cmd::GetString, Name);
+      return (const GLubyte *)"TSE null render";
+    } /* End of 'GetString' function */
+
+    /* 'glGetIntegerv' command stub function (arguments as in OpenGL). */
+    static VOID GetIntegerv( GLenum PName, GLint *Data )
+    {
+      Record(cmd::GetIntegerv, PName, Data);
+      Data[0] = PName == GL_POLYGON_MODE ? GL_FILL : 0;
+    } /* End of 'GetIntegerv' function */
+
+    /* 'glIsShader' command stub function (arguments as in OpenGL). */
+    static GLboolean IsShader( GLuint Shader )
+    {
+      Record(cmd::IsShader, Shader);
+      return Shader != 0;
+    } /* End of 'IsShader' function */
+
+    /* 'glIsProgram' command stub function (arguments as in OpenGL). */
+    static GLboolean IsProgram( GLuint Program )
+    {
+      Record(cmd::IsProgram, Program);
+      return Program != 0;
+    } /* End of 'IsProgram' function */
+
+    /* 'glGetAttachedShaders' command stub function (arguments as in OpenGL). */
+    static VOID GetAttachedShaders( GLuint Program, GLsizei MaxCount, GLsizei *Count, GLuint *Shaders )
+    {
+      Record(cmd::GetAttachedShaders, Program, MaxCount, Count, Shaders);
+      if (Count != nullptr)
+        *Count = 0;
+    } /* End of 'GetAttachedShaders' function */
+
+    /* 'glGetActiveAttrib' command stub function (arguments as in OpenGL). */
+    static VOID GetActiveAttrib( GLuint Program, GLuint Index, GLsizei BufSize, GLsizei *Length,
+                                 GLint *Size, GLenum *Type, GLchar *Name )
+    {
+      Record(cmd::GetActiveAttrib, Program, Index, BufSize, Length, Size, Type, Name);
+      *Size = 0, *Type = GL_FLOAT, Name[0] = 0;
+    } /* End of 'GetActiveAttrib' function */
+
+    /* 'glGetActiveUniform' command stub function (arguments as in OpenGL). */
+    static VOID GetActiveUniform( GLuint Program, GLuint Index, GLsizei BufSize, GLsizei *Length,
+                                  GLint *Size, GLenum *Type, GLchar *Name )
+    {
+      Record(cmd::GetActiveUniform, Program, Index, BufSize, Length, Size, Type, Name);
+      *Size = 0, *Type = GL_FLOAT, Name[0] = 0;
+    } /* End of 'GetActiveUniform' function */
+
+    /* 'glGetAttribLocation' command stub function (arguments as in OpenGL). */
+    static GLint GetAttribLocation( GLuint Program, const GLchar *Name )
+    {
+      Record(cmd::GetAttribLocation, Program, Name);
+      return -1;
+    } /* End of 'GetAttribLocation' function */
+
+    /* 'glGetUniformLocation' command stub function (arguments as in OpenGL). */
+    static GLint GetUniformLocation( GLuint Program, const GLchar *Name )
+    {
+      Record(cmd::GetUniformLocation, Program, Name);
+      return -1;
+    } /* End of 'GetUniformLocation' function */
+
+    /* 'glGetProgramInterfaceiv' command stub function (arguments as in OpenGL). */
+    static VOID GetProgramInterfaceiv( GLuint Program, GLenum Interface, GLenum PName, GLint *Params )
+    {
+      Record(cmd::GetProgramInterfaceiv, Program, Interface, PName, Params);
+      *Params = 0;
+    } /* End of 'GetProgramInterfaceiv' function */
+
+    /* 'glGetProgramResourceIndex' command stub function (arguments as in OpenGL). */
+    static GLuint GetProgramResourceIndex( GLuint Program, GLenum Interface, const GLchar *Name )
+    {
+      Record(cmd::GetProgramResourceIndex, Program, Interface, Name);
+      return GL_INVALID_INDEX;
+    } /* End of 'GetProgramResourceIndex' function */
+
+    /* 'glGetProgramResourceName' command stub function (arguments as in OpenGL). */
+    static VOID GetProgramResourceName( GLuint Program, GLenum Interface, GLuint Index,
+                                        GLsizei BufSize, GLsizei *Length, GLchar *Name )
+    {
+      Record(cmd::GetProgramResourceName, Program, Interface, Index, BufSize, Length, Name);
+      if (BufSize > 0)
+        Name[0] = 0;
+    } /* End of 'GetProgramResourceName' function */
+
+    /* 'glGetProgramResourceiv' command stub function (arguments as in OpenGL). */
+    static VOID GetProgramResourceiv( GLuint Program, GLenum Interface, GLuint Index,
+                                      GLsizei PropCount, const GLenum *Props, GLsizei BufSize,
+                                      GLsizei *Length, GLint *Params )
+    {
+      Record(cmd::GetProgramResourceiv, Program, Interface, Index, PropCount, Props, BufSize, Length, Params);
+      for (INT i = 0; i < BufSize; i++)
+        Params[i] = 0;
+    } /* End of 'GetProgramResourceiv' function */
+
+    /* 'glGetQueryObjectui64v' command stub function (arguments as in OpenGL). */
+    static VOID GetQueryObjectui64v( GLuint Id, GLenum PName, GLuint64 *Params )
+    {
+      Record(cmd::GetQueryObjectui64v, Id, PName, Params);
+      *Params = 0;
+    } /* End of 'GetQueryObjectui64v' function */
+
+    /* 'glFenceSync' command stub function (arguments as in OpenGL). */
+    static GLsync FenceSync( GLenum Condition, GLbitfield Flags )
+    {
+      Record(cmd::FenceSync, Condition, Flags);
+      return reinterpret_cast<GLsync>((UINT_PTR)++NextId);
+    } /* End of 'FenceSync' function */
+
+    /* 'glClientWaitSync' command stub function (arguments as in OpenGL). */
+    static GLenum ClientWaitSync( GLsync Sync, GLbitfield Flags, GLuint64 Timeout )
+    {
+      Record(cmd::ClientWaitSync, Sync, Flags, Timeout);
+      return GL_ALREADY_SIGNALED;
+    } /* End of 'ClientWaitSync' function */
+
+    /* 'glCheckNamedFramebufferStatus' command stub function (arguments as in OpenGL). */
+    static GLenum CheckNamedFramebufferStatus( GLuint Framebuffer, GLenum Target )
+    {
+      Record(cmd::CheckNamedFramebufferStatus, Framebuffer, Target);
+      return GL_FRAMEBUFFER_COMPLETE;
+    } /* End of 'CheckNamedFramebufferStatus' function */
+
+  }; /* End of 'gl_null' class */
+
+} /* end of 'tse' namespace */
+
+/* Redirect OpenGL calls to null backend (GLEW defines most of them as macros) */
+#undef glActiveTexture
+#undef glAttachShader
+#undef glBindBuffer
+#undef glBindBufferBase
+#undef glBindFramebuffer
+#undef glBindVertexArray
+#undef glBindVertexBuffer
+#undef glBufferData
+#undef glBufferStorage
+#undef glBufferSubData
+#undef glCheckNamedFramebufferStatus
+#undef glClearBufferfv
+#undef glClientWaitSync
+#undef glCompileShader
+#undef glCreateFramebuffers
+#undef glCreateProgram
+#undef glCreateRenderbuffers
+#undef glCreateShader
+#undef glCreateTextures
+#undef glDebugMessageCallback
+#undef glDebugMessageControl
+#undef glDeleteBuffers
+#undef glDeleteFramebuffers
+#undef glDeleteProgram
+#undef glDeleteQueries
+#undef glDeleteRenderbuffers
+#undef glDeleteShader
+#undef glDeleteSync
+#undef glDeleteVertexArrays
+#undef glDetachShader
+#undef glEnableVertexAttribArray
+#undef glFenceSync
+#undef glGenBuffers
+#undef glGenQueries
+#undef glGenVertexArrays
+#undef glGenerateMipmap
+#undef glGetActiveAttrib
+#undef glGetActiveUniform
+#undef glGetAttachedShaders
+#undef glGetAttribLocation
+#undef glGetProgramBinary
+#undef glGetProgramInfoLog
+#undef glGetProgramInterfaceiv
+#undef glGetProgramResourceIndex
+#undef glGetProgramResourceName
+#undef glGetProgramResourceiv
+#undef glGetProgramiv
+#undef glGetQueryObjectiv
+#undef glGetQueryObjectui64v
+#undef glGetShaderInfoLog
+#undef glGetShaderiv
+#undef glGetUniformLocation
+#undef glIsProgram
+#undef glIsShader
+#undef glLinkProgram
+#undef glMapBufferRange
+#undef glMaxShaderCompilerThreadsKHR
+#undef glNamedFramebufferRenderbuffer
+#undef glNamedFramebufferTexture
+#undef glNamedRenderbufferStorage
+#undef glPrimitiveRestartIndex
+#undef glProgramBinary
+#undef glProgramParameteri
+#undef glQueryCounter
+#undef glShaderSource
+#undef glTexStorage2D
+#undef glTextureStorage2D
+#undef glUnmapBuffer
+#undef glUseProgram
+#undef glVertexAttribBinding
+#undef glVertexAttribFormat
+#undef glVertexAttribIFormat
+
+#define TSE_GL_NULL_CALL(Name) tse::gl_null::Call<tse::gl_null::cmd::Name>
+
+#define glActiveTexture                TSE_GL_NULL_CALL(ActiveTexture)
+#define glAttachShader                 TSE_GL_NULL_CALL(AttachShader)
+#define glBindBuffer                   TSE_GL_NULL_CALL(BindBuffer)
+#define glBindBufferBase               TSE_GL_NULL_CALL(BindBufferBase)
+#define glBindFramebuffer              TSE_GL_NULL_CALL(BindFramebuffer)
+#define glBindTexture                  TSE_GL_NULL_CALL(BindTexture)
+#define glBindVertexArray              TSE_GL_NULL_CALL(BindVertexArray)
+#define glBindVertexBuffer             TSE_GL_NULL_CALL(BindVertexBuffer)
+#define glBlendFunc                    TSE_GL_NULL_CALL(BlendFunc)
+#define glBufferData                   tse::gl_null::BufferData
+#define glBufferStorage                tse::gl_null::BufferStorage
+#define glBufferSubData                tse::gl_null::BufferSubData
+#define glCheckNamedFramebufferStatus  tse::gl_null::CheckNamedFramebufferStatus
+#define glClearBufferfv                TSE_GL_NULL_CALL(ClearBufferfv)
+#define glClientWaitSync               tse::gl_null::ClientWaitSync
+#define glCompileShader                TSE_GL_NULL_CALL(CompileShader)
+#define glCreateFramebuffers           tse::gl_null::Gen<tse::gl_null::cmd::CreateFramebuffers>
+#define glCreateProgram                tse::gl_null::Create<tse::gl_null::cmd::CreateProgram>
+#define glCreateRenderbuffers          tse::gl_null::Gen<tse::gl_null::cmd::CreateRenderbuffers>
+#define glCreateShader                 tse::gl_null::Create<tse::gl_null::cmd::CreateShader>
+#define glCreateTextures(Target, N, T) tse::gl_null::Gen<tse::gl_null::cmd::CreateTextures>(N, T)
+#define glCullFace                     TSE_GL_NULL_CALL(CullFace)
+#define glDebugMessageCallback         TSE_GL_NULL_CALL(DebugMessageCallback)
+#define glDebugMessageControl          TSE_GL_NULL_CALL(DebugMessageControl)
+#define glDeleteBuffers                TSE_GL_NULL_CALL(DeleteBuffers)
+#define glDeleteFramebuffers           TSE_GL_NULL_CALL(DeleteFramebuffers)
+#define glDeleteProgram                TSE_GL_NULL_CALL(DeleteProgram)
+#define glDeleteQueries                TSE_GL_NULL_CALL(DeleteQueries)
+#define glDeleteRenderbuffers          TSE_GL_NULL_CALL(DeleteRenderbuffers)
+#define glDeleteShader                 TSE_GL_NULL_CALL(DeleteShader)
+#define glDeleteSync                   TSE_GL_NULL_CALL(DeleteSync)
+#define glDeleteTextures               TSE_GL_NULL_CALL(DeleteTextures)
+#define glDeleteVertexArrays           TSE_GL_NULL_CALL(DeleteVertexArrays)
+#define glDepthMask                    TSE_GL_NULL_CALL(DepthMask)
+#define glDetachShader                 TSE_GL_NULL_CALL(DetachShader)
+#define glDisable                      TSE_GL_NULL_CALL(Disable)
+#define glDrawArrays                   tse::gl_null::DrawArrays
+#define glDrawElements                 tse::gl_null::DrawElements
+#define glEnable                       TSE_GL_NULL_CALL(Enable)
+#define glEnableVertexAttribArray      TSE_GL_NULL_CALL(EnableVertexAttribArray)
+#define glFenceSync                    tse::gl_null::FenceSync
+#define glFinish                       TSE_GL_NULL_CALL(Finish)
+#define glFlush                        TSE_GL_NULL_CALL(Flush)
+#define glGenBuffers                   tse::gl_null::Gen<tse::gl_null::cmd::GenBuffers>
+#define glGenQueries                   tse::gl_null::Gen<tse::gl_null::cmd::GenQueries>
+#define glGenTextures                  tse::gl_null::Gen<tse::gl_null::cmd::GenTextures>
+#define glGenVertexArrays              tse::gl_null::Gen<tse::gl_null::cmd::GenVertexArrays>
+#define glGenerateMipmap               TSE_GL_NULL_CALL(GenerateMipmap)
+#define glGetActiveAttrib              tse::gl_null::GetActiveAttrib
+#define glGetActiveUniform             tse::gl_null::GetActiveUniform
+#define glGetAttachedShaders           tse::gl_null::GetAttachedShaders
+#define glGetAttribLocation            tse::gl_null::GetAttribLocation
+#define glGetIntegerv                  tse::gl_null::GetIntegerv
+#define glGetProgramBinary             TSE_GL_NULL_CALL(GetProgramBinary)
+#define glGetProgramInfoLog            tse::gl_null::GetInfoLog<tse::gl_null::cmd::GetProgramInfoLog>
+#define glGetProgramInterfaceiv        tse::gl_null::GetProgramInterfaceiv
+#define glGetProgramResourceIndex      tse::gl_null::GetProgramResourceIndex
+#define glGetProgramResourceName       tse::gl_null::GetProgramResourceName
+#define glGetProgramResourceiv         tse::gl_null::GetProgramResourceiv
+#define glGetProgramiv                 tse::gl_null::GetObjectiv<tse::gl_null::cmd::GetProgramiv>
+#define glGetQueryObjectiv             tse::gl_null::GetObjectiv<tse::gl_null::cmd::GetQueryObjectiv>
+#define glGetQueryObjectui64v          tse::gl_null::GetQueryObjectui64v
+#define glGetShaderInfoLog             tse::gl_null::GetInfoLog<tse::gl_null::cmd::GetShaderInfoLog>
+#define glGetShaderiv                  tse::gl_null::GetObjectiv<tse::gl_null::cmd::GetShaderiv>
+#define glGetString                    tse::gl_null::GetString
+#define glGetUniformLocation           tse::gl_null::GetUniformLocation
+#define glIsProgram                    tse::gl_null::IsProgram
+#define glIsShader                     tse::gl_null::IsShader
+#define glLinkProgram                  TSE_GL_NULL_CALL(LinkProgram)
+#define glMapBufferRange               tse::gl_null::MapBufferRange
+#define glMaxShaderCompilerThreadsKHR  TSE_GL_NULL_CALL(MaxShaderCompilerThreadsKHR)
+#define glNamedFramebufferRenderbuffer TSE_GL_NULL_CALL(NamedFramebufferRenderbuffer)
+#define glNamedFramebufferTexture      TSE_GL_NULL_CALL(NamedFramebufferTexture)
+#define glNamedRenderbufferStorage     TSE_GL_NULL_CALL(NamedRenderbufferStorage)
+#define glPixelStorei                  TSE_GL_NULL_CALL(PixelStorei)
+#define glPolygonMode                  TSE_GL_NULL_CALL(PolygonMode)
+#define glPrimitiveRestartIndex        TSE_GL_NULL_CALL(PrimitiveRestartIndex)
+#define glProgramBinary                TSE_GL_NULL_CALL(ProgramBinary)
+#define glProgramParameteri            TSE_GL_NULL_CALL(ProgramParameteri)
+#define glQueryCounter                 TSE_GL_NULL_CALL(QueryCounter)
+#define glReadBuffer                   TSE_GL_NULL_CALL(ReadBuffer)
+#define glReadPixels                   TSE_GL_NULL_CALL(ReadPixels)
+#define glShaderSource                 TSE_GL_NULL_CALL(ShaderSource)
+#define glTexParameteri                TSE_GL_NULL_CALL(TexParameteri)
+#define glTexStorage2D                 TSE_GL_NULL_CALL(TexStorage2D)
+#define glTexSubImage2D                tse::gl_null::TexSubImage2D
+#define glTextureStorage2D             TSE_GL_NULL_CALL(TextureStorage2D)
+#define glUnmapBuffer                  TSE_GL_NULL_CALL(UnmapBuffer)
+#define glUseProgram                   TSE_GL_NULL_CALL(UseProgram)
+#define glVertexAttribBinding          TSE_GL_NULL_CALL(VertexAttribBinding)
+#define glVertexAttribFormat           TSE_GL_NULL_CALL(VertexAttribFormat)
+#define glVertexAttribIFormat          TSE_GL_NULL_CALL(VertexAttribIFormat)
+#define glViewport                     TSE_GL_NULL_CALL(Viewport)
+
+#endif /* __gl_null_h_ */
+
+/* END OF 'gl_null.h' FILE */
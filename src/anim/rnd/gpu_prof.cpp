@@ -0,0 +1,241 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : gpu_prof.cpp
+ * PURPOSE     : Tough Space Exploration project.
+ *               Render system module.
+ *               GPU timer queries profiler implementation module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include "tse.h"
+
+/* Delete all queries function (while rendering context is alive).
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::gpu_profiler::Close( VOID )
+{
+  /* Every created query is either free, open or pending */
+  std::vector<UINT> ids = std::move(Pool);
+  for (auto &p : Open)
+    if (p.Start != 0)
+      ids.push_back(p.Start);
+  for (auto &p : Pending)
+    ids.push_back(p.Start), ids.push_back(p.End);
+  if (!ids.empty())
+    glDeleteQueries((INT)ids.size(), ids.data());
+  Pool.clear();
+  Open.clear();
+  Pending.clear();
+  TotalQueries = 0;
+} /* End of 'tse::gpu_profiler::Close' function */
+
+/* Get query from pool function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (UINT) query id or 0 if pool is exhausted.
+ */
+UINT tse::gpu_profiler::GetQuery( VOID )
+{
+  if (Pool.empty())
+  {
+    if (TotalQueries >= MaxQueries)
+      return 0;
+    /* Grow pool by chunks */
+    UINT ids[64];
+    glGenQueries(64, ids);
+    Pool.insert(Pool.end(), ids, ids + 64);
+    TotalQueries += 64;
+  }
+  UINT q = Pool.back();
+  Pool.pop_back();
+  return q;
+} /* End of 'tse::gpu_profiler::GetQuery' function */
+
+/* Get zone index by name function.
+ * ARGUMENTS:
+ *   - zone name:
+ *       const std::string &Name;
+ * RETURNS:
+ *   (INT) zone index.
+ */
+INT tse::gpu_profiler::Zone( const std::string &Name )
+{
+  if (auto z = ZoneIds.find(Name); z != ZoneIds.end())
+    return z->second;
+  ZONE zone {Name, (INT)Open.size(), std::vector<DBL>(HistorySize), 0, 0};
+  Zones.push_back(zone);
+  return ZoneIds[Name] = (INT)Zones.size() - 1;
+} /* End of 'tse::gpu_profiler::Zone' function */
+
+/* Start new frame profiling (read back available results) function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::gpu_profiler::FrameStart( VOID )
+{
+  /* Results become available in issue order: stop on first unavailable */
+  while (!Pending.empty() && Pending.front().FrameNo + ReadLatency <= FrameNo)
+  {
+    PENDING &p = Pending.front();
+    INT is_available = 0;
+    glGetQueryObjectiv(p.End, GL_QUERY_RESULT_AVAILABLE, &is_available);
+    if (!is_available)
+      break;
+    GLuint64 t0 = 0, t1 = 0;
+    glGetQueryObjectui64v(p.Start, GL_QUERY_RESULT, &t0);
+    glGetQueryObjectui64v(p.End, GL_QUERY_RESULT, &t1);
+
+    ZONE &z = Zones[p.Zone];
+    z.History[z.HistoryPos] = (t1 - t0) / 1e6;
+    z.HistoryPos = (z.HistoryPos + 1) % HistorySize;
+    z.Count++;
+
+    Pool.push_back(p.Start);
+    Pool.push_back(p.End);
+    Pending.pop_front();
+  }
+  /* Unbalanced zones from previous frame are dropped */
+  for (auto &o : Open)
+    Pool.push_back(o.Start);
+  Open.clear();
+  FrameNo++;
+} /* End of 'tse::gpu_profiler::FrameStart' function */
+
+/* Begin zone measurement function.
+ * ARGUMENTS:
+ *   - zone index:
+ *       INT ZoneId;
+ * RETURNS: None.
+ */
+VOID tse::gpu_profiler::Begin( INT ZoneId )
+{
+  if (!IsEnabled)
+    return;
+  UINT q = GetQuery();
+  if (q != 0)
+    glQueryCounter(q, GL_TIMESTAMP);
+  Open.push_back({ZoneId, q, 0, FrameNo});
+} /* End of 'tse::gpu_profiler::Begin' function */
+
+/* End last begun zone measurement function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::gpu_profiler::End( VOID )
+{
+  if (!IsEnabled || Open.empty())
+    return;
+  PENDING p = Open.back();
+  Open.pop_back();
+  if (p.Start == 0)
+    return;
+  if ((p.End = GetQuery()) == 0)
+  {
+    Pool.push_back(p.Start);
+    return;
+  }
+  glQueryCounter(p.End, GL_TIMESTAMP);
+  Pending.push_back(p);
+} /* End of 'tse::gpu_profiler::End' function */
+
+/* Obtain zone statistics function.
+ * ARGUMENTS:
+ *   - zone index:
+ *       INT ZoneId;
+ * RETURNS:
+ *   (STATS) zone statistics.
+ */
+tse::gpu_profiler::STATS tse::gpu_profiler::Stats( INT ZoneId ) const
+{
+  STATS st {};
+  if (ZoneId < 0 || ZoneId >= Zones.size())
+    return st;
+  const ZONE &z = Zones[ZoneId];
+  INT n = z.Count < HistorySize ? z.Count : HistorySize;
+  if (n == 0)
+    return st;
+
+  std::vector<DBL> s(z.History.begin(), z.History.begin() + n);
+  std::sort(s.begin(), s.end());
+  DBL sum = 0;
+  for (auto t : s)
+    sum += t;
+  st.Count = n;
+  st.Min = s.front();
+  st.Max = s.back();
+  st.Avg = sum / n;
+  st.P50 = s[(n - 1) * 50 / 100];
+  st.P95 = s[(n - 1) * 95 / 100];
+  st.P99 = s[(n - 1) * 99 / 100];
+  return st;
+} /* End of 'tse::gpu_profiler::Stats' function */
+
+/* Build text report function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (std::string) report text (one zone per line).
+ */
+std::string tse::gpu_profiler::Report( VOID ) const
+{
+  std::string rep;
+  for (INT i = 0; i < Zones.size(); i++)
+  {
+    STATS st = Stats(i);
+    rep += std::format("{}{:<16} avg {:6.3f} min {:6.3f} max {:6.3f} p50 {:6.3f} p95 {:6.3f} p99 {:6.3f} ms\n",
+      std::string(Zones[i].Depth * 2, ' '), Zones[i].Name,
+      st.Avg, st.Min, st.Max, st.P50, st.P95, st.P99);
+  }
+  return rep;
+} /* End of 'tse::gpu_profiler::Report' function */
+
+/* Draw report with font function.
+ * ARGUMENTS:
+ *   - font to draw with:
+ *       font *Fnt;
+ *   - draw position:
+ *       const vec3 &Pos;
+ *   - font size:
+ *       FLT Size;
+ * RETURNS: None.
+ */
+VOID tse::gpu_profiler::Draw( font *Fnt, const vec3 &Pos, FLT Size ) const
+{
+  if (Fnt != nullptr)
+    Fnt->Draw("GPU profile:\n" + Report(), Pos, Size);
+} /* End of 'tse::gpu_profiler::Draw' function */
+
+/* Dump report to file function.
+ * ARGUMENTS:
+ *   - file name:
+ *       const std::string &FileName;
+ * RETURNS:
+ *   (BOOL) TRUE if success, FALSE otherwise.
+ */
+BOOL tse::gpu_profiler::Dump( const std::string &FileName ) const
+{
+  std::ofstream f(FileName);
+  if (!f.is_open())
+    return FALSE;
+  f << "zone;depth;samples;avg_ms;min_ms;max_ms;p50_ms;p95_ms;p99_ms\n";
+  for (INT i = 0; i < Zones.size(); i++)
+  {
+    STATS st = Stats(i);
+    f << std::format("{};{};{};{:.4f};{:.4f};{:.4f};{:.4f};{:.4f};{:.4f}\n",
+      Zones[i].Name, Zones[i].Depth, st.Count,
+      st.Avg, st.Min, st.Max, st.P50, st.P95, st.P99);
+  }
+  tse::logger::Info("GPU profile dumped: " + FileName);
+  return TRUE;
+} /* End of 'tse::gpu_profiler::Dump' function */
+
+/* END OF 'gpu_prof.cpp' FILE */
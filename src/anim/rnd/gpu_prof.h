@@ -0,0 +1,175 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : gpu_prof.h
+ * PURPOSE     : Tough Space Exploration project.
+ *               Render system module.
+ *               GPU timer queries profiler declaration module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __gpu_prof_h_
+#define __gpu_prof_h_
+
+/* Main program namespace */
+namespace tse
+{
+  class font;
+
+  /* GPU profiler class.
+   * Zones are measured by pairs of GL_TIMESTAMP counter queries (unlike
+   * GL_TIME_ELAPSED queries they may be nested: frame -> pass -> unit).
+   * Results are read back only when available, at least 'ReadLatency'
+   * frames later, so the CPU never stalls on the GPU. */
+  class gpu_profiler
+  {
+  public:
+    static const INT
+      ReadLatency = 3,   // Minimal number of frames before result readback
+      HistorySize = 256, // Number of samples kept per zone
+      MaxQueries = 2048; // Query pool size limit
+
+    /* Zone statistics structure (all times in milliseconds) */
+    struct STATS
+    {
+      DBL Min, Avg, Max; // Minimum, average and maximum time
+      DBL P50, P95, P99; // Percentiles
+      INT Count;         // Number of samples
+    }; /* End of 'STATS' structure */
+
+  private:
+    /* Profile zone data structure */
+    struct ZONE
+    {
+      std::string Name;         // Zone name
+      INT Depth;                // Nesting depth (for output indentation)
+      std::vector<DBL> History; // Samples ring buffer
+      INT HistoryPos;           // Ring buffer write position
+      INT Count;                // Total number of samples stored
+    }; /* End of 'ZONE' structure */
+
+    /* Issued zone queries structure */
+    struct PENDING
+    {
+      INT Zone;         // Zone index
+      UINT Start, End;  // Timestamp queries
+      UINT64 FrameNo;   // Frame number when issued
+    }; /* End of 'PENDING' structure */
+
+    std::vector<ZONE> Zones;            // Profile zones
+    std::map<std::string, INT> ZoneIds; // Zone index by name
+    std::vector<UINT> Pool;             // Free queries pool
+    INT TotalQueries = 0;               // Number of created queries
+    std::vector<PENDING> Open;          // Currently open zones stack
+    std::deque<PENDING> Pending;        // Issued queries waiting for results (issue order)
+    UINT64 FrameNo = 0;                 // Profiled frames counter
+
+    /* Get query from pool function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT) query id or 0 if pool is exhausted.
+     */
+    UINT GetQuery( VOID );
+
+  public:
+    BOOL IsEnabled = TRUE; // Profiling enable flag
+
+    /* Delete all queries function (while rendering context is alive).
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Close( VOID );
+
+    /* Get zone index by name function.
+     * ARGUMENTS:
+     *   - zone name:
+     *       const std::string &Name;
+     * RETURNS:
+     *   (INT) zone index.
+     */
+    INT Zone( const std::string &Name );
+
+    /* Start new frame profiling (read back available results) function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID FrameStart( VOID );
+
+    /* Begin zone measurement function.
+     * ARGUMENTS:
+     *   - zone index:
+     *       INT ZoneId;
+     * RETURNS: None.
+     */
+    VOID Begin( INT ZoneId );
+
+    /* Begin zone measurement function.
+     * ARGUMENTS:
+     *   - zone name:
+     *       const std::string &Name;
+     * RETURNS: None.
+     */
+    VOID Begin( const std::string &Name )
+    {
+      if (IsEnabled)
+        Begin(Zone(Name));
+    } /* End of 'Begin' function */
+
+    /* End last begun zone measurement function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID End( VOID );
+
+    /* Obtain zone statistics function.
+     * ARGUMENTS:
+     *   - zone index:
+     *       INT ZoneId;
+     * RETURNS:
+     *   (STATS) zone statistics.
+     */
+    STATS Stats( INT ZoneId ) const;
+
+    /* Build text report function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (std::string) report text (one zone per line).
+     */
+    std::string Report( VOID ) const;
+
+    /* Draw report with font function.
+     * ARGUMENTS:
+     *   - font to draw with:
+     *       font *Fnt;
+     *   - draw position:
+     *       const vec3 &Pos;
+     *   - font size:
+     *       FLT Size;
+     * RETURNS: None.
+     */
+    VOID Draw( font *Fnt, const vec3 &Pos, FLT Size ) const;
+
+    /* Dump report to file function.
+     * ARGUMENTS:
+     *   - file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if success, FALSE otherwise.
+     */
+    BOOL Dump( const std::string &FileName ) const;
+
+  }; /* End of 'gpu_profiler' class */
+
+} /* end of 'tse' namespace */
+
+#endif /* __gpu_prof_h_ */
+
+/* END OF 'gpu_prof.h' FILE */
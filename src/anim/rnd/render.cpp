@@ -9,7 +9,7 @@
  *               Main implementation module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 03.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -42,70 +42,9 @@ tse::render::~render( VOID )
  */
 VOID tse::render::Init( VOID )
 {
-  PIXELFORMATDESCRIPTOR pfd = {0};
-  HGLRC hRC;
-  INT 
-    PixelAttribs[] =
-    {
-      WGL_DRAW_TO_WINDOW_ARB, TRUE,                    /* Window draw support */
-      WGL_SUPPORT_OPENGL_ARB, TRUE,                    /* OpenGL support */
-      WGL_DOUBLE_BUFFER_ARB, TRUE,                     /* Double buffering support */
-      WGL_PIXEL_TYPE_ARB, WGL_TYPE_RGBA_ARB,           /* Pixel format */
-      WGL_ACCELERATION_ARB, WGL_FULL_ACCELERATION_ARB, /* GPU max acceleration */
-      WGL_COLOR_BITS_ARB, 32,                          /* Color buffer bits count */
-      WGL_DEPTH_BITS_ARB, 32,                          /* Depth buffer bits count */
-      0                                                /* End of parameters */
-    },
-    ContextAttribs[] =
-    {
-      WGL_CONTEXT_MAJOR_VERSION_ARB, 4, /* Version */
-      WGL_CONTEXT_MINOR_VERSION_ARB, 6, /*   4.6   */
-      WGL_CONTEXT_PROFILE_MASK_ARB,     /* Compatibility handle */
-      WGL_CONTEXT_CORE_PROFILE_BIT_ARB, /* COMPATIBILITY / CORE */
-      0
-    };
-
-  if (ContextAttribs[5] == WGL_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB)
-  {
-    tse::logger::Warn("WGL_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB enabled!");
-    tse::logger::Warn("Consider switching to WGL_CONTEXT_CORE_PROFILE_BIT_ARB");
-  }
-
-  /* Prepare suitable device context */
-  hDC = GetDC(hWndRef);
-
-  /* OpenGL init: pixel format setup */
-  pfd.nSize = sizeof(PIXELFORMATDESCRIPTOR);
-  pfd.nVersion = 1;
-  pfd.dwFlags = PFD_DOUBLEBUFFER | PFD_SUPPORT_OPENGL;
-  pfd.cColorBits = 32;
-  pfd.cDepthBits = 32;
-  INT i = ChoosePixelFormat(hDC, &pfd);
-  DescribePixelFormat(hDC, i, sizeof(pfd), &pfd);
-  SetPixelFormat(hDC, i, &pfd);
-  tse::logger::LogLn("Pixel format: " + std::to_string(i));
-
-  /* OpenGL init: rendering context setup */
-  hGLRC = wglCreateContext(hDC);
-  wglMakeCurrent(hDC, hGLRC);
-
-  /* Glew initialization */
-  if (glewInit() != GLEW_OK || !(GLEW_ARB_vertex_shader && GLEW_ARB_fragment_shader))
-  {
-    tse::logger::Err("GLEW was not initialized!");
+  /* Platform rendering context setup */
+  if (!CreateContext())
     return;
-  }
-
-  /* Enable a new OpenGL profile support */
-  UINT nums;
-  wglChoosePixelFormatARB(hDC, PixelAttribs, NULL, 1, &i, &nums);
-  hRC = wglCreateContextAttribsARB(hDC, NULL, ContextAttribs);
-  wglMakeCurrent(NULL, NULL);
-  wglDeleteContext(hGLRC);
-  hGLRC = hRC;
-  wglMakeCurrent(hDC, hGLRC);
-
-  wglSwapIntervalEXT(0);
 
   tse::logger::Sys("OpenGL initialized");
   tse::logger::LogLn((CHAR *)glGetString(GL_VERSION));
@@ -139,12 +78,68 @@ VOID tse::render::Init( VOID )
   BufSync = buffer_manager::BufCreate<BUF_SYNC>(1, nullptr);
   BufPrim = buffer_manager::BufCreate<BUF_PRIM>(2, nullptr);
 
-  anim::Get().ShdCreate("default");
+  /* Parallel shader compilation: let driver use all threads it wants */
+  if (GLEW_KHR_parallel_shader_compile)
+    glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+  /* Default shader is a fallback for compiling ones - always synchronous */
+  anim::Get().ShdCreate("default", FALSE);
   anim::Get().MtlCreate("default");
 
   IsRenderInit = TRUE;
 } /* End of 'tse::render::Init' function */
 
+/* Initialize headless (offscreen) rendering function.
+ * ARGUMENTS:
+ *   - frame buffer size:
+ *       INT W, H;
+ * RETURNS:
+ *   (BOOL) TRUE if success, FALSE otherwise.
+ */
+BOOL tse::render::InitHeadless( INT W, INT H )
+{
+  IsHeadless = TRUE;
+  if (!CreateHeadlessWindow(W, H))
+  {
+    tse::logger::Err("Headless context window was not created!");
+    return FALSE;
+  }
+  Init();
+  if (!IsRenderInit)
+    return FALSE;
+  Resize(W, H);
+  tse::logger::Sys(std::format("Headless rendering initialized: {}x{}", W, H));
+  return TRUE;
+} /* End of 'tse::render::InitHeadless' function */
+
+/* Resize offscreen frame buffer function.
+ * ARGUMENTS:
+ *   - new size:
+ *       INT NewW, NewH;
+ * RETURNS: None.
+ */
+VOID tse::render::FrameBufferResize( INT NewW, INT NewH )
+{
+  if (FrameFBO != 0)
+  {
+    glDeleteFramebuffers(1, &FrameFBO);
+    glDeleteTextures(1, &FrameTexColor);
+    glDeleteRenderbuffers(1, &FrameRBDepth);
+  }
+  FrameW = NewW;
+  FrameH = NewH;
+
+  glCreateTextures(GL_TEXTURE_2D, 1, &FrameTexColor);
+  glTextureStorage2D(FrameTexColor, 1, GL_RGBA8, FrameW, FrameH);
+  glCreateRenderbuffers(1, &FrameRBDepth);
+  glNamedRenderbufferStorage(FrameRBDepth, GL_DEPTH_COMPONENT32F, FrameW, FrameH);
+
+  glCreateFramebuffers(1, &FrameFBO);
+  glNamedFramebufferTexture(FrameFBO, GL_COLOR_ATTACHMENT0, FrameTexColor, 0);
+  glNamedFramebufferRenderbuffer(FrameFBO, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, FrameRBDepth);
+  if (glCheckNamedFramebufferStatus(FrameFBO, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    tse::logger::Err("Offscreen frame buffer is not complete!");
+} /* End of 'tse::render::FrameBufferResize' function */
+
 /* Deinitialize OpenGL function.
  * ARGUMENTS: None.
  * RETURNS: None.
@@ -152,8 +147,26 @@ VOID tse::render::Init( VOID )
 VOID tse::render::Close( VOID )
 {
   IsRenderInit = FALSE;
-  wglMakeCurrent(NULL, NULL);
-  wglDeleteContext(hGLRC);
+  resource_loader::LoaderStop();
+  texture_manager::TexStreamClose();
+  primitive_manager::VertexArraysClear();
+  GPUProf.Close();
+  for (auto &f : FrameFences)
+    if (f.Sync != nullptr)
+      glDeleteSync(f.Sync), f.Sync = nullptr;
+  if (FrameFBO != 0)
+  {
+    glDeleteFramebuffers(1, &FrameFBO);
+    glDeleteTextures(1, &FrameTexColor);
+    glDeleteRenderbuffers(1, &FrameRBDepth);
+    FrameFBO = FrameTexColor = FrameRBDepth = 0;
+  }
+  SwapInterval = -1;
+#ifdef _WIN32
+  if (hFrameTimer != nullptr)
+    CloseHandle(hFrameTimer), hFrameTimer = nullptr;
+#endif /* _WIN32 */
+  DeleteContext();
   tse::logger::Sys("Render system closed");
 }  /* End of 'tse::render::Close' function */
 
@@ -165,21 +178,117 @@ VOID tse::render::Close( VOID )
  */
 VOID tse::render::Resize( INT NewW, INT NewH )
 {
+  if (IsHeadless && IsRenderInit)
+    FrameBufferResize(NewW, NewH);
   Cam.Resize(NewW, NewH);
   glViewport(0, 0, NewW, NewH);
 } /* End of 'tse::render::Resize' function */
 
+/* Wait for frame fences function.
+ * ARGUMENTS:
+ *   - number of frames allowed to stay in flight:
+ *       INT InFlight;
+ * RETURNS: None.
+ */
+VOID tse::render::WaitFences( INT InFlight )
+{
+  for (auto &f : FrameFences)
+    if (f.Sync != nullptr && f.FrameNo + InFlight <= FrameNo)
+    {
+      /* Flush only once, then keep waiting in 1 ms portions */
+      GLenum res = glClientWaitSync(f.Sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+      while (res == GL_TIMEOUT_EXPIRED)
+        res = glClientWaitSync(f.Sync, 0, 1000000);
+      glDeleteSync(f.Sync);
+      f.Sync = nullptr;
+    }
+} /* End of 'tse::render::WaitFences' function */
+
+/* Wait for frame pacing (fences and frame limiter) function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::render::FrameWait( VOID )
+{
+  TSE_PROFILE("FrameWait");
+
+  auto start = std::chrono::steady_clock::now();
+
+  /* Do not let CPU run too far ahead of GPU */
+  if (IsRenderInit)
+  {
+    if (FramesInFlight < 1)
+      FramesInFlight = 1;
+    else if (FramesInFlight > MaxFramesInFlight)
+      FramesInFlight = MaxFramesInFlight;
+    WaitFences(IsLowLatency ? 1 : FramesInFlight);
+  }
+  auto end = std::chrono::steady_clock::now();
+  FrameStats.GPUWaitTime = std::chrono::duration<DBL, std::milli>(end - start).count();
+
+  /* Swap interval follows frame mode (vertical sync only in its own mode) */
+  if (INT interval = FrameMode == frame_mode::VSYNC ? 1 : 0; IsRenderInit && !IsHeadless && interval != SwapInterval)
+    SetSwapInterval(SwapInterval = interval);
+
+  /* Frame limiter: timer sleep, then spin for the last half millisecond */
+  if (FrameMode == frame_mode::CAPPED && MaxFPS > 0)
+  {
+    auto deadline = FrameStartTime +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<DBL>(1.0 / MaxFPS));
+    auto sleep = deadline - end - std::chrono::microseconds(500);
+    if (sleep > std::chrono::microseconds(0))
+    {
+#ifdef _WIN32
+      /* High resolution timer is not bound to system 15.6 ms tick */
+      if (hFrameTimer == nullptr)
+        hFrameTimer = CreateWaitableTimerEx(nullptr, nullptr,
+          CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+      if (hFrameTimer == nullptr)
+        hFrameTimer = CreateWaitableTimer(nullptr, TRUE, nullptr);
+      LARGE_INTEGER due {};
+      due.QuadPart = -std::chrono::duration_cast<std::chrono::nanoseconds>(sleep).count() / 100;
+      if (hFrameTimer != nullptr && SetWaitableTimer(hFrameTimer, &due, 0, nullptr, nullptr, FALSE))
+        WaitForSingleObject(hFrameTimer, INFINITE);
+#else
+      std::this_thread::sleep_for(sleep);
+#endif /* _WIN32 */
+    }
+    while (std::chrono::steady_clock::now() < deadline)
+      std::this_thread::yield();
+    end = std::chrono::steady_clock::now();
+  }
+  FrameStartTime = end;
+} /* End of 'tse::render::FrameWait' function */
+
 /* On frame render start function.
  * ARGUMENTS: None.
  * RETURNS: None.
  */
 VOID tse::render::FrameStart( VOID )
 {
+  TSE_PROFILE("FrameStart");
+
+  GPUProf.FrameStart();
+  GPUProf.Begin("Frame");
+
+  if (FrameFBO != 0)
+    glBindFramebuffer(GL_FRAMEBUFFER, FrameFBO);
+
+  GPUProf.Begin("Clear");
   FLT clear_color[4] {0.30, 0.47, 0.8, 1}, clear_depth = 1;
   glClearBufferfv(GL_COLOR, 0, clear_color);
   glClearBufferfv(GL_DEPTH, 0, &clear_depth);
+  GPUProf.End();
 
   shader_manager::Update();
+
+  /* Resources over budgets are evicted before this frame uses them */
+  resource::UseClock++;
+  texture_manager::Evict();
+  primitive_manager::Evict();
+  resource_loader::LoaderUpdate();
+  texture_manager::TexStreamUpdate();
  
   BUF_CAM bc
   {
@@ -208,10 +317,82 @@ VOID tse::render::FrameStart( VOID )
  */
 VOID tse::render::FrameEnd( VOID )
 {
-  glFinish();
-  SwapBuffers(hDC);
+  TSE_PROFILE("FrameEnd");
+  /* Batched text of the frame */
+  GPUProf.Begin("Text");
+  font_manager::Flush();
+  GPUProf.End();
+
+  FrameStats.CPUFrameTime =
+    std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - FrameStartTime).count();
+  GPUProf.End();
+  {
+    TSE_PROFILE("Present");
+    Present();
+  }
+
+  /* Fence this frame commands (slot is free: its frame was waited in 'FrameWait') */
+  auto &f = FrameFences[FrameNo % MaxFramesInFlight];
+  if (f.Sync != nullptr)
+    glDeleteSync(f.Sync);
+  f.Sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  f.FrameNo = FrameNo++;
+
+  auto now = std::chrono::steady_clock::now();
+  if (FrameNo == 1)
+  {
+    FirstFrameTime = std::chrono::duration<DBL, std::milli>(now - StartupTime).count();
+    tse::logger::Info(std::format("Time to first frame: {:.1f} ms", FirstFrameTime));
+  }
+  FrameStats.PresentTime = std::chrono::duration<DBL, std::milli>(now - LastPresentTime).count();
+  LastPresentTime = now;
 } /* End of 'tse::render::FrameEnd' function */
 
+/* Build resources memory usage report function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (std::string) report text (one manager per line).
+ */
+std::string tse::render::ResourcesReport( VOID )
+{
+  auto Line = []( const CHAR *Name, const auto &U )
+    {
+      return std::format("  {:<10} {:6} items, {:10.2f} MB{}, {} referenced, {} evicted ({} evictions, {} reloads)\n",
+        Name, U.Count, U.Bytes / 1048576.0,
+        U.Budget != 0 ? std::format(" of {:.2f} MB", U.Budget / 1048576.0) : "",
+        U.Referenced, U.Evicted, U.Evictions, U.Reloads);
+    };
+  return
+    Line("textures", texture_manager::Usage()) +
+    Line("primitives", primitive_manager::Usage()) +
+    Line("buffers", buffer_manager::Usage()) +
+    Line("materials", material_manager::Usage()) +
+    Line("fonts", font_manager::Usage());
+} /* End of 'tse::render::ResourcesReport' function */
+
+/* Read current frame pixels function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (image) frame image (top-down BGRA).
+ */
+tse::image tse::render::Screenshot( VOID )
+{
+  INT w = FrameFBO != 0 ? FrameW : Cam.FrameW, h = FrameFBO != 0 ? FrameH : Cam.FrameH;
+  std::vector<BYTE> pixels(w * h * 4);
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, FrameFBO);
+  if (FrameFBO == 0)
+    glReadBuffer(GL_BACK);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, w, h, GL_BGRA, GL_UNSIGNED_BYTE, pixels.data());
+
+  /* OpenGL rows go bottom-up */
+  image img(w, h);
+  for (INT y = 0; y < h; y++)
+    memcpy(img.RowsB[y], &pixels[(h - 1 - y) * w * 4], w * 4);
+  return img;
+} /* End of 'tse::render::Screenshot' function */
+
 /* Primitive draw function.
  * ARGUMENTS:
  *   - primitive pointer:
@@ -233,27 +414,32 @@ VOID tse::render::Draw( const prim *Pr, const matr &World )
     wvp = w * Cam.VP,
     invw = w.Inverse().Transpose();
  
-  Pr->UpdateVA();
- 
   BUF_PRIM bp =
   {
     wvp, w, invw, vec4(0, 0, 0, 0), {}
   };
 
+  Pr->Touch();
+  if (Pr->IsEvicted)
+    primitive_manager::PrimReload(Pr);
+
   material *Mtl = Pr->Mtl;
   if (Mtl == nullptr)
     Mtl = material_manager::Find("default");
-  Mtl->Apply();
+  shader *shd = Mtl->Apply();
  
   BufPrim->Update(&bp);
 
-  glBindVertexArray(Pr->VA);
+  glBindVertexArray(primitive_manager::VertexArray(Pr, shd));
+  if (Pr->VBuf != 0)
+    glBindVertexBuffer(0, Pr->VBuf, 0, Pr->VertexStride);
   if (Pr->IBuf == 0)
-    glDrawArrays(type, 0, Pr->NumOfElements);
+    glDrawArrays(type, Pr->FirstElement, Pr->NumOfElements);
   else
   {
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Pr->IBuf);
-    glDrawElements(type, Pr->NumOfElements, GL_UNSIGNED_INT, nullptr);
+    glDrawElements(type, Pr->NumOfElements, GL_UNSIGNED_INT,
+      reinterpret_cast<VOID *>((UINT_PTR)Pr->FirstElement * sizeof(INT)));
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
   }
   glBindVertexArray(0);
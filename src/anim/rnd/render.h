@@ -9,7 +9,7 @@
  *               Common definitions module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 03.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -25,12 +25,10 @@
 #include <wglew.h>
 #include <gl/wglext.h>
 
-#include "res/shd.h"
-#include "res/buf.h"
-#include "res/tex.h"
-#include "res/mtl.h"
-#include "res/prim.h"
-#include "res/fnt.h"
+/* Null (counting/recording) backend: must precede any OpenGL usage */
+#ifdef TSE_NULL_RENDER
+#include "gl_null.h"
+#endif /* TSE_NULL_RENDER */
 
 /* Main program namespace */
 namespace tse
@@ -43,11 +41,26 @@ namespace tse
     vec3 N; // Normal vector
     vec4 C; // Color
   }; /* End of 'vertex_std4' struct */
+} /* end of 'tse' namespace */
 
+#include "res/shd.h"
+#include "res/buf.h"
+#include "res/tex.h"
+#include "res/mtl.h"
+#include "res/prim.h"
+#include "res/fnt.h"
+#include "res/loader.h"
+#include "res/depgraph.h"
+
+#include "gpu_prof.h"
+
+/* Main program namespace */
+namespace tse
+{
   /* Render representation class */
   class render : public primitive_manager, public shader_manager,
     public material_manager, public buffer_manager, public texture_manager,
-    public font_manager
+    public font_manager, public resource_loader
   {
   private:
     HWND &hWndRef;     // Window handle reference
@@ -55,8 +68,59 @@ namespace tse
     HGLRC hGLRC;       // OpenGL rendering context handle
     BOOL IsRenderInit; // Initial flag
 
+    /* Headless (offscreen) rendering data */
+    BOOL IsHeadless = FALSE; // Headless mode flag
+    UINT
+      FrameFBO = 0,          // Offscreen frame buffer
+      FrameTexColor = 0,     // Offscreen color attachment texture
+      FrameRBDepth = 0;      // Offscreen depth attachment render buffer
+    INT FrameW = 0, FrameH = 0; // Offscreen frame buffer size
+
+    /* Frame pacing data */
+    static const INT MaxFramesInFlight = 3; // Maximum number of frames CPU may be ahead of GPU
+    struct
+    {
+      GLsync Sync;    // Frame commands completion fence
+      UINT64 FrameNo; // Fenced frame number
+    } FrameFences[MaxFramesInFlight] {};   // Frames in flight fences ring
+    UINT64 FrameNo = 0;                    // Submitted frames counter
+    std::chrono::steady_clock::time_point
+      FrameStartTime,                      // Current frame CPU work start time
+      LastPresentTime;                     // Previous frame present time
+    INT SwapInterval = -1;                 // Applied swap interval (-1 if not set yet)
+#ifdef _WIN32
+    HANDLE hFrameTimer = nullptr;          // Frame limiter high resolution waitable timer
+#endif /* _WIN32 */
+
   public:
-    camera Cam;        // Render camera
+    camera Cam;           // Render camera
+    gpu_profiler GPUProf; // GPU timer queries profiler
+
+    INT FramesInFlight = 2;    // Number of frames CPU may run ahead of GPU (1..3)
+    BOOL IsLowLatency = FALSE; // Low latency mode flag (CPU waits for previous frame before input)
+
+    /* Frame scheduling modes */
+    enum class frame_mode
+    {
+      UNCAPPED,  // Next frame right after previous one
+      CAPPED,    // Frame rate limited by 'MaxFPS' (high resolution timer sleep)
+      VSYNC,     // Present waits for display refresh (swap interval 1)
+      ON_DEMAND, // Frames only on window messages or 'Redraw' requests
+    };
+    frame_mode FrameMode = frame_mode::UNCAPPED; // Frame scheduling mode
+    DBL MaxFPS = 60;                             // Capped mode frame rate
+
+    // Render system creation time (startup time reference)
+    const std::chrono::steady_clock::time_point StartupTime = std::chrono::steady_clock::now();
+    DBL FirstFrameTime = 0;    // Time from startup to first frame present (ms)
+
+    /* Frame pacing statistics structure (all times in milliseconds) */
+    struct FRAME_STATS
+    {
+      DBL CPUFrameTime; // CPU time from frame start to present call
+      DBL GPUWaitTime;  // CPU time spent waiting for GPU fences
+      DBL PresentTime;  // Time between two consecutive presents
+    } FrameStats {};    // Last frame statistics
 
     /* Camera buffer transfer structure */
     struct BUF_CAM
@@ -109,6 +173,15 @@ namespace tse
      * RETURNS: None.
      */
     VOID Init( VOID );
+
+    /* Initialize headless (offscreen) rendering function.
+     * ARGUMENTS:
+     *   - frame buffer size:
+     *       INT W, H;
+     * RETURNS:
+     *   (BOOL) TRUE if success, FALSE otherwise.
+     */
+    BOOL InitHeadless( INT W, INT H );
  
     /* Deinitialize OpenGL function.
      * ARGUMENTS: None.
@@ -124,6 +197,12 @@ namespace tse
      */
     VOID Resize( INT NewW, INT NewH );
  
+    /* Wait for frame pacing (fences and frame limiter) function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID FrameWait( VOID );
+
     /* On frame render start function.
      * ARGUMENTS: None.
      * RETURNS: None.
@@ -136,6 +215,20 @@ namespace tse
      */
     VOID FrameEnd( VOID );
 
+    /* Read current frame pixels function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (image) frame image (top-down BGRA).
+     */
+    image Screenshot( VOID );
+
+    /* Build resources memory usage report function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (std::string) report text (one manager per line).
+     */
+    std::string ResourcesReport( VOID );
+
     /* Primitive draw function.
      * ARGUMENTS:
      *   - primitive pointer:
@@ -157,6 +250,58 @@ namespace tse
     VOID Draw( const model *Mdl, const matr &World = matr::Identity() );
 
   private:
+    /* Create platform rendering context function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (BOOL) TRUE if success, FALSE otherwise.
+     */
+    BOOL CreateContext( VOID );
+
+    /* Delete platform rendering context function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID DeleteContext( VOID );
+
+    /* Present frame function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Present( VOID );
+
+    /* Set platform swap interval function.
+     * ARGUMENTS:
+     *   - number of display refreshes per present (0 for immediate):
+     *       INT Interval;
+     * RETURNS: None.
+     */
+    VOID SetSwapInterval( INT Interval );
+
+    /* Create hidden context window for headless mode function.
+     * ARGUMENTS:
+     *   - window size:
+     *       INT W, H;
+     * RETURNS:
+     *   (BOOL) TRUE if success, FALSE otherwise.
+     */
+    BOOL CreateHeadlessWindow( INT W, INT H );
+
+    /* Resize offscreen frame buffer function.
+     * ARGUMENTS:
+     *   - new size:
+     *       INT NewW, NewH;
+     * RETURNS: None.
+     */
+    VOID FrameBufferResize( INT NewW, INT NewH );
+
+    /* Wait for frame fences function.
+     * ARGUMENTS:
+     *   - number of frames allowed to stay in flight:
+     *       INT InFlight;
+     * RETURNS: None.
+     */
+    VOID WaitFences( INT InFlight );
+
     /* Debug output function.
       * ARGUMENTS:
       *   - source APi or device:
@@ -0,0 +1,209 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : render_ctx.cpp
+ * PURPOSE     : Tough Space Exploration project.
+ *               Render system module.
+ *               Platform rendering context (WGL) module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Headless mode uses hidden window for WGL context.
+ *               'TSE_NULL_RENDER' builds create no context at all.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include "tse.h"
+
+#ifdef TSE_NULL_RENDER
+
+/* Create platform rendering context function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (BOOL) TRUE if success, FALSE otherwise.
+ */
+BOOL tse::render::CreateContext( VOID )
+{
+  tse::logger::Warn("Null render backend: OpenGL calls are only counted");
+  gl_null::Reset();
+  return TRUE;
+} /* End of 'tse::render::CreateContext' function */
+
+/* Delete platform rendering context function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::render::DeleteContext( VOID )
+{
+} /* End of 'tse::render::DeleteContext' function */
+
+/* Present frame function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::render::Present( VOID )
+{
+  gl_null::Record(gl_null::cmd::Present);
+} /* End of 'tse::render::Present' function */
+
+/* Set platform swap interval function.
+ * ARGUMENTS:
+ *   - number of display refreshes per present (0 for immediate):
+ *       INT Interval;
+ * RETURNS: None.
+ */
+VOID tse::render::SetSwapInterval( INT Interval )
+{
+} /* End of 'tse::render::SetSwapInterval' function */
+
+/* Create hidden context window for headless mode function.
+ * ARGUMENTS:
+ *   - window size:
+ *       INT W, H;
+ * RETURNS:
+ *   (BOOL) TRUE if success, FALSE otherwise.
+ */
+BOOL tse::render::CreateHeadlessWindow( INT W, INT H )
+{
+  return TRUE;
+} /* End of 'tse::render::CreateHeadlessWindow' function */
+
+#else /* TSE_NULL_RENDER */
+
+/* Create platform rendering context function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (BOOL) TRUE if success, FALSE otherwise.
+ */
+BOOL tse::render::CreateContext( VOID )
+{
+  PIXELFORMATDESCRIPTOR pfd = {0};
+  HGLRC hRC;
+  INT 
+    PixelAttribs[] =
+    {
+      WGL_DRAW_TO_WINDOW_ARB, TRUE,                    /* Window draw support */
+      WGL_SUPPORT_OPENGL_ARB, TRUE,                    /* OpenGL support */
+      WGL_DOUBLE_BUFFER_ARB, TRUE,                     /* Double buffering support */
+      WGL_PIXEL_TYPE_ARB, WGL_TYPE_RGBA_ARB,           /* Pixel format */
+      WGL_ACCELERATION_ARB, WGL_FULL_ACCELERATION_ARB, /* GPU max acceleration */
+      WGL_COLOR_BITS_ARB, 32,                          /* Color buffer bits count */
+      WGL_DEPTH_BITS_ARB, 32,                          /* Depth buffer bits count */
+      0                                                /* End of parameters */
+    },
+    ContextAttribs[] =
+    {
+      WGL_CONTEXT_MAJOR_VERSION_ARB, 4, /* Version */
+      WGL_CONTEXT_MINOR_VERSION_ARB, 6, /*   4.6   */
+      WGL_CONTEXT_PROFILE_MASK_ARB,     /* Compatibility handle */
+      WGL_CONTEXT_CORE_PROFILE_BIT_ARB, /* COMPATIBILITY / CORE */
+      0
+    };
+
+  if (ContextAttribs[5] == WGL_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB)
+  {
+    tse::logger::Warn("WGL_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB enabled!");
+    tse::logger::Warn("Consider switching to WGL_CONTEXT_CORE_PROFILE_BIT_ARB");
+  }
+
+  /* Prepare suitable device context */
+  hDC = GetDC(hWndRef);
+
+  /* OpenGL init: pixel format setup */
+  pfd.nSize = sizeof(PIXELFORMATDESCRIPTOR);
+  pfd.nVersion = 1;
+  pfd.dwFlags = PFD_DOUBLEBUFFER | PFD_SUPPORT_OPENGL;
+  pfd.cColorBits = 32;
+  pfd.cDepthBits = 32;
+  INT i = ChoosePixelFormat(hDC, &pfd);
+  DescribePixelFormat(hDC, i, sizeof(pfd), &pfd);
+  SetPixelFormat(hDC, i, &pfd);
+  tse::logger::LogLn("Pixel format: " + std::to_string(i));
+
+  /* OpenGL init: rendering context setup */
+  hGLRC = wglCreateContext(hDC);
+  wglMakeCurrent(hDC, hGLRC);
+
+  /* Glew initialization */
+  if (glewInit() != GLEW_OK || !(GLEW_ARB_vertex_shader && GLEW_ARB_fragment_shader))
+  {
+    tse::logger::Err("GLEW was not initialized!");
+    return FALSE;
+  }
+
+  /* Enable a new OpenGL profile support */
+  UINT nums;
+  wglChoosePixelFormatARB(hDC, PixelAttribs, NULL, 1, &i, &nums);
+  hRC = wglCreateContextAttribsARB(hDC, NULL, ContextAttribs);
+  wglMakeCurrent(NULL, NULL);
+  wglDeleteContext(hGLRC);
+  hGLRC = hRC;
+  wglMakeCurrent(hDC, hGLRC);
+
+  wglSwapIntervalEXT(0);
+
+  return TRUE;
+} /* End of 'tse::render::CreateContext' function */
+
+/* Delete platform rendering context function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::render::DeleteContext( VOID )
+{
+  wglMakeCurrent(NULL, NULL);
+  wglDeleteContext(hGLRC);
+  ReleaseDC(hWndRef, hDC);
+  if (IsHeadless)
+  {
+    DestroyWindow(hWndRef);
+    hWndRef = nullptr;
+  }
+} /* End of 'tse::render::DeleteContext' function */
+
+/* Present frame function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::render::Present( VOID )
+{
+  if (IsHeadless)
+    glFlush();
+  else
+    SwapBuffers(hDC);
+} /* End of 'tse::render::Present' function */
+
+/* Set platform swap interval function.
+ * ARGUMENTS:
+ *   - number of display refreshes per present (0 for immediate):
+ *       INT Interval;
+ * RETURNS: None.
+ */
+VOID tse::render::SetSwapInterval( INT Interval )
+{
+  if (WGLEW_EXT_swap_control)
+    wglSwapIntervalEXT(Interval);
+} /* End of 'tse::render::SetSwapInterval' function */
+
+/* Create hidden context window for headless mode function.
+ * ARGUMENTS:
+ *   - window size:
+ *       INT W, H;
+ * RETURNS:
+ *   (BOOL) TRUE if success, FALSE otherwise.
+ */
+BOOL tse::render::CreateHeadlessWindow( INT W, INT H )
+{
+  /* Never shown: used only as pixel format holder for WGL */
+  hWndRef = CreateWindow("STATIC", "", WS_POPUP, 0, 0, W, H,
+    nullptr, nullptr, GetModuleHandle(nullptr), nullptr);
+  return hWndRef != nullptr;
+} /* End of 'tse::render::CreateHeadlessWindow' function */
+
+#endif /* TSE_NULL_RENDER */
+
+/* END OF 'render_ctx.cpp' FILE */
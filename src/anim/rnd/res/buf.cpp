@@ -9,7 +9,7 @@
  *               Buffers implementation module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 03.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -29,6 +29,7 @@
 VOID tse::buffer::Free( VOID )
 {
   glDeleteBuffers(1, &BufId);
+  BufId = 0;
 } /* End of 'tse::buffer::Free' function */
 
 /* Apply buffer function.
@@ -37,6 +38,7 @@ VOID tse::buffer::Free( VOID )
  */
 VOID tse::buffer::Apply( VOID )
 {
+  Touch();
   if (BufId != 0)
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BindingPoint, BufId);
 } /* End of 'tse::buffer::Apply' function */
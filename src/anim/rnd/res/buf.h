@@ -9,7 +9,7 @@
  *               Buffers declaration module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 03.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -60,8 +60,9 @@ namespace tse
         glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(data_type), Data,
                      GL_DYNAMIC_DRAW);
         glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        MemSize = BufSize;
         Apply();
-        tse::logger::Info(std::format("BUFFER created: binding = {}, {} bytes", BindingPoint, sizeof(data_type)));
+        TSE_LOGF(DBG, "BUFFER created: binding = {}, {} bytes", BindingPoint, sizeof(data_type));
         return *this;
       } /* End of 'Create' function */
  
@@ -91,6 +92,7 @@ namespace tse
         glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(data_type) * NumOfElements,
                      Data, GL_DYNAMIC_COPY);
         glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        MemSize = BufSize;
         Apply();
         return *this;
       } /* End of 'Create' function */
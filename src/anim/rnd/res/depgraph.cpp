@@ -0,0 +1,463 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : depgraph.cpp
+ * PURPOSE     : Tough Space Exploration project.
+ *               Render resources module.
+ *               Resources dependency graph module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include "tse.h"
+
+/* Class constructor.
+ * ARGUMENTS:
+ *   - render to create resources at:
+ *       render &NewRnd;
+ */
+tse::resource_graph::resource_graph( render &NewRnd ) : Rnd(NewRnd)
+{
+} /* End of 'tse::resource_graph::resource_graph' function */
+
+/* Class destructor (resources stay alive until 'Clear') */
+tse::resource_graph::~resource_graph( VOID )
+{
+} /* End of 'tse::resource_graph::~resource_graph' function */
+
+/* Add resource with its implicit dependencies function.
+ * ARGUMENTS:
+ *   - resource kind:
+ *       res_kind Kind;
+ *   - resource name:
+ *       const std::string &Name;
+ *   - dependencies (nodes indices):
+ *       const std::vector<INT> &Deps;
+ * RETURNS:
+ *   (INT) node index (same for same kind and name).
+ */
+INT tse::resource_graph::Add( res_kind Kind, const std::string &Name, const std::vector<INT> &Deps )
+{
+  std::vector<INT> deps = Deps;
+
+  /* Models and primitives materials use default shader, fonts own one */
+  if (Kind == res_kind::PRIM || Kind == res_kind::MODEL)
+    deps.push_back(Add(res_kind::SHADER, "default"));
+  else if (Kind == res_kind::FONT)
+    deps.push_back(Add(res_kind::SHADER, Rnd.IsFontSDF ? "font_sdf" : "font"));
+
+  NumOfRefs++;
+  auto [it, is_new] = Index.emplace(std::pair(Kind, Name), (INT)Nodes.size());
+  if (is_new)
+  {
+    NODE &node = Nodes.emplace_back();
+    node.Kind = Kind;
+    node.Name = Name;
+  }
+  INT index = it->second;
+  NODE &node = Nodes[index];
+  for (INT d : deps)
+    if (d != index && std::find(node.Deps.begin(), node.Deps.end(), d) == node.Deps.end())
+    {
+      node.Deps.push_back(d);
+      Nodes[d].Next.push_back(index);
+    }
+  return index;
+} /* End of 'tse::resource_graph::Add' function */
+
+/* Add material with shader and textures function.
+ * ARGUMENTS:
+ *   - material name:
+ *       const std::string &Name;
+ *   - shader file name prefix (empty for default):
+ *       const std::string &Shader;
+ *   - textures file names:
+ *       const std::vector<std::string> &Textures;
+ * RETURNS:
+ *   (INT) node index.
+ */
+INT tse::resource_graph::AddMaterial( const std::string &Name, const std::string &Shader,
+                                      const std::vector<std::string> &Textures )
+{
+  std::vector<INT> deps {Add(res_kind::SHADER, Shader.empty() ? "default" : Shader)};
+
+  for (auto &tex : Textures)
+    deps.push_back(Add(res_kind::TEXTURE, tex));
+  return Add(res_kind::MATERIAL, Name, deps);
+} /* End of 'tse::resource_graph::AddMaterial' function */
+
+/* Load scene manifest function.
+ * ARGUMENTS:
+ *   - manifest file name:
+ *       const std::string &FileName;
+ * RETURNS:
+ *   (BOOL) TRUE if success.
+ */
+BOOL tse::resource_graph::LoadManifest( const std::string &FileName )
+{
+  static const std::map<std::string, res_kind> kinds
+  {
+    {"shader", res_kind::SHADER},
+    {"texture", res_kind::TEXTURE},
+    {"prim", res_kind::PRIM},
+    {"model", res_kind::MODEL},
+    {"font", res_kind::FONT},
+  };
+
+  if (!vfs::Exists(FileName))
+  {
+    tse::logger::Warn("MANIFEST not found: " + FileName);
+    return FALSE;
+  }
+
+  BOOL is_ok = TRUE;
+  std::string line;
+  std::istringstream f(vfs::ReadText(FileName));
+  for (INT line_no = 1; std::getline(f, line); line_no++)
+  {
+    if (SIZE_T comment = line.find('#'); comment != std::string::npos)
+      line.resize(comment);
+    std::istringstream words(line);
+    std::string kind, name;
+    if (!(words >> kind))
+      continue;
+    if (!(words >> name))
+    {
+      tse::logger::Warn(std::format("MANIFEST {}({}): no resource name", FileName, line_no));
+      is_ok = FALSE;
+      continue;
+    }
+
+    if (kind == "material")
+    {
+      std::string key, value, shader;
+      std::vector<std::string> textures;
+      while (words >> key >> value)
+        if (key == "shader")
+          shader = value;
+        else if (key == "texture")
+          textures.push_back(value);
+        else
+        {
+          tse::logger::Warn(std::format("MANIFEST {}({}): unknown material field '{}'", FileName, line_no, key));
+          is_ok = FALSE;
+        }
+      AddMaterial(name, shader, textures);
+    }
+    else if (auto k = kinds.find(kind); k != kinds.end())
+      Add(k->second, name);
+    else
+    {
+      tse::logger::Warn(std::format("MANIFEST {}({}): unknown resource kind '{}'", FileName, line_no, kind));
+      is_ok = FALSE;
+    }
+  }
+  return is_ok;
+} /* End of 'tse::resource_graph::LoadManifest' function */
+
+/* Reading stage (any thread) function.
+ * ARGUMENTS:
+ *   - node:
+ *       NODE &Node;
+ * RETURNS: None.
+ */
+VOID tse::resource_graph::Read( NODE &Node )
+{
+  TSE_PROFILE("WarmupRead");
+  auto start = std::chrono::steady_clock::now();
+
+  switch (Node.Kind)
+  {
+  case res_kind::TEXTURE:
+    {
+#ifdef _WIN32
+      /* Image decoding uses COM (job workers are never initialized otherwise) */
+      [[maybe_unused]] static thread_local HRESULT com = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif /* _WIN32 */
+      image img(Node.Name);
+      Node.IsOk = img.W > 0 && img.H > 0;
+      if (Node.IsOk)
+        Node.Mips = texture::BuildMips(img.W, img.H, 4, img.RowsB[0][0]);
+    }
+    break;
+  case res_kind::PRIM:
+    Node.IsOk = prim::Parse(Node.Name, matr::Identity(), Node.V, Node.Ind);
+    break;
+  case res_kind::MODEL:
+    Node.IsOk = model::Decode(Node.Name, matr::Identity(), vec3(1, 0, 0), Node.ModelData);
+    break;
+  case res_kind::FONT:
+    Node.IsOk = font::Read(Node.Name, Node.Mem);
+    break;
+  default:
+    /* Shaders and materials have nothing to read ahead */
+    Node.IsOk = TRUE;
+    break;
+  }
+  Node.ReadTime = std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - start).count();
+} /* End of 'tse::resource_graph::Read' function */
+
+/* Creation stage (render thread) function.
+ * ARGUMENTS:
+ *   - node:
+ *       NODE &Node;
+ * RETURNS: None.
+ */
+VOID tse::resource_graph::Create( NODE &Node )
+{
+  TSE_PROFILE("WarmupCreate");
+  auto start = std::chrono::steady_clock::now();
+
+  if (Node.IsOk)
+    switch (Node.Kind)
+    {
+    case res_kind::SHADER:
+      Node.Res = Rnd.ShdCreate(Node.Name);
+      break;
+    case res_kind::TEXTURE:
+      {
+        texture *tex = Rnd.TexCreate(Node.Name, Node.Mips);
+        tex->Source = Node.Name;
+        Node.Res = tex;
+      }
+      break;
+    case res_kind::MATERIAL:
+      {
+        /* Dependencies are shader and textures in declaration order */
+        material *mtl = Rnd.MtlCreate(Node.Name);
+        INT t = 0;
+        for (INT d : Node.Deps)
+          if (Nodes[d].Kind == res_kind::SHADER)
+            mtl->Shd = static_cast<shader *>(Nodes[d].Res);
+          else if (Nodes[d].Kind == res_kind::TEXTURE && t < 8)
+            mtl->Tex[t++] = static_cast<texture *>(Nodes[d].Res);
+        mtl->Update();
+        Node.Res = mtl;
+      }
+      break;
+    case res_kind::PRIM:
+      Node.Res = Rnd.PrimCreate(Node.Name, matr::Identity(), Node.V, Node.Ind);
+      break;
+    case res_kind::MODEL:
+      Node.Mdl = std::make_unique<model>();
+      while (!Node.Mdl->Upload(Node.ModelData))
+        ;
+      break;
+    case res_kind::FONT:
+      Node.Res = Rnd.FntCreate(Node.Name, Node.Mem);
+      break;
+    }
+  Node.IsOwned = Node.Res != nullptr || Node.Mdl != nullptr;
+  Node.IsOk = Node.IsOwned;
+
+  /* Decoded data is not needed anymore */
+  Node.Mips = {};
+  Node.ModelData = {};
+  Node.V = {};
+  Node.Ind = {};
+  Node.Mem = {};
+  Node.CreateTime = std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - start).count();
+} /* End of 'tse::resource_graph::Create' function */
+
+/* Load all resources (render thread) function.
+ * ARGUMENTS:
+ *   - job system to read on:
+ *       job_system &Jobs;
+ *   - parallel loading flag (FALSE for all stages in order on calling thread):
+ *       BOOL IsParallel;
+ * RETURNS:
+ *   (WARMUP_STATS) loading statistics.
+ */
+tse::resource_graph::WARMUP_STATS tse::resource_graph::Warmup( job_system &Jobs, BOOL IsParallel )
+{
+  TSE_PROFILE("Warmup");
+  auto start = std::chrono::steady_clock::now();
+  WARMUP_STATS st;
+  st.Nodes = (INT)Nodes.size();
+  st.Refs = NumOfRefs;
+
+  /* Loaded resources and ones already present in managers are not loaded again */
+  for (auto &node : Nodes)
+  {
+    node.Remaining = (INT)node.Deps.size();
+    node.ReadTime = node.CreateTime = node.Finish = 0;
+    node.Prev = -1;
+    if (node.Res == nullptr && node.Mdl == nullptr)
+      switch (node.Kind)
+      {
+      case res_kind::SHADER:
+        node.Res = Rnd.shader_manager::Find(node.Name);
+        break;
+      case res_kind::TEXTURE:
+        node.Res = Rnd.texture_manager::Find(node.Name);
+        break;
+      case res_kind::MATERIAL:
+        node.Res = Rnd.material_manager::Find(node.Name);
+        break;
+      }
+    node.IsRead = node.Res != nullptr || node.Mdl != nullptr;
+    node.IsOk = node.IsRead;
+    st.Existing += node.IsRead;
+  }
+
+  /* All reading stages start at once, creation follows dependencies */
+  job_system::counter cnt {0};
+  std::deque<INT> ready;
+  ReadDone.clear();
+  for (INT i = 0; i < (INT)Nodes.size(); i++)
+  {
+    if (IsParallel && !Nodes[i].IsRead)
+      Jobs.Spawn(cnt, [this, i]( VOID )
+        {
+          Read(Nodes[i]);
+          std::lock_guard<std::mutex> lock(ReadLock);
+          ReadDone.push_back(i);
+        });
+    if (Nodes[i].Remaining == 0 && (Nodes[i].IsRead || !IsParallel))
+      ready.push_back(i);
+  }
+
+  for (INT done = 0; done < (INT)Nodes.size(); done++)
+  {
+    while (ready.empty())
+    {
+      std::vector<INT> read;
+      {
+        std::lock_guard<std::mutex> lock(ReadLock);
+        read.swap(ReadDone);
+      }
+      for (INT i : read)
+      {
+        Nodes[i].IsRead = TRUE;
+        if (Nodes[i].Remaining == 0)
+          ready.push_back(i);
+      }
+      if (ready.empty())
+        std::this_thread::yield();
+    }
+
+    NODE &node = Nodes[ready.front()];
+    ready.pop_front();
+    if (!node.IsRead)
+    {
+      Read(node);
+      node.IsRead = TRUE;
+    }
+    if (node.Res == nullptr && node.Mdl == nullptr)
+    {
+      Create(node);
+      st.Failed += !node.IsOk;
+    }
+
+    /* Node is complete after own reading and dependencies creation */
+    node.Finish = node.ReadTime;
+    for (INT d : node.Deps)
+      if (Nodes[d].Finish > node.Finish)
+      {
+        node.Finish = Nodes[d].Finish;
+        node.Prev = d;
+      }
+    node.Finish += node.CreateTime;
+
+    for (INT n : node.Next)
+      if (--Nodes[n].Remaining == 0 && (Nodes[n].IsRead || !IsParallel))
+        ready.push_back(n);
+  }
+  Jobs.Wait(cnt);
+
+  /* Shaders are compiled by driver in background */
+  auto shader_start = std::chrono::steady_clock::now();
+  Rnd.shader_manager::WaitAll();
+  st.ShaderWait = std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - shader_start).count();
+
+  INT last = -1;
+  for (INT i = 0; i < (INT)Nodes.size(); i++)
+  {
+    st.ReadTime += Nodes[i].ReadTime;
+    st.CreateTime += Nodes[i].CreateTime;
+    if (last == -1 || Nodes[i].Finish > Nodes[last].Finish)
+      last = i;
+  }
+  st.SerialTime = st.ReadTime + st.CreateTime;
+  for (INT i = last; i != -1; i = Nodes[i].Prev)
+    st.Path.insert(st.Path.begin(), Nodes[i].Name);
+  st.CriticalPath = last != -1 ? Nodes[last].Finish : 0;
+  st.WallTime = std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - start).count();
+  return st;
+} /* End of 'tse::resource_graph::Warmup' function */
+
+/* Free resources created by graph function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::resource_graph::Clear( VOID )
+{
+  /* Dependents are freed first */
+  for (INT i = (INT)Nodes.size() - 1; i >= 0; i--)
+  {
+    NODE &node = Nodes[i];
+    if (node.IsOwned)
+      switch (node.Kind)
+      {
+      case res_kind::TEXTURE:
+        Rnd.texture_manager::Delete(static_cast<texture *>(node.Res));
+        break;
+      case res_kind::MATERIAL:
+        Rnd.material_manager::Delete(static_cast<material *>(node.Res));
+        break;
+      case res_kind::PRIM:
+        Rnd.PrimFree(static_cast<prim *>(node.Res));
+        break;
+      case res_kind::MODEL:
+        for (auto *pr : node.Mdl->Prims)
+          Rnd.PrimFree(pr);
+        node.Mdl.reset();
+        break;
+      case res_kind::FONT:
+        Rnd.font_manager::Delete(static_cast<font *>(node.Res));
+        break;
+      default:
+        /* Shaders are shared with variants cache, they stay in manager */
+        break;
+      }
+    node.Res = nullptr;
+    node.IsOwned = FALSE;
+  }
+} /* End of 'tse::resource_graph::Clear' function */
+
+/* Find loaded resource function.
+ * ARGUMENTS:
+ *   - resource kind:
+ *       res_kind Kind;
+ *   - resource name:
+ *       const std::string &Name;
+ * RETURNS:
+ *   (resource *) resource (nullptr if not found or not loaded).
+ */
+tse::resource * tse::resource_graph::Find( res_kind Kind, const std::string &Name ) const
+{
+  auto it = Index.find(std::pair(Kind, Name));
+  return it != Index.end() ? Nodes[it->second].Res : nullptr;
+} /* End of 'tse::resource_graph::Find' function */
+
+/* Find loaded model function.
+ * ARGUMENTS:
+ *   - model file name:
+ *       const std::string &Name;
+ * RETURNS:
+ *   (model *) model (nullptr if not found or not loaded).
+ */
+tse::model * tse::resource_graph::FindModel( const std::string &Name ) const
+{
+  auto it = Index.find(std::pair(res_kind::MODEL, Name));
+  return it != Index.end() ? Nodes[it->second].Mdl.get() : nullptr;
+} /* End of 'tse::resource_graph::FindModel' function */
+
+/* END OF 'depgraph.cpp' FILE */
@@ -0,0 +1,224 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : depgraph.h
+ * PURPOSE     : Tough Space Exploration project.
+ *               Render resources module.
+ *               Resources dependency graph declaration module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __depgraph_h_
+#define __depgraph_h_
+
+/* Main program namespace */
+namespace tse
+{
+  /* Forward declarations */
+  class render;
+  class job_system;
+
+  /* Resource kinds enumeration */
+  enum struct res_kind
+  {
+    SHADER,   // Shader (by file name prefix)
+    TEXTURE,  // Texture (by image file name)
+    MATERIAL, // Material (by name, shader and textures are dependencies)
+    PRIM,     // Primitive (by *.OBJ file name)
+    MODEL,    // Model (by *.G3DM file name)
+    FONT,     // Font (by *.G3DF file name)
+  }; /* End of 'res_kind' enum */
+
+  /* Resources dependency graph class.
+   * Node is resource (kind and name), shared dependencies are added once.
+   * Node is loaded in two stages: reading (file I/O and decoding) on job
+   * system workers, all nodes at once, and creation on render thread as
+   * soon as node is read and all its dependencies are created. Resources
+   * already present in managers are used as is. */
+  class resource_graph
+  {
+  public:
+    /* Warm-up statistics structure (times in milliseconds) */
+    struct WARMUP_STATS
+    {
+      INT Nodes = 0;                 // Number of resources
+      INT Refs = 0;                  // Number of references to resources (before deduplication)
+      INT Existing = 0;              // Resources found in managers (not loaded)
+      INT Failed = 0;                // Failed resources
+      DBL ReadTime = 0;              // Reading stages total time
+      DBL CreateTime = 0;            // Creation stages total time
+      DBL SerialTime = 0;            // All stages one after another
+      DBL CriticalPath = 0;          // Longest dependencies chain time
+      DBL ShaderWait = 0;            // Shaders compilation wait after creation
+      DBL WallTime = 0;              // Real warm-up time
+      std::vector<std::string> Path; // Critical path nodes (first is loaded first)
+    }; /* End of 'WARMUP_STATS' structure */
+
+  private:
+    /* Graph node structure */
+    struct NODE
+    {
+      res_kind Kind;                     // Resource kind
+      std::string Name;                  // Resource name
+      std::vector<INT> Deps;             // Resources to be created before this one
+      std::vector<INT> Next;             // Resources depending on this one
+      resource *Res {};                  // Created (or found) resource
+      std::unique_ptr<model> Mdl;        // Created model
+      BOOL IsOwned = FALSE;              // Resource is created by graph
+      BOOL IsOk = FALSE;                 // Reading success flag
+
+      /* Decoded data (by kind, released after creation) */
+      texture::MIPS Mips;                // Texture mip levels
+      model::LOAD_DATA ModelData;        // Model data
+      std::vector<vertex_std4> V;        // Primitive vertices
+      std::vector<INT> Ind;              // Primitive indices
+      std::vector<BYTE> Mem;             // Font file
+
+      /* Scheduling */
+      INT Remaining = 0;                 // Not created dependencies
+      BOOL IsRead = FALSE;               // Reading stage completion flag (render thread copy)
+      DBL ReadTime = 0, CreateTime = 0;  // Stages times
+      DBL Finish = 0;                    // Critical path time to node creation end
+      INT Prev = -1;                     // Critical path previous node (-1 if reading is longer)
+    }; /* End of 'NODE' structure */
+
+    render &Rnd;                                      // Render to create resources at
+    std::deque<NODE> Nodes;                           // Nodes (dependencies precede dependents)
+    std::map<std::pair<res_kind, std::string>, INT> Index; // Nodes by kind and name
+    INT NumOfRefs = 0;                                // Number of references
+
+    std::mutex ReadLock;                              // Read nodes queue lock
+    std::vector<INT> ReadDone;                        // Nodes read by workers
+
+    /* Reading stage (any thread) function.
+     * ARGUMENTS:
+     *   - node:
+     *       NODE &Node;
+     * RETURNS: None.
+     */
+    VOID Read( NODE &Node );
+
+    /* Creation stage (render thread) function.
+     * ARGUMENTS:
+     *   - node:
+     *       NODE &Node;
+     * RETURNS: None.
+     */
+    VOID Create( NODE &Node );
+
+  public:
+    /* Class constructor.
+     * ARGUMENTS:
+     *   - render to create resources at:
+     *       render &NewRnd;
+     */
+    resource_graph( render &NewRnd );
+
+    /* Class destructor (resources stay alive until 'Clear') */
+    ~resource_graph( VOID );
+
+    /* Add resource with its implicit dependencies function.
+     * ARGUMENTS:
+     *   - resource kind:
+     *       res_kind Kind;
+     *   - resource name:
+     *       const std::string &Name;
+     *   - dependencies (nodes indices):
+     *       const std::vector<INT> &Deps;
+     * RETURNS:
+     *   (INT) node index (same for same kind and name).
+     */
+    INT Add( res_kind Kind, const std::string &Name, const std::vector<INT> &Deps = {} );
+
+    /* Add material with shader and textures function.
+     * ARGUMENTS:
+     *   - material name:
+     *       const std::string &Name;
+     *   - shader file name prefix (empty for default):
+     *       const std::string &Shader;
+     *   - textures file names:
+     *       const std::vector<std::string> &Textures;
+     * RETURNS:
+     *   (INT) node index.
+     */
+    INT AddMaterial( const std::string &Name, const std::string &Shader,
+                     const std::vector<std::string> &Textures );
+
+    /* Load scene manifest function.
+     * Line per resource, '#' starts comment:
+     *   shader <prefix>
+     *   texture <file>
+     *   material <name> [shader <prefix>] [texture <file>]...
+     *   prim <file.obj>
+     *   model <file.g3dm>
+     *   font <file.g3df>
+     * ARGUMENTS:
+     *   - manifest file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if success.
+     */
+    BOOL LoadManifest( const std::string &FileName );
+
+    /* Load all resources (render thread) function.
+     * ARGUMENTS:
+     *   - job system to read on:
+     *       job_system &Jobs;
+     *   - parallel loading flag (FALSE for all stages in order on calling thread):
+     *       BOOL IsParallel;
+     * RETURNS:
+     *   (WARMUP_STATS) loading statistics.
+     */
+    WARMUP_STATS Warmup( job_system &Jobs, BOOL IsParallel = TRUE );
+
+    /* Free resources created by graph function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Clear( VOID );
+
+    /* Find loaded resource function.
+     * ARGUMENTS:
+     *   - resource kind:
+     *       res_kind Kind;
+     *   - resource name:
+     *       const std::string &Name;
+     * RETURNS:
+     *   (resource *) resource (nullptr if not found or not loaded).
+     */
+    resource * Find( res_kind Kind, const std::string &Name ) const;
+
+    /* Find loaded model function.
+     * ARGUMENTS:
+     *   - model file name:
+     *       const std::string &Name;
+     * RETURNS:
+     *   (model *) model (nullptr if not found or not loaded).
+     */
+    model * FindModel( const std::string &Name ) const;
+
+    /* Obtain number of resources function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) number of nodes.
+     */
+    INT NumOfNodes( VOID ) const
+    {
+      return (INT)Nodes.size();
+    } /* End of 'NumOfNodes' function */
+
+  }; /* End of 'resource_graph' class */
+
+} /* end of 'tse' namespace */
+
+#endif /* __depgraph_h_ */
+
+/* END OF 'depgraph.h' FILE */
@@ -9,7 +9,7 @@
  *               Fonts implementation module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 04.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -42,25 +42,55 @@ tse::font::~font( VOID )
 {
 } /* End of 'tse::font::~font' function */
 
-/* Class constructor function.
+/* Load font from file function.
  * ARGUMENTS:
  *   - font file name:
  *       const std::string &FileName;
+ * RETURNS:
+ *   (font &) self reference.
  */
 tse::font & tse::font::Load( const std::string &FileName )
 {
-  std::fstream f(FileName, std::fstream::in | std::fstream::binary);
-  if (!f.is_open())
+  TSE_PROFILE("FontLoad");
+
+  std::vector<BYTE> mem;
+  if (!Read(FileName, mem))
     return *this;
+  return Create(FileName, mem);
+} /* End of 'tse::font::Load' function */
+
+/* Read font file (any thread) function.
+ * ARGUMENTS:
+ *   - font file name:
+ *       const std::string &FileName;
+ *   - file data:
+ *       std::vector<BYTE> &Mem;
+ * RETURNS:
+ *   (BOOL) TRUE if file is G3DF font.
+ */
+BOOL tse::font::Read( const std::string &FileName, std::vector<BYTE> &Mem )
+{
+  if (!vfs::Read(FileName, Mem))
+    return FALSE;
+  return Mem.size() > 4 && *(DWORD *)Mem.data() == *(DWORD *)"G3DF";
+} /* End of 'tse::font::Read' function */
 
-  f.seekg(0, std::fstream::end);
-  SIZE_T flen = f.tellg();
-  f.seekg(0, std::fstream::beg);
+/* Create font from file data (render thread) function.
+ * ARGUMENTS:
+ *   - font file name:
+ *       const std::string &FileName;
+ *   - file data:
+ *       std::vector<BYTE> &Mem;
+ * RETURNS:
+ *   (font &) self reference.
+ */
+tse::font & tse::font::Create( const std::string &FileName, std::vector<BYTE> &Mem )
+{
+  TSE_PROFILE("FontCreate");
 
-  std::vector<BYTE> mem;
-  mem.resize(flen);
-  f.read((CHAR *)mem.data(), flen);
-  BYTE *ptr = mem.data();
+  if (Mem.size() < sizeof(DWORD))
+    return *this;
+  BYTE *ptr = Mem.data();
 
   rdr rd(ptr);
 
@@ -69,6 +99,8 @@ tse::font & tse::font::Load( const std::string &FileName )
   rd(&sign);
   if (sign != *(DWORD *)"G3DF")
     return *this;
+  /* Reload: previous batch primitive is replaced */
+  Free();
 
   /* Load storage info */
   rd(&LineH);
@@ -86,59 +118,151 @@ tse::font & tse::font::Load( const std::string &FileName )
   DWORD *Img = new DWORD[W * H];
   rd(Img, W * H);
 
-  /* Create primitives */
-  Mtl = anim::Get().MtlCreate(FileName);
-  Mtl->Tex[0] = anim::Get().TexCreate(FileName, W, H, 4,
-    reinterpret_cast<BYTE *>(Img));
+  Glyphs.assign(V, V + 256 * 4);
+
+  /* Create material: scalable distance field atlas or original bitmap */
+  if (!anim::Get().IsFontSDF || !CreateSDF(FileName, Img, W, H))
+  {
+    Mtl = anim::Get().MtlCreate(FileName);
+    Mtl->Tex[0] = anim::Get().TexCreate(FileName, W, H, 4,
+      reinterpret_cast<BYTE *>(Img));
+    Mtl->Shd = anim::Get().shader_manager::Find("font");
+    if (Mtl->Shd == nullptr)
+      Mtl->Shd = anim::Get().ShdCreate("font");
+  }
   delete[] Img;
-  Mtl->Shd = anim::Get().shader_manager::Find("font");
-  if (Mtl->Shd == nullptr)
-    Mtl->Shd = anim::Get().ShdCreate("font");
 
-  for (INT i = 0; i < 256; i++)
-    Chars[i] = anim::Get().PrimCreate(Mtl, prim_type::STRIP,
-      std::span(V + i * 4, 4), {});
+  /* Characters quads are built on CPU and drawn by one streaming primitive */
+  std::vector<vertex_std4> dummy(6);
+  Batch = anim::Get().PrimCreate<vertex_std4>(Mtl, prim_type::TRIMESH, dummy, {});
 
   tse::logger::Info("FONT loaded: " + FileName);
   return *this;
-} /* End of 'tse::font::Load' function */
+} /* End of 'tse::font::Create' function */
 
-/* Draw font function.
+/* Build string glyphs quads function.
  * ARGUMENTS:
- *   - font text to draw:
+ *   - font text:
  *       const std::string &Str;
- *   - draw position:
- *       vec3 Pos;
  *   - font size:
  *       FLT Size;
+ *   - vertices to append to (2 triangles per glyph, relative to text origin):
+ *       std::vector<vertex_std4> &V;
  * RETURNS: None.
  */
-VOID tse::font::Draw( const std::string &Str, vec3 Pos, FLT Size )
+VOID tse::font::Layout( const std::string &Str, FLT Size, std::vector<vertex_std4> &V ) const
 {
-  FLT startx = Pos.X;
+  FLT x = 0, y = 0;
 
-  for (INT i = 0; i < Str.length(); i++)
-  {
-    UCHAR chr = Str[i];
+  for (UCHAR chr : Str)
     if (chr == '\n')
     {
-      Pos.X = startx;
-      Pos.Y -= Size;
+      x = 0;
+      y -= Size;
     }
     else
     {
-      anim::Get().Draw(Chars[chr], matr::Scale(Size, Size, 1) * matr::Translate(Pos));
-      Pos.X += AdvanceX[chr] * Size;
+      if (AdvanceX[chr] != 0)
+      {
+        /* Strip quad (0, 1, 2, 3) -> triangles (0, 1, 2), (2, 1, 3) */
+        const vertex_std4 *g = &Glyphs[chr * 4];
+        for (INT i : {0, 1, 2, 2, 1, 3})
+        {
+          vertex_std4 v = g[i];
+          v.P = vec3(v.P.X * Size + x, v.P.Y * Size + y, v.P.Z);
+          V.push_back(v);
+        }
+      }
+      x += AdvanceX[chr] * Size;
+    }
+} /* End of 'tse::font::Layout' function */
+
+/* Draw font function (text is batched and drawn on 'Flush').
+ * ARGUMENTS:
+ *   - font text to draw:
+ *       const std::string &Str;
+ *   - draw position:
+ *       vec3 Pos;
+ *   - font size:
+ *       FLT Size;
+ *   - static string flag (layout is cached between frames):
+ *       BOOL IsStatic;
+ * RETURNS: None.
+ */
+VOID tse::font::Draw( const std::string &Str, vec3 Pos, FLT Size, BOOL IsStatic )
+{
+  if (Batch == nullptr)
+    return;
+
+  /* Obtain string layout */
+  const std::vector<vertex_std4> *lay = &LayoutV;
+  if (IsStatic)
+  {
+    auto key = std::make_pair(Str, Size);
+    auto c = Cache.find(key);
+    if (c == Cache.end())
+    {
+      if (Cache.size() >= MaxCached)
+        Cache.clear();
+      c = Cache.emplace(key, std::vector<vertex_std4>()).first;
+      Layout(Str, Size, c->second);
     }
+    lay = &c->second;
+  }
+  else
+  {
+    LayoutV.clear();
+    Layout(Str, Size, LayoutV);
+  }
+
+  /* New segment on camera change */
+  const matr &vp = anim::Get().Cam.VP;
+  if (Segments.empty() || memcmp(Segments.back().VP.M, vp.M, sizeof(vp.M)) != 0)
+    Segments.push_back({vp, (INT)BatchV.size(), 0});
+  Segments.back().Count += (INT)lay->size();
+
+  for (auto v : *lay)
+  {
+    v.P += Pos;
+    BatchV.push_back(v);
   }
 } /* End of 'tse::font::Draw' function */
 
+/* Draw batched text function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::font::Flush( VOID )
+{
+  if (BatchV.empty())
+    return;
+
+  anim &ani = anim::Get();
+  Batch->Update<vertex_std4>(BatchV);
+  matr save_vp = ani.Cam.VP;
+  for (auto &seg : Segments)
+  {
+    ani.Cam.VP = seg.VP;
+    Batch->SetDrawRange(seg.First, seg.Count);
+    ani.Draw(Batch);
+  }
+  ani.Cam.VP = save_vp;
+  BatchV.clear();
+  Segments.clear();
+} /* End of 'tse::font::Flush' function */
+
 /* Free font function.
  * ARGUMENTS: None.
  * RETURNS: None.
  */
 VOID tse::font::Free( VOID )
 {
+  if (Batch != nullptr)
+    anim::Get().render::PrimFree(Batch), Batch = nullptr;
+  BatchV.clear();
+  Segments.clear();
+  LayoutV.clear();
+  Cache.clear();
 } /* End of 'tse::font::Free' function */
 
 /***
@@ -157,6 +281,83 @@ tse::font * tse::font_manager::FntCreate( const std::string &FileName )
   return resource_manager::Add(font(FileName).Load(FileName));
 } /* End of 'tse::font_manager::FntCreate' function */
 
+/* Create font from read file data function.
+ * ARGUMENTS:
+ *   - font file name:
+ *       const std::string &Fileame;
+ *   - file data (see 'font::Read'):
+ *       std::vector<BYTE> &Mem;
+ * RETURNS:
+ *   (font *) created font interface.
+ */
+tse::font * tse::font_manager::FntCreate( const std::string &FileName, std::vector<BYTE> &Mem )
+{
+  font *fnt = resource_manager::Add(font(FileName));
+  fnt->Create(FileName, Mem);
+  return fnt;
+} /* End of 'tse::font_manager::FntCreate' function */
+
+/* Create font with asynchronous file reading function.
+ * Font draws nothing until file is read by loader thread and
+ * font atlas is built at frame start.
+ * ARGUMENTS:
+ *   - font file name:
+ *       const std::string &Fileame;
+ *   - ready callback (render thread, may be empty):
+ *       std::function<VOID( font *, BOOL )> OnReady;
+ * RETURNS:
+ *   (font *) created font interface.
+ */
+tse::font * tse::font_manager::FntLoadAsync( const std::string &FileName,
+                                             std::function<VOID( font *, BOOL )> OnReady )
+{
+  font *fnt = resource_manager::Add(font(FileName));
+  auto mem = std::make_shared<std::vector<BYTE>>();
+
+  RndRef.LoadAsync(FileName,
+    [FileName, mem]( UINT64 &Bytes ) -> BOOL
+    {
+      TSE_PROFILE("FontRead");
+      if (!font::Read(FileName, *mem))
+        return FALSE;
+      Bytes = mem->size();
+      return TRUE;
+    },
+    [fnt, FileName, mem]( VOID ) -> BOOL
+    {
+      fnt->Create(FileName, *mem);
+      *mem = {};
+      return TRUE;
+    },
+    [fnt, OnReady]( BOOL IsOk )
+    {
+      if (OnReady)
+        OnReady(fnt, IsOk);
+    }, fnt);
+  return fnt;
+} /* End of 'tse::font_manager::FntLoadAsync' function */
+
+/* Cancel pending loads of font to be deleted function.
+ * ARGUMENTS:
+ *   - font pointer:
+ *       font *Fnt;
+ * RETURNS: None.
+ */
+VOID tse::font_manager::CancelLoads( font *Fnt )
+{
+  RndRef.LoaderCancel(Fnt);
+} /* End of 'tse::font_manager::CancelLoads' function */
+
+/* Draw batched text of all fonts function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::font_manager::Flush( VOID )
+{
+  for (auto &f : Stock)
+    f.second.Flush();
+} /* End of 'tse::font_manager::Flush' function */
+
 /* Class constructor function.
  * ARGUMENTS:
  *   - render instance reference:
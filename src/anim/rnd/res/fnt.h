@@ -9,7 +9,7 @@
  *               Fonts declaration module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 04.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -34,9 +34,65 @@ namespace tse
   private:
     DWORD LineH, BaseH; // Font line height and base line height in pixels
     FLT AdvanceX[256];  // Every letter shift right value (0 if no letter present)
-    prim *Chars[256];   // Font characters primitives
     material *Mtl;      // Font material
 
+    static const INT MaxCached = 64; // Maximum number of cached static strings layouts
+
+    /* Text batch segment (strings drawn with the same camera) structure */
+    struct SEGMENT
+    {
+      matr VP;           // Camera view by projection matrix
+      INT First, Count;  // Segment vertices range
+    }; /* End of 'SEGMENT' structure */
+
+    std::vector<vertex_std4> Glyphs;   // Characters vertices (4 per character, strip order)
+    prim *Batch {};                    // Frame text batch primitive (streaming vertex buffer)
+    std::vector<vertex_std4> BatchV;   // Frame text batch vertices
+    std::vector<SEGMENT> Segments;     // Frame text batch segments
+    std::vector<vertex_std4> LayoutV;  // Non-static string layout scratch buffer
+    // Static strings layouts cache (string, size) -> vertices relative to draw position
+    std::map<std::pair<std::string, FLT>, std::vector<vertex_std4>> Cache;
+
+    /* Build string glyphs quads function.
+     * ARGUMENTS:
+     *   - font text:
+     *       const std::string &Str;
+     *   - font size:
+     *       FLT Size;
+     *   - vertices to append to (2 triangles per glyph, relative to text origin):
+     *       std::vector<vertex_std4> &V;
+     * RETURNS: None.
+     */
+    VOID Layout( const std::string &Str, FLT Size, std::vector<vertex_std4> &V ) const;
+
+    /* Build signed distance field atlas from glyphs bitmap function.
+     * ARGUMENTS:
+     *   - glyphs bitmap (BGRA, coverage in alpha):
+     *       const DWORD *Img;
+     *   - bitmap size:
+     *       INT W, H;
+     *   - atlas down scale factor:
+     *       INT Scale;
+     *   - distance spread in atlas pixels:
+     *       INT Spread;
+     * RETURNS:
+     *   (std::vector<BYTE>) atlas (W / Scale x H / Scale, 0.5 at glyph edge).
+     */
+    std::vector<BYTE> BuildSDF( const DWORD *Img, INT W, INT H, INT Scale, INT Spread ) const;
+
+    /* Create signed distance field material (load from cache or build) function.
+     * ARGUMENTS:
+     *   - font file name:
+     *       const std::string &FileName;
+     *   - glyphs bitmap (BGRA, coverage in alpha):
+     *       const DWORD *Img;
+     *   - bitmap size:
+     *       INT W, H;
+     * RETURNS:
+     *   (BOOL) TRUE if success, FALSE otherwise.
+     */
+    BOOL CreateSDF( const std::string &FileName, const DWORD *Img, INT W, INT H );
+
   public:
     std::string Name;   // Font name
 
@@ -53,14 +109,38 @@ namespace tse
     /* Class destructor function */
     ~font( VOID );
  
-    /* Class constructor function.
+    /* Load font from file function.
      * ARGUMENTS:
      *   - font file name:
      *       const std::string &FileName;
+     * RETURNS:
+     *   (font &) self reference.
      */
     font & Load( const std::string &FileName );
 
-    /* Draw font function.
+    /* Read font file (any thread) function.
+     * ARGUMENTS:
+     *   - font file name:
+     *       const std::string &FileName;
+     *   - file data:
+     *       std::vector<BYTE> &Mem;
+     * RETURNS:
+     *   (BOOL) TRUE if file is G3DF font.
+     */
+    static BOOL Read( const std::string &FileName, std::vector<BYTE> &Mem );
+
+    /* Create font from file data (render thread) function.
+     * ARGUMENTS:
+     *   - font file name:
+     *       const std::string &FileName;
+     *   - file data:
+     *       std::vector<BYTE> &Mem;
+     * RETURNS:
+     *   (font &) self reference.
+     */
+    font & Create( const std::string &FileName, std::vector<BYTE> &Mem );
+
+    /* Draw font function (text is batched and drawn on 'Flush').
      * ARGUMENTS:
      *   - font text to draw:
      *       const std::string &Str;
@@ -68,9 +148,17 @@ namespace tse
      *       vec3 Pos;
      *   - font size:
      *       FLT Size;
+     *   - static string flag (layout is cached between frames):
+     *       BOOL IsStatic;
+     * RETURNS: None.
+     */
+    VOID Draw( const std::string &Str, vec3 Pos, FLT Size, BOOL IsStatic = FALSE );
+
+    /* Draw batched text function.
+     * ARGUMENTS: None.
      * RETURNS: None.
      */
-    VOID Draw( const std::string &Str, vec3 Pos, FLT Size );
+    VOID Flush( VOID );
  
     /* Free font function.
      * ARGUMENTS: None.
@@ -83,7 +171,18 @@ namespace tse
   /* Font manager */
   class font_manager : public resource_manager<font>
   {
+  private:
+    /* Cancel pending loads of font to be deleted function.
+     * ARGUMENTS:
+     *   - font pointer:
+     *       font *Fnt;
+     * RETURNS: None.
+     */
+    VOID CancelLoads( font *Fnt ) override;
+
   public:
+    BOOL IsFontSDF = TRUE; // Signed distance field atlases usage flag (for fonts loaded later)
+
     /* Create font function.
      * ARGUMENTS:
      *   - font file name:
@@ -92,6 +191,37 @@ namespace tse
      *   (font *) created font interface.
      */
     font * FntCreate( const std::string &FileName );
+
+    /* Create font from read file data function.
+     * ARGUMENTS:
+     *   - font file name:
+     *       const std::string &Fileame;
+     *   - file data (see 'font::Read'):
+     *       std::vector<BYTE> &Mem;
+     * RETURNS:
+     *   (font *) created font interface.
+     */
+    font * FntCreate( const std::string &FileName, std::vector<BYTE> &Mem );
+
+    /* Create font with asynchronous file reading function.
+     * Font draws nothing until file is read by loader thread and
+     * font atlas is built at frame start.
+     * ARGUMENTS:
+     *   - font file name:
+     *       const std::string &Fileame;
+     *   - ready callback (render thread, may be empty):
+     *       std::function<VOID( font *, BOOL )> OnReady;
+     * RETURNS:
+     *   (font *) created font interface.
+     */
+    font * FntLoadAsync( const std::string &FileName,
+                         std::function<VOID( font *, BOOL )> OnReady = {} );
+
+    /* Draw batched text of all fonts function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Flush( VOID );
  
     /* Class constructor function.
      * ARGUMENTS:
@@ -0,0 +1,175 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : fnt_sdf.cpp
+ * PURPOSE     : Tough Space Exploration project.
+ *               Render system module.
+ *               Resources.
+ *               Font signed distance field atlas module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include "tse.h"
+
+/* Signed distance field atlas cache file header structure */
+struct SDF_HEADER
+{
+  DWORD Sign;          // "TSDF" signature
+  DWORD Version;       // Cache format version
+  UINT64 SrcSize;      // Source font file size
+  INT64 SrcTime;       // Source font file last write time
+  INT W, H;            // Atlas size
+  INT Scale, Spread;   // Down scale factor and distance spread (atlas pixels)
+}; /* End of 'SDF_HEADER' structure */
+
+/* Build signed distance field atlas from glyphs bitmap function.
+ * ARGUMENTS:
+ *   - glyphs bitmap (BGRA, coverage in alpha):
+ *       const DWORD *Img;
+ *   - bitmap size:
+ *       INT W, H;
+ *   - atlas down scale factor:
+ *       INT Scale;
+ *   - distance spread in atlas pixels:
+ *       INT Spread;
+ * RETURNS:
+ *   (std::vector<BYTE>) atlas (W / Scale x H / Scale, 0.5 at glyph edge).
+ */
+std::vector<BYTE> tse::font::BuildSDF( const DWORD *Img, INT W, INT H, INT Scale, INT Spread ) const
+{
+  INT sw = W / Scale, sh = H / Scale, r = Spread * Scale;
+  std::vector<BYTE> sdf(sw * sh, 0);
+  auto IsInside = [&]( INT X, INT Y )
+    {
+      return (Img[Y * W + X] >> 24) >= 128;
+    };
+
+  /* Every glyph is processed separately inside its own rectangle:
+   * distances never leak into neighbour glyphs of the atlas */
+  auto BuildGlyph = [&]( INT Chr )
+    {
+      if (AdvanceX[Chr] == 0)
+        return;
+      const vertex_std4 *g = &Glyphs[Chr * 4];
+      FLT
+        u0 = std::min({g[0].T.X, g[1].T.X, g[2].T.X, g[3].T.X}),
+        u1 = std::max({g[0].T.X, g[1].T.X, g[2].T.X, g[3].T.X}),
+        v0 = std::min({g[0].T.Y, g[1].T.Y, g[2].T.Y, g[3].T.Y}),
+        v1 = std::max({g[0].T.Y, g[1].T.Y, g[2].T.Y, g[3].T.Y});
+      INT
+        x0 = std::clamp((INT)floor(u0 * W), 0, W), x1 = std::clamp((INT)ceil(u1 * W), 0, W),
+        y0 = std::clamp((INT)floor(v0 * H), 0, H), y1 = std::clamp((INT)ceil(v1 * H), 0, H);
+
+      for (INT oy = y0 / Scale; oy < (y1 + Scale - 1) / Scale && oy < sh; oy++)
+        for (INT ox = x0 / Scale; ox < (x1 + Scale - 1) / Scale && ox < sw; ox++)
+        {
+          INT
+            cx = std::clamp(ox * Scale + Scale / 2, x0, x1 - 1),
+            cy = std::clamp(oy * Scale + Scale / 2, y0, y1 - 1);
+          BOOL in = IsInside(cx, cy);
+          INT best = r * r;
+
+          /* Nearest texel of opposite state (brute force in spread radius) */
+          for (INT y = std::max(cy - r, y0); y <= std::min(cy + r, y1 - 1); y++)
+            for (INT x = std::max(cx - r, x0); x <= std::min(cx + r, x1 - 1); x++)
+              if (IsInside(x, y) != in)
+              {
+                INT d2 = (x - cx) * (x - cx) + (y - cy) * (y - cy);
+                if (d2 < best)
+                  best = d2;
+              }
+          FLT d = (sqrt((FLT)best) - 0.5f) / Scale;
+          FLT v = 0.5f + (in ? d : -d) / (2.0f * Spread);
+          sdf[oy * sw + ox] = (BYTE)(std::clamp(v, 0.0f, 1.0f) * 255 + 0.5f);
+        }
+    };
+
+  /* Glyphs are distributed between workers */
+  std::atomic_int next {0};
+  std::vector<std::thread> workers(std::max(1u, std::thread::hardware_concurrency()));
+  for (auto &w : workers)
+    w = std::thread([&]( VOID )
+      {
+        for (INT chr; (chr = next++) < 256; )
+          BuildGlyph(chr);
+      });
+  for (auto &w : workers)
+    w.join();
+  return sdf;
+} /* End of 'tse::font::BuildSDF' function */
+
+/* Create signed distance field material (load from cache or build) function.
+ * ARGUMENTS:
+ *   - font file name:
+ *       const std::string &FileName;
+ *   - glyphs bitmap (BGRA, coverage in alpha):
+ *       const DWORD *Img;
+ *   - bitmap size:
+ *       INT W, H;
+ * RETURNS:
+ *   (BOOL) TRUE if success, FALSE otherwise.
+ */
+BOOL tse::font::CreateSDF( const std::string &FileName, const DWORD *Img, INT W, INT H )
+{
+  std::error_code ec;
+  std::filesystem::path src(FileName), cache_name(src);
+  cache_name.replace_extension(".sdf");
+
+  SDF_HEADER hdr {};
+  hdr.Sign = *(DWORD *)"TSDF";
+  hdr.Version = 1;
+  hdr.SrcSize = std::filesystem::file_size(src, ec);
+  hdr.SrcTime = std::filesystem::last_write_time(src, ec).time_since_epoch().count();
+  /* About 32 pixels per line in atlas, 4 atlas pixels of spread */
+  hdr.Scale = std::max(1, (INT)LineH / 32);
+  hdr.Spread = 4;
+  hdr.W = W / hdr.Scale;
+  hdr.H = H / hdr.Scale;
+
+  /* Try cache */
+  std::vector<BYTE> sdf;
+  if (std::fstream f(cache_name, std::fstream::in | std::fstream::binary); f.is_open())
+  {
+    SDF_HEADER fhdr {};
+    f.read((CHAR *)&fhdr, sizeof(fhdr));
+    if (f && memcmp(&fhdr, &hdr, sizeof(hdr)) == 0)
+    {
+      sdf.resize(hdr.W * hdr.H);
+      if (!f.read((CHAR *)sdf.data(), sdf.size()))
+        sdf.clear();
+    }
+  }
+  if (sdf.empty())
+  {
+    auto start = std::chrono::steady_clock::now();
+    sdf = BuildSDF(Img, W, H, hdr.Scale, hdr.Spread);
+    tse::logger::Info(std::format("FONT SDF atlas built in {:.1f} ms: {}",
+      std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - start).count(),
+      cache_name.string()));
+    if (std::fstream f(cache_name, std::fstream::out | std::fstream::binary); f.is_open())
+    {
+      f.write((CHAR *)&hdr, sizeof(hdr));
+      f.write((CHAR *)sdf.data(), sdf.size());
+    }
+  }
+
+  /* Material */
+  Mtl = anim::Get().MtlCreate(FileName);
+  Mtl->Tex[0] = anim::Get().TexCreate(cache_name.string(), hdr.W, hdr.H, 1, sdf.data(), FALSE);
+  Mtl->Shd = anim::Get().shader_manager::Find("font_sdf");
+  if (Mtl->Shd == nullptr)
+    Mtl->Shd = anim::Get().ShdCreate("font_sdf");
+  tse::logger::Info(std::format("FONT atlas memory: bitmap {} KB, SDF {} KB",
+    W * H * 4 / 1024, hdr.W * hdr.H / 1024));
+  return TRUE;
+} /* End of 'tse::font::CreateSDF' function */
+
+/* END OF 'fnt_sdf.cpp' FILE */
@@ -0,0 +1,254 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : loader.cpp
+ * PURPOSE     : Tough Space Exploration project.
+ *               Render resources module.
+ *               Asynchronous resources loader module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include "tse.h"
+
+/* Class constructor */
+tse::resource_loader::resource_loader( VOID )
+{
+} /* End of 'tse::resource_loader::resource_loader' function */
+
+/* Class destructor */
+tse::resource_loader::~resource_loader( VOID )
+{
+  LoaderStop();
+} /* End of 'tse::resource_loader::~resource_loader' function */
+
+/* Reading thread function.
+ * ARGUMENTS:
+ *   - thread number:
+ *       INT Index;
+ * RETURNS: None.
+ */
+VOID tse::resource_loader::LoaderMain( INT Index )
+{
+  profiler::SetThreadName(std::format("Loader {}", Index));
+#ifdef _WIN32
+  /* Image decoding uses COM */
+  CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif /* _WIN32 */
+
+  while (TRUE)
+  {
+    std::shared_ptr<REQUEST> req;
+    {
+      std::unique_lock<std::mutex> lock(LoaderLock);
+      LoaderCV.wait(lock, [&]{ return IsLoaderStop || !ReadQueue.empty(); });
+      if (IsLoaderStop)
+        break;
+      req = std::move(ReadQueue.front());
+      ReadQueue.pop_front();
+    }
+    {
+      TSE_PROFILE("LoaderRead");
+      req->IsOk = req->Read(req->Bytes);
+    }
+    std::lock_guard<std::mutex> lock(LoaderLock);
+    UploadQueue.push_back(std::move(req));
+  }
+
+#ifdef _WIN32
+  CoUninitialize();
+#endif /* _WIN32 */
+} /* End of 'tse::resource_loader::LoaderMain' function */
+
+/* Complete request function.
+ * ARGUMENTS:
+ *   - request:
+ *       REQUEST &Req;
+ *   - success flag:
+ *       BOOL IsOk;
+ * RETURNS: None.
+ */
+VOID tse::resource_loader::LoaderFinish( REQUEST &Req, BOOL IsOk )
+{
+  if (Req.IsCancelled)
+    IsOk = FALSE;
+  else if (IsOk)
+  {
+    LoaderStats.Completed++;
+    LoaderStats.BytesRead += Req.Bytes;
+  }
+  else
+  {
+    LoaderStats.Failed++;
+    tse::logger::Warn("LOADER failed: " + Req.Name);
+  }
+  NumOfLoads--;
+  std::erase_if(Loads, [&]( const std::shared_ptr<REQUEST> &R ){ return R.get() == &Req; });
+  if (Req.OnDone && !Req.IsCancelled)
+    Req.OnDone(IsOk);
+  Req.Promise.set_value(IsOk);
+} /* End of 'tse::resource_loader::LoaderFinish' function */
+
+/* Start asynchronous load (render thread) function.
+ * ARGUMENTS:
+ *   - request name:
+ *       const std::string &Name;
+ *   - reading stage (loader thread, no render calls, sets read bytes):
+ *       std::function<BOOL( UINT64 & )> Read;
+ *   - upload step (render thread, returns TRUE when done):
+ *       std::function<BOOL( VOID )> Upload;
+ *   - completion callback (render thread, may be empty):
+ *       std::function<VOID( BOOL )> OnDone;
+ *   - loaded resource or object (see 'LoaderCancel', may be nullptr):
+ *       const VOID *Owner;
+ * RETURNS:
+ *   (std::shared_future<BOOL>) load success future.
+ */
+std::shared_future<BOOL> tse::resource_loader::LoadAsync( const std::string &Name,
+                                                           std::function<BOOL( UINT64 & )> Read,
+                                                           std::function<BOOL( VOID )> Upload,
+                                                           std::function<VOID( BOOL )> OnDone,
+                                                           const VOID *Owner )
+{
+  auto req = std::make_shared<REQUEST>();
+  req->Name = Name;
+  req->Read = std::move(Read);
+  req->Upload = std::move(Upload);
+  req->OnDone = std::move(OnDone);
+  req->Owner = Owner;
+  std::shared_future<BOOL> result = req->Promise.get_future().share();
+  Loads.push_back(req);
+
+  if (NumOfLoads++ == 0)
+    LastLoaderUpdate = std::chrono::steady_clock::now();
+  LoaderStats.Requested++;
+  std::lock_guard<std::mutex> lock(LoaderLock);
+  if (LoaderThreads.empty())
+  {
+    IsLoaderStop = FALSE;
+    for (INT i = 0; i < std::max(NumOfLoaderThreads, 1); i++)
+      LoaderThreads.emplace_back(&resource_loader::LoaderMain, this, i);
+  }
+  ReadQueue.push_back(std::move(req));
+  LoaderCV.notify_one();
+  return result;
+} /* End of 'tse::resource_loader::LoadAsync' function */
+
+/* Cancel not completed loads of deleted resource or object (render thread) function.
+ * Reading stage may still run (it does not use owner), upload and
+ * completion callback are skipped, futures get failure.
+ * ARGUMENTS:
+ *   - loaded resource or object:
+ *       const VOID *Owner;
+ * RETURNS:
+ *   (BOOL) TRUE if any load is cancelled.
+ */
+BOOL tse::resource_loader::LoaderCancel( const VOID *Owner )
+{
+  BOOL is_cancelled = FALSE;
+
+  if (Owner == nullptr)
+    return FALSE;
+  for (auto &req : Loads)
+    if (req->Owner == Owner && !req->IsCancelled)
+      req->IsCancelled = is_cancelled = TRUE;
+  return is_cancelled;
+} /* End of 'tse::resource_loader::LoaderCancel' function */
+
+/* Upload read resources under time budget (called every frame) function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::resource_loader::LoaderUpdate( VOID )
+{
+  if (NumOfLoads == 0)
+    return;
+  TSE_PROFILE("LoaderUpdate");
+
+  /* Frame time while streaming */
+  auto start = std::chrono::steady_clock::now();
+  DBL frame = std::chrono::duration<DBL, std::milli>(start - LastLoaderUpdate).count();
+  LastLoaderUpdate = start;
+  LoaderStats.StreamTime += frame;
+  LoaderStats.MaxStreamFrame = std::max(LoaderStats.MaxStreamFrame, frame);
+
+  /* At least one step per frame, then while budget allows */
+  DBL spent = 0;
+  while (TRUE)
+  {
+    std::shared_ptr<REQUEST> req;
+    {
+      std::lock_guard<std::mutex> lock(LoaderLock);
+      if (UploadQueue.empty())
+        break;
+      req = UploadQueue.front();
+    }
+    BOOL is_done = TRUE;
+    if (req->IsOk && !req->IsCancelled)
+      is_done = req->Upload();
+    if (is_done)
+    {
+      {
+        std::lock_guard<std::mutex> lock(LoaderLock);
+        UploadQueue.pop_front();
+      }
+      LoaderFinish(*req, req->IsOk);
+    }
+    spent = std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (spent >= UploadBudget)
+      break;
+  }
+  LoaderStats.UploadTime += spent;
+  LoaderStats.MaxFrameUpload = std::max(LoaderStats.MaxFrameUpload, spent);
+} /* End of 'tse::resource_loader::LoaderUpdate' function */
+
+/* Complete all pending loads (render thread) function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::resource_loader::LoaderWaitAll( VOID )
+{
+  DBL save_budget = UploadBudget;
+  UploadBudget = 1e9;
+  while (NumOfLoads > 0 && !LoaderThreads.empty())
+  {
+    LoaderUpdate();
+    if (NumOfLoads > 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  UploadBudget = save_budget;
+} /* End of 'tse::resource_loader::LoaderWaitAll' function */
+
+/* Stop reading threads (pending requests are dropped) function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::resource_loader::LoaderStop( VOID )
+{
+  {
+    std::lock_guard<std::mutex> lock(LoaderLock);
+    IsLoaderStop = TRUE;
+  }
+  LoaderCV.notify_all();
+  for (auto &th : LoaderThreads)
+    th.join();
+  LoaderThreads.clear();
+
+  /* Dropped requests futures get failure */
+  for (auto *q : {&ReadQueue, &UploadQueue})
+    for (auto &req : *q)
+      req->Promise.set_value(FALSE);
+  ReadQueue.clear();
+  UploadQueue.clear();
+  Loads.clear();
+  NumOfLoads = 0;
+} /* End of 'tse::resource_loader::LoaderStop' function */
+
+/* END OF 'loader.cpp' FILE */
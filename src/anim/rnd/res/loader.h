@@ -0,0 +1,163 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : loader.h
+ * PURPOSE     : Tough Space Exploration project.
+ *               Render resources module.
+ *               Asynchronous resources loader declaration module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __loader_h_
+#define __loader_h_
+
+/* Main program namespace */
+namespace tse
+{
+  /* Asynchronous resources loader class.
+   * Request passes two stages: reading (file I/O and decoding) on loader
+   * threads, then uploading on render thread in bounded steps under per
+   * frame time budget. Resources stay as placeholders until uploaded. */
+  class resource_loader
+  {
+  public:
+    /* Loading statistics structure (times in milliseconds) */
+    struct LOADER_STATS
+    {
+      INT Requested = 0, Completed = 0, Failed = 0; // Requests counters
+      UINT64 BytesRead = 0;                         // Read and decoded data size
+      DBL UploadTime = 0;                           // Total render thread upload time
+      DBL MaxFrameUpload = 0;                       // Worst single frame upload time
+      DBL MaxStreamFrame = 0;                       // Worst frame time while loads are pending
+      DBL StreamTime = 0;                           // Time with pending loads
+    } LoaderStats;
+
+    DBL UploadBudget = 2;     // Render thread upload time per frame (ms, at least one step is done)
+    INT NumOfLoaderThreads = 2; // Reading threads (applied on first request)
+
+  private:
+    /* Load request structure */
+    struct REQUEST
+    {
+      std::string Name;                          // Request name (file name)
+      std::function<BOOL( UINT64 & )> Read;      // Reading stage (loader thread)
+      std::function<BOOL( VOID )> Upload;        // Upload step (render thread, TRUE when done)
+      std::function<VOID( BOOL )> OnDone;        // Completion callback (render thread)
+      std::promise<BOOL> Promise;                // Completion promise
+      UINT64 Bytes = 0;                          // Read data size
+      BOOL IsOk = FALSE;                         // Reading success flag
+      const VOID *Owner = nullptr;               // Loaded resource or object (upload and callback use it)
+      BOOL IsCancelled = FALSE;                  // Resource is deleted flag (upload and callback are skipped)
+    }; /* End of 'REQUEST' structure */
+
+    std::mutex LoaderLock;                          // Queues lock
+    std::condition_variable LoaderCV;               // Read queue signal
+    std::deque<std::shared_ptr<REQUEST>>
+      ReadQueue,                                    // Requests to read
+      UploadQueue;                                  // Read requests to upload
+    std::vector<std::thread> LoaderThreads;         // Reading threads
+    BOOL IsLoaderStop = FALSE;                      // Reading threads stop flag
+    INT NumOfLoads = 0;                             // Not completed requests (render thread)
+    std::vector<std::shared_ptr<REQUEST>> Loads;    // Not completed requests list (render thread)
+    std::chrono::steady_clock::time_point LastLoaderUpdate; // Previous 'LoaderUpdate' time
+
+    /* Reading thread function.
+     * ARGUMENTS:
+     *   - thread number:
+     *       INT Index;
+     * RETURNS: None.
+     */
+    VOID LoaderMain( INT Index );
+
+    /* Complete request function.
+     * ARGUMENTS:
+     *   - request:
+     *       REQUEST &Req;
+     *   - success flag:
+     *       BOOL IsOk;
+     * RETURNS: None.
+     */
+    VOID LoaderFinish( REQUEST &Req, BOOL IsOk );
+
+  public:
+    /* Class constructor */
+    resource_loader( VOID );
+
+    /* Class destructor */
+    ~resource_loader( VOID );
+
+    /* Start asynchronous load (render thread) function.
+     * ARGUMENTS:
+     *   - request name:
+     *       const std::string &Name;
+     *   - reading stage (loader thread, no render calls, sets read bytes):
+     *       std::function<BOOL( UINT64 & )> Read;
+     *   - upload step (render thread, returns TRUE when done):
+     *       std::function<BOOL( VOID )> Upload;
+     *   - completion callback (render thread, may be empty):
+     *       std::function<VOID( BOOL )> OnDone;
+     *   - loaded resource or object (see 'LoaderCancel', may be nullptr):
+     *       const VOID *Owner;
+     * RETURNS:
+     *   (std::shared_future<BOOL>) load success future.
+     */
+    std::shared_future<BOOL> LoadAsync( const std::string &Name,
+                                        std::function<BOOL( UINT64 & )> Read,
+                                        std::function<BOOL( VOID )> Upload,
+                                        std::function<VOID( BOOL )> OnDone = {},
+                                        const VOID *Owner = nullptr );
+
+    /* Cancel not completed loads of deleted resource or object (render thread) function.
+     * Reading stage may still run (it does not use owner), upload and
+     * completion callback are skipped, futures get failure.
+     * ARGUMENTS:
+     *   - loaded resource or object:
+     *       const VOID *Owner;
+     * RETURNS:
+     *   (BOOL) TRUE if any load is cancelled.
+     */
+    BOOL LoaderCancel( const VOID *Owner );
+
+    /* Upload read resources under time budget (called every frame) function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID LoaderUpdate( VOID );
+
+    /* Complete all pending loads (render thread) function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID LoaderWaitAll( VOID );
+
+    /* Stop reading threads (pending requests are dropped) function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID LoaderStop( VOID );
+
+    /* Obtain number of not completed loads function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) number of loads.
+     */
+    INT NumOfPendingLoads( VOID ) const
+    {
+      return NumOfLoads;
+    } /* End of 'NumOfPendingLoads' function */
+
+  }; /* End of 'resource_loader' class */
+
+} /* end of 'tse' namespace */
+
+#endif /* __loader_h_ */
+
+/* END OF 'loader.h' FILE */
@@ -9,7 +9,7 @@
  *               Materials implementation module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 03.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -78,7 +78,7 @@ tse::material & tse::material::Create( const std::string &NewName,
   for (i = 0; i < 8; i++)
     buf.TexFlags[i] = Tex[i] != nullptr;
   BufferMtl = anim::Get().buffer_manager::BufCreate(3, &buf);
-  tse::logger::Info("MATERIAL created: " + Name);
+  TSE_LOGF(DBG, "MATERIAL created: {}", Name);
   return *this;
 } /* End of 'tse::material::Create' function */
  
@@ -102,9 +102,33 @@ tse::shader * tse::material::Apply( VOID )
 {
   if (Shd == nullptr)
     Shd = anim::Get().shader_manager::Find("default");
-  if (Shd != nullptr)
+  shader *shd = Shd;
+
+  /* Texture slots variant: 'HAS_TEXn' defined for every bound texture */
+  if (shd != nullptr && shd->IsTexVariants && anim::Get().IsVariantsEnabled)
+  {
+    INT mask = 0;
+    for (INT t = 0; t < 8; t++)
+      if (Tex[t] != nullptr)
+        mask |= 1 << t;
+    if (VariantBase != Shd || VariantMask != mask)
+    {
+      std::vector<std::string> defs {"TEX_VARIANTS"};
+      for (INT t = 0; t < 8; t++)
+        if (mask & (1 << t))
+          defs.push_back(std::format("HAS_TEX{}", t));
+      VariantBase = Shd;
+      VariantMask = mask;
+      Variant = anim::Get().ShdVariant(Shd, defs);
+    }
+    shd = Variant;
+  }
+  /* Shader is still compiling (or failed) - draw with default one */
+  if (shd != nullptr && shd->ProgId == 0)
+    shd = anim::Get().shader_manager::Find("default");
+  if (shd != nullptr)
   {
-    Shd->Apply();
+    shd->Apply();
     BufferMtl->Apply();
     for (INT t = 0; t < 8; t++)
     {
@@ -115,7 +139,7 @@ tse::shader * tse::material::Apply( VOID )
       }
     }
   }
-  return Shd;
+  return shd;
 } /* End of 'tse::material::Apply' function */
 
 /* Update material buffer function.
@@ -9,7 +9,7 @@
  *               Materials declaration module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 03.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -40,6 +40,11 @@ namespace tse
       vec4 KsPh;       // Specular color + Phong coefficient
       INT TexFlags[8]; // Textures flags
     }; /* End of 'BUF_MTL' structure */
+
+    /* Selected texture slots shader variant cache */
+    shader *VariantBase {}; // Shader the variant was selected for
+    INT VariantMask = -1;   // Texture slots mask the variant was selected for
+    shader *Variant {};     // Selected variant
  
   public:
     std::string Name; // Material name
@@ -9,7 +9,7 @@
  *               Primitives implementation module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 03.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -38,59 +38,15 @@ tse::prim::~prim( VOID )
  */
 VOID tse::prim::Free( VOID )
 {
-  VertexMap.clear();
-  if (VA != 0)
-  {
-    glBindVertexArray(VA);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    if (VBuf != 0)
-      glDeleteBuffers(1, &VBuf);
-    glBindVertexArray(0);
-    glDeleteVertexArrays(1, &VA);
-    VA = 0;
-    VBuf = 0;
-  }
+  if (VBuf != 0)
+    glDeleteBuffers(1, &VBuf), VBuf = 0;
   if (IBuf != 0)
     glDeleteBuffers(1, &IBuf), IBuf = 0;
+  FormatKey = 0;
   NumOfElements = 0;
   MinBB = MaxBB = {};
 } /* End of 'tse::prim::Free' function */
 
-/* Update primitive vertex array function.
- * ARGUMENTS: None.
- * RETURNS: Non.
- */
-VOID tse::prim::UpdateVA( VOID ) const
-{
-  if (Mtl == nullptr || Mtl->Shd == nullptr)
-    return;
-  if (IsVAUpdated)
-    return;
-  IsVAUpdated = TRUE;
- 
-  /* Activate vertex array */
-  glBindVertexArray(VA);
- 
-  /* Activate vertex buffer */
-  glBindBuffer(GL_ARRAY_BUFFER, VBuf);
- 
-  /* Setup data order due to vertex map */
-  for (auto &a : VertexMap)
-    if (auto attr = Mtl->Shd->Attributes.find(a.first);
-        attr != Mtl->Shd->Attributes.end())
-    {
-      glEnableVertexAttribArray(attr->second.Loc);
-      glVertexAttribPointer(attr->second.Loc,          // Layout
-        attr->second.Components,                       // Components count
-        attr->second.IsFloat ? GL_FLOAT : GL_INT,      // Component type
-        FALSE,                                         // Normalize flag
-        VertexStride,                                  // Stride
-        reinterpret_cast<VOID *>((UINT_PTR)a.second)); // Offset
-    }
-  /* Disable vertex array */
-  glBindVertexArray(0);
-} /* End of 'tse::prim::UpdateVA' function */
- 
 /* Primitive with empty vertex stream creation function.
  * ARGUMENTS:
  *   - primitive type:
@@ -106,11 +62,10 @@ tse::prim & tse::prim::Create( tse::prim_type Type, INT NumOfV )
   Type = Type;
   Transform = matr::Identity();
   NumOfElements = NumOfV;
+  MemSize = 0;
   VertexStride = 0;
+  FormatKey = 0;
   MinBB = MaxBB = vec3(0);
- 
-  /* Create OpenGL vertex array */
-  glGenVertexArrays(1, &VA);
   return *this;
 } /* End of 'tse::prim::Create' function */
 
@@ -128,11 +83,38 @@ tse::prim & tse::prim::Create( tse::prim_type Type, INT NumOfV )
 tse::prim & tse::prim::Load( const std::string &FileName,
                                const matr &Transform, const vec3 &FitSize )
 {
-  std::ifstream f(anim::Path() + FileName);
-  std::string Src(std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>()));
+  TSE_PROFILE("PrimLoad");
 
-  if (Src.length() == 0)
+  std::vector<vertex_std4> V;
+  std::vector<INT> Ind;
+  if (!Parse(FileName, Transform, V, Ind))
     return *this;
+  Create(anim::Get().MtlCreate(FileName), prim_type::TRIMESH, std::span(V), std::span(Ind));
+  Source = FileName;
+  SourceTransform = Transform;
+  TSE_LOGF(DBG, "PRIMITIVE loaded: {}", FileName);
+  return *this;
+} /* End of 'tse::prim::Load' function */
+
+/* Parse .OBJ file (any thread) function.
+ * ARGUMENTS:
+ *   - file name (*.OBJ model) to be load:
+ *       const std::string &FileName;
+ *   - transform matrix:
+ *       const matr &Transform;
+ *   - result vertex and index arrays:
+ *       std::vector<vertex_std4> &V;
+ *       std::vector<INT> &Ind;
+ * RETURNS:
+ *   (BOOL) TRUE if success.
+ */
+BOOL tse::prim::Parse( const std::string &FileName, const matr &Transform,
+                       std::vector<vertex_std4> &V, std::vector<INT> &Ind )
+{
+  std::string Src = vfs::ReadText(anim::Path() + FileName);
+
+  if (Src.length() == 0)
+    return FALSE;
 
   /* Count vertices and indices */
   SIZE_T nv = 0, nf = 0, nn = 0, nt = 0;
@@ -150,8 +132,6 @@ tse::prim & tse::prim::Load( const std::string &FileName,
     }
   }
 
-  std::vector<vertex_std4> V;
-  std::vector<INT> Ind;
   V.resize(nv);
   Ind.resize(nf * 3);
   nv = 0, nf = 0;
@@ -219,10 +199,8 @@ tse::prim & tse::prim::Load( const std::string &FileName,
   if (min_ind > 0)
     for (INT i = 0; i < Ind.size(); i++)
       Ind[i] -= min_ind;
-  Create(anim::Get().MtlCreate(FileName), prim_type::TRIMESH, std::span(V), Ind);
-  tse::logger::Info("PRIMITIVE loaded: " + FileName);
-  return *this;
-} /* End of 'tse::prim::Load' function */
+  return TRUE;
+} /* End of 'tse::prim::Parse' function */
 
 /***
  * MODEL FUNCTIONS
@@ -236,8 +214,31 @@ tse::model::model( VOID ) : Transform(matr::Identity())
 /* Destructor function */
 tse::model::~model( VOID )
 {
+  CancelLoad();
 } /* End of 'tse::model::~model' function */
 
+/* Cancel not completed asynchronous load function.
+ * Partially uploaded textures and primitives are freed.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::model::CancelLoad( VOID )
+{
+  if (Pending == nullptr)
+    return;
+
+  /* Resources of requests dropped by stopped loader are freed by managers */
+  anim &ani = anim::Get();
+  if (ani.LoaderCancel(this))
+  {
+    for (auto pr : Pending->PrimRes)
+      ani.render::PrimFree(pr);
+    for (auto tex : Pending->TexRes)
+      ani.texture_manager::Delete(tex);
+  }
+  Pending.reset();
+} /* End of 'tse::model::CancelLoad' function */
+
 /* Add new primitive to set function.
  * ARGUMENTS:
  *   - primitive to be add:
@@ -265,32 +266,59 @@ tse::model & tse::model::operator<<( prim *Pr )
 tse::model & tse::model::Load( const std::string &FileName,
                                  const matr &Transform, const vec3 &FitSize )
 {
-  for (auto pr : Prims)
-    tse::anim::Get().render::PrimFree(pr);
-  Prims.clear();
-  this->Transform = matr::Identity();
-  MinBB = MaxBB = vec3(0);
+  TSE_PROFILE("ModelLoad");
 
-  std::fstream f(FileName, std::fstream::in | std::fstream::binary);
-  if (!f.is_open())
+  CancelLoad();
+  LOAD_DATA data;
+  if (!Decode(FileName, Transform, FitSize, data))
+  {
+    for (auto pr : Prims)
+      tse::anim::Get().render::PrimFree(pr);
+    Prims.clear();
+    this->Transform = matr::Identity();
+    MinBB = MaxBB = vec3(0);
     return *this;
+  }
+  while (!Upload(data))
+    ;
+  return *this;
+} /* End of 'tse::model::Load' function */
 
-  f.seekg(0, std::fstream::end);
-  SIZE_T flen = f.tellg();
-  f.seekg(0, std::fstream::beg);
+/* Decode model from *.G3DM file (any thread, no render calls) function.
+ * ARGUMENTS:
+ *   - file name (*.G3DM model) to be load:
+ *       const std::string &FileName;
+ *   - transform matrix:
+ *       const matr &Transform;
+ *   - fit size vector flag:
+ *       const vec3 &FitSize;
+ *   - decoded data:
+ *       LOAD_DATA &Data;
+ * RETURNS:
+ *   (BOOL) TRUE if success.
+ */
+BOOL tse::model::Decode( const std::string &FileName, const matr &Transform,
+                         const vec3 &FitSize, LOAD_DATA &Data )
+{
+  Data = LOAD_DATA();
+  Data.FileName = FileName;
 
   std::vector<BYTE> mem;
-  mem.resize(flen);
-  f.read((CHAR *)mem.data(), flen);
+  if (!vfs::Read(FileName, mem))
+    return FALSE;
+  SIZE_T flen = mem.size();
+  Data.Bytes = flen;
   BYTE *ptr = mem.data();
 
   rdr rd(ptr);
 
   /* Load header */
   DWORD sign;
+  if (flen < sizeof(DWORD) * 4)
+    return FALSE;
   rd(&sign);
   if (sign != *(DWORD *)"G3DM")
-    return *this;
+    return FALSE;
 
   /* Get number of primitives, materials and textures */
   INT NoofP = 0, NoofM = 0, NoofT = 0;
@@ -301,6 +329,7 @@ tse::model & tse::model::Load( const std::string &FileName,
   /* Obtain min-max info */
   BYTE *save_ptr = ptr;
   BOOL IsFirstVertex = TRUE;
+  vec3 MinBB(0), MaxBB(0);
   for (INT i = 0; i < NoofP; i++)
   {
     UINT nv = 0, ni = 0, mtl_no;
@@ -350,14 +379,12 @@ tse::model & tse::model::Load( const std::string &FileName,
   }
 
   matr Trans = M * Transform;
-  MinBB = Trans.TransformPoint(MinBB);
-  MaxBB = Trans.TransformPoint(MaxBB);
+  Data.MinBB = Trans.TransformPoint(MinBB);
+  Data.MaxBB = Trans.TransformPoint(MaxBB);
   ptr = save_ptr;
 
   /* Load primitives */
-  Prims.resize(NoofP);
-  std::vector<INT> prims_mtl;
-  prims_mtl.resize(NoofP);
+  Data.Prims.resize(NoofP);
   for (INT i = 0; i < NoofP; i++)
   {
     UINT nv = 0, ni = 0;
@@ -366,57 +393,25 @@ tse::model & tse::model::Load( const std::string &FileName,
 
     rd(&nv);
     rd(&ni);
-    rd(&prims_mtl[i]);
+    rd(&Data.Prims[i].Mtl);
     rd(&V, nv);
     rd(&Ind, ni);
 
-    for (INT j = 0; j < nv; j++)
+    Data.Prims[i].V.assign(V, V + nv);
+    Data.Prims[i].Ind.assign(Ind, Ind + ni);
+    for (auto &v : Data.Prims[i].V)
     {
-      V[j].P = Trans.TransformPoint(V[j].P);
-      V[j].N = Trans.TransformNormal(V[j].N);
+      v.P = Trans.TransformPoint(v.P);
+      v.N = Trans.TransformNormal(v.N);
     }
-    Prims[i] = tse::anim::Get().PrimCreate(nullptr,
-      prim_type::TRIMESH, std::span(V, nv), std::span(Ind, ni));
   }
 
   /* Load materials */
-
-  /* Stored material structure */
-  struct STORE_MATERIAL
-  {
-    CHAR Name[300]; // Material name
- 
-    /* Illumination coefficients */ 
-    mth::vec3<FLT> Ka, Kd, Ks; // Ambient, diffuse, specular coefficients
-    FLT Ph;                    // Phong power coefficient
-    FLT Trans;                 // Transparency factor
-    INT Tex[8];                // Texture references
- 
-    CHAR ShaderStr[300];       // Shader string
-    INT Shader;                // Shader index (not used)
-  }; /* End of 'STORE_MATERIAL' struct */
-
-  std::vector<material *> mtls;
   STORE_MATERIAL *store_mtls;
   rd(&store_mtls, NoofM);
-  mtls.resize(NoofM);
-  if (NoofM > 0)
-  {
-    for (INT i = 0; i < NoofM; i++)
-    {
-      mtls[i] = anim::Get().MtlCreate(
-        FileName + "::" + store_mtls[i].Name);
-      mtls[i]->Ka = store_mtls[i].Ka;
-      mtls[i]->Kd = store_mtls[i].Kd;
-      mtls[i]->Ks = store_mtls[i].Ks;
-      mtls[i]->Ph = store_mtls[i].Ph;
-      mtls[i]->Trans = store_mtls[i].Trans;
-    }
-  }
+  Data.Mtls.assign(store_mtls, store_mtls + NoofM);
 
   /* Load textures */
-  std::vector<texture *> texs;
-  texs.resize(NoofT);
   for (INT i = 0; i < NoofT; i++)
   {
     CHAR Name[300];
@@ -427,36 +422,135 @@ tse::model & tse::model::Load( const std::string &FileName,
     rd(&H);
     rd(&C);
     SIZE_T last_byte = (ptr - mem.data()) + W * H * C;
-    if (last_byte <= mem.size())
-      texs[i] = anim::Get().TexCreate(FileName + "::" + Name, W, H, C, ptr);
-    else
+    if (last_byte > mem.size())
       break;
+    Data.Texs.push_back({Name, std::make_shared<texture::MIPS>(texture::BuildMips(W, H, C, ptr))});
     ptr += W * H * C;
   }
+  return TRUE;
+} /* End of 'tse::model::Decode' function */
 
-  /* Correct material texture references */
-  for (INT i = 0; i < NoofM; i++)
-    for (INT t = 0; t < 8; t++)
-      if (store_mtls[i].Tex[t] != -1)
-        mtls[i]->Tex[t] = texs[store_mtls[i].Tex[t]];
+/* Upload decoded model (render thread, one bounded step per call) function.
+ * ARGUMENTS:
+ *   - decoded data:
+ *       LOAD_DATA &Data;
+ * RETURNS:
+ *   (BOOL) TRUE if model is complete.
+ */
+BOOL tse::model::Upload( LOAD_DATA &Data )
+{
+  anim &ani = anim::Get();
 
-  /* Update material buffers */
-  if (NoofM > 0)
-    for (INT i = 0; i < NoofM; i++)
-      mtls[i]->Update();
+  /* Textures and primitives take one step each */
+  if (Data.Step < Data.Texs.size())
+  {
+    LOAD_DATA::TEX &t = Data.Texs[Data.Step++];
+    std::string name = Data.FileName + "::" + t.Name;
+    if (Data.IsStream)
+    {
+      BYTE white[4] {255, 255, 255, 255};
+      Data.TexRes.push_back(ani.TexCreate(name, 1, 1, 4, white, FALSE));
+      ani.TexStream(Data.TexRes.back(), std::move(t.Mips));
+    }
+    else
+      Data.TexRes.push_back(ani.TexCreate(name, *t.Mips));
+    t.Mips = {};
+    return FALSE;
+  }
+  if (INT p = Data.Step - (INT)Data.Texs.size(); p < Data.Prims.size())
+  {
+    LOAD_DATA::PRIM &pr = Data.Prims[p];
+    Data.PrimRes.push_back(ani.PrimCreate(nullptr,
+      prim_type::TRIMESH, std::span(pr.V), std::span(pr.Ind)));
+    pr.V = {};
+    pr.Ind = {};
+    Data.Step++;
+    return FALSE;
+  }
+
+  /* Materials and references: model is replaced at once */
+  std::vector<material *> mtls(Data.Mtls.size());
+  for (INT i = 0; i < Data.Mtls.size(); i++)
+  {
+    STORE_MATERIAL &sm = Data.Mtls[i];
+    mtls[i] = ani.MtlCreate(Data.FileName + "::" + sm.Name);
+    mtls[i]->Ka = sm.Ka;
+    mtls[i]->Kd = sm.Kd;
+    mtls[i]->Ks = sm.Ks;
+    mtls[i]->Ph = sm.Ph;
+    mtls[i]->Trans = sm.Trans;
+    for (INT t = 0; t < 8; t++)
+      if (sm.Tex[t] != -1 && sm.Tex[t] < Data.TexRes.size())
+        mtls[i]->Tex[t] = Data.TexRes[sm.Tex[t]];
+    mtls[i]->Update();
+  }
 
   /* Correct primitive material references */
-  for (INT i = 0; i < NoofP; i++)
-    if (prims_mtl[i] != -1)
-      if (prims_mtl[i] >= 0 && prims_mtl[i] < mtls.size())
-        Prims[i]->Mtl = mtls[prims_mtl[i]];
+  for (INT i = 0; i < Data.PrimRes.size(); i++)
+    if (INT m = Data.Prims[i].Mtl; m != -1)
+      if (m >= 0 && m < mtls.size())
+        Data.PrimRes[i]->Mtl = mtls[m];
       else
-        Prims[i]->Mtl = anim::Get().material_manager::Find("default");
+        Data.PrimRes[i]->Mtl = ani.material_manager::Find("default");
 
-  Prims.resize(NoofP);
-  tse::logger::Info("MODEL created: " + FileName);
-  return *this;
-} /* End of 'tse::model::Load' function */
+  for (auto pr : Prims)
+    ani.render::PrimFree(pr);
+  Prims.clear();
+  for (auto pr : Data.PrimRes)
+    Prims << pr;
+  Transform = matr::Identity();
+  MinBB = Data.MinBB;
+  MaxBB = Data.MaxBB;
+  TSE_LOGF(DBG, "MODEL created: {}", Data.FileName);
+  return TRUE;
+} /* End of 'tse::model::Upload' function */
+
+/* Load model from .G3DM asynchronously function.
+ * Model keeps previous primitives (empty at first) until new ones are
+ * uploaded, previous not completed load and load of destroyed model
+ * are cancelled.
+ * ARGUMENTS:
+ *   - file name (*.G3DM model) to be load:
+ *       const std::string &FileName;
+ *   - transform matrix:
+ *       const matr &Transform;
+ *   - fit size flag vector:
+ *       const vec3 &FitSize;
+ *   - ready callback (called on render thread, may be empty):
+ *       std::function<VOID( model *, BOOL )> OnReady;
+ * RETURNS:
+ *   (std::shared_future<BOOL>) load success future.
+ */
+std::shared_future<BOOL> tse::model::LoadAsync( const std::string &FileName,
+                                                const matr &Transform, const vec3 &FitSize,
+                                                std::function<VOID( model *, BOOL )> OnReady )
+{
+  CancelLoad();
+  auto data = std::make_shared<LOAD_DATA>();
+  Pending = data;
+
+  return anim::Get().LoadAsync(FileName,
+    [FileName, Transform, FitSize, data]( UINT64 &Bytes ) -> BOOL
+    {
+      TSE_PROFILE("ModelDecode");
+      if (!Decode(FileName, Transform, FitSize, *data))
+        return FALSE;
+      data->IsStream = TRUE;
+      Bytes = data->Bytes;
+      return TRUE;
+    },
+    [this, data]( VOID ) -> BOOL
+    {
+      TSE_PROFILE("ModelUpload");
+      return Upload(*data);
+    },
+    [this, OnReady]( BOOL IsOk )
+    {
+      Pending.reset();
+      if (OnReady)
+        OnReady(this, IsOk);
+    }, this);
+} /* End of 'tse::model::LoadAsync' function */
 
 /***
  * PRIMITIVE MANAGER FUNCTIONS
@@ -481,6 +575,124 @@ tse::prim * tse::primitive_manager::PrimCreate( prim_type Type, INT NumOfV )
   return resource_manager::Add(prim().Create(Type, NumOfV));
 } /* End of 'tse::primitive_manager::PrimCreate' function */
 
+/* Create primitive from parsed source file function.
+ * Primitive keeps source file to be reloaded after eviction.
+ * ARGUMENTS:
+ *   - file name (*.OBJ model):
+ *       const std::string &FileName;
+ *   - transform matrix vertices were parsed with:
+ *       const matr &Transform;
+ *   - parsed vertex and index arrays (see 'prim::Parse'):
+ *       std::vector<vertex_std4> &V;
+ *       std::vector<INT> &Ind;
+ * RETURNS:
+ *   (prim *) created primitive interface.
+ */
+tse::prim * tse::primitive_manager::PrimCreate( const std::string &FileName, const matr &Transform,
+                                                std::vector<vertex_std4> &V, std::vector<INT> &Ind )
+{
+  prim *pr = PrimCreate(RndRef.MtlCreate(FileName), prim_type::TRIMESH, std::span(V), std::span(Ind));
+  pr->Source = FileName;
+  pr->SourceTransform = Transform;
+  return pr;
+} /* End of 'tse::primitive_manager::PrimCreate' function */
+
+/* Create primitive with asynchronous .OBJ loading function.
+ * Primitive is empty until file is parsed by loader thread and
+ * uploaded at frame start.
+ * ARGUMENTS:
+ *   - file name (*.OBJ model) to be load:
+ *       const std::string &FileName;
+ *   - transform matrix:
+ *       const matr &Transform;
+ *   - ready callback (render thread, may be empty):
+ *       std::function<VOID( prim *, BOOL )> OnReady;
+ * RETURNS:
+ *   (prim *) created primitive interface.
+ */
+tse::prim * tse::primitive_manager::PrimLoadAsync( const std::string &FileName,
+                                                   const matr &Transform,
+                                                   std::function<VOID( prim *, BOOL )> OnReady )
+{
+  prim *pr = PrimCreate(prim_type::TRIMESH, 0);
+  pr->Source = FileName;
+  pr->SourceTransform = Transform;
+  PrimLoad(pr, std::move(OnReady));
+  return pr;
+} /* End of 'tse::primitive_manager::PrimLoadAsync' function */
+
+/* Load primitive from source file asynchronously function.
+ * ARGUMENTS:
+ *   - primitive with source file:
+ *       prim *Pr;
+ *   - ready callback (render thread, may be empty):
+ *       std::function<VOID( prim *, BOOL )> OnReady;
+ * RETURNS: None.
+ */
+VOID tse::primitive_manager::PrimLoad( prim *Pr, std::function<VOID( prim *, BOOL )> OnReady )
+{
+  auto data = std::make_shared<std::pair<std::vector<vertex_std4>, std::vector<INT>>>();
+  std::string file_name = Pr->Source;
+  matr transform = Pr->SourceTransform;
+
+  Pr->IsPending = TRUE;
+  RndRef.LoadAsync(file_name,
+    [file_name, transform, data]( UINT64 &Bytes ) -> BOOL
+    {
+      TSE_PROFILE("PrimParse");
+      if (!prim::Parse(file_name, transform, data->first, data->second))
+        return FALSE;
+      Bytes = data->first.size() * sizeof(vertex_std4) + data->second.size() * sizeof(INT);
+      return TRUE;
+    },
+    [this, Pr, file_name, data]( VOID ) -> BOOL
+    {
+      TSE_PROFILE("PrimUpload");
+      /* Reloaded primitive keeps its material and placement */
+      matr tr = Pr->Transform;
+      Pr->Create(Pr->Mtl != nullptr ? Pr->Mtl : RndRef.MtlCreate(file_name), prim_type::TRIMESH,
+        std::span(data->first), std::span(data->second));
+      Pr->Transform = tr;
+      *data = {};
+      return TRUE;
+    },
+    [Pr, OnReady]( BOOL IsOk )
+    {
+      Pr->IsPending = FALSE;
+      if (OnReady)
+        OnReady(Pr, IsOk);
+    }, Pr);
+} /* End of 'tse::primitive_manager::PrimLoad' function */
+
+/* Cancel pending loads of primitive to be deleted function.
+ * ARGUMENTS:
+ *   - primitive pointer:
+ *       prim *Pr;
+ * RETURNS: None.
+ */
+VOID tse::primitive_manager::CancelLoads( prim *Pr )
+{
+  RndRef.LoaderCancel(Pr);
+} /* End of 'tse::primitive_manager::CancelLoads' function */
+
+/* Reload evicted primitive function.
+ * Primitive is empty until its source file is parsed again.
+ * ARGUMENTS:
+ *   - evicted primitive:
+ *       const prim *Pr;
+ * RETURNS: None.
+ */
+VOID tse::primitive_manager::PrimReload( const prim *Pr )
+{
+  if (Pr == nullptr || !Pr->IsEvicted)
+    return;
+  /* Primitive is stock entry: drawing through constant pointer may restore it */
+  prim *pr = const_cast<prim *>(Pr);
+  pr->IsEvicted = FALSE;
+  NumOfReloads++;
+  PrimLoad(pr, {});
+} /* End of 'tse::primitive_manager::PrimReload' function */
+
 /* Create primitive function.
  * ARGUMENTS:
  *   - primitive pointer:
@@ -493,4 +705,53 @@ VOID tse::primitive_manager::PrimFree( prim *Pr )
   resource_manager::Delete(Pr);
 } /* End of 'tse::primitive_manager::PrimFree' function */
 
+/* Obtain shared vertex array for primitive drawn with shader function.
+ * ARGUMENTS:
+ *   - primitive pointer:
+ *       const prim *Pr;
+ *   - shader to draw with:
+ *       const shader *Shd;
+ * RETURNS:
+ *   (UINT) vertex array (vertex buffer is bound to binding 0 at draw).
+ */
+UINT tse::primitive_manager::VertexArray( const prim *Pr, const shader *Shd )
+{
+  std::pair<UINT64, UINT64> key {Pr->FormatKey, Shd != nullptr ? Shd->LayoutKey : 0};
+  if (auto va = VertexArrays.find(key); va != VertexArrays.end())
+    return va->second;
+
+  /* Separate format: only fields layout is stored, buffer is bound per draw */
+  auto start = std::chrono::steady_clock::now();
+  UINT va;
+  glGenVertexArrays(1, &va);
+  glBindVertexArray(va);
+  if (Shd != nullptr && Pr->FormatKey != 0)
+    for (INT id = 0; id < semantic::NUM_OF_VERTEX; id++)
+      if (const shader::ATTR_INFO *a = Shd->Attribute(id); a != nullptr && Pr->VertexOffsets[id] != -1)
+      {
+        glEnableVertexAttribArray(a->Loc);
+        if (a->IsFloat)
+          glVertexAttribFormat(a->Loc, a->Components, GL_FLOAT, FALSE, Pr->VertexOffsets[id]);
+        else
+          glVertexAttribIFormat(a->Loc, a->Components, GL_INT, Pr->VertexOffsets[id]);
+        glVertexAttribBinding(a->Loc, 0);
+      }
+  glBindVertexArray(0);
+  VertexArraysSetupTime +=
+    std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - start).count();
+  return VertexArrays[key] = va;
+} /* End of 'tse::primitive_manager::VertexArray' function */
+
+/* Delete all shared vertex arrays function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::primitive_manager::VertexArraysClear( VOID )
+{
+  for (auto &va : VertexArrays)
+    glDeleteVertexArrays(1, &va.second);
+  VertexArrays.clear();
+  VertexArraysSetupTime = 0;
+} /* End of 'tse::primitive_manager::VertexArraysClear' function */
+
 /* END OF 'prim.cpp' FILE */
@@ -9,7 +9,7 @@
  *               Primitive declaration module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 01.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -39,20 +39,23 @@ namespace tse
   class prim : public resource
   {
     friend class render;
+    friend class primitive_manager;
  
   private:
     prim_type Type {};    // Primitive type
-    UINT VA {};           // Primitive vertex array
     UINT VBuf {};         // Vertex buffer
     UINT IBuf {};         // Index buffer
     INT NumOfElements {}; // Number of elements for OpenGL
+    INT FirstElement {};  // First element to draw
     matr Transform {};    // Primitive transformation matrix
+
+    // Source file vertices transformation (for reload after eviction)
+    matr SourceTransform {};
  
-    mutable BOOL IsVAUpdated = FALSE; // Vertex array update flag
- 
-    // Vertex parameters map (vertex attribute field, offset)
-    std::map<std::string, INT> VertexMap;
-    INT VertexStride {}; // Vertex stride in bytes
+    // Vertex fields offsets by vertex semantic id (-1 if absent)
+    INT VertexOffsets[semantic::NUM_OF_VERTEX] {};
+    INT VertexStride {};  // Vertex stride in bytes
+    UINT64 FormatKey {};  // Vertex format key (0 for empty vertex stream)
  
   public:
     material *Mtl {};     // Material pointer
@@ -97,22 +100,22 @@ namespace tse
         VertexStride = sizeof(vertex);
         Mtl = Mat;
  
+        for (auto &ofs : VertexOffsets)
+          ofs = -1;
         if constexpr (requires{vertex::P;})
-          VertexMap["InPosition"] = reinterpret_cast<INT_PTR>(&((vertex *)0)->P);
+          VertexOffsets[semantic::POSITION] = (INT)reinterpret_cast<INT_PTR>(&((vertex *)0)->P);
         if constexpr (requires{vertex::T;})
-          VertexMap["InTexCoord"] = reinterpret_cast<INT_PTR>(&((vertex *)0)->T);
+          VertexOffsets[semantic::TEXCOORD] = (INT)reinterpret_cast<INT_PTR>(&((vertex *)0)->T);
         if constexpr (requires{vertex::N;})
-          VertexMap["InNormal"] = reinterpret_cast<INT_PTR>(&((vertex *)0)->N);
+          VertexOffsets[semantic::NORMAL] = (INT)reinterpret_cast<INT_PTR>(&((vertex *)0)->N);
         if constexpr (requires{vertex::C;})
-          VertexMap["InColor"] = reinterpret_cast<INT_PTR>(&((vertex *)0)->C);
+          VertexOffsets[semantic::COLOR] = (INT)reinterpret_cast<INT_PTR>(&((vertex *)0)->C);
         if constexpr (requires{vertex::Tangent;})
-          VertexMap["InTangent"] =
-            reinterpret_cast<INT_PTR>(&((vertex *)0)->Tangent);
+          VertexOffsets[semantic::TANGENT] = (INT)reinterpret_cast<INT_PTR>(&((vertex *)0)->Tangent);
         if constexpr (requires{vertex::Bitangent;})
-          VertexMap["InBitangent"] =
-            reinterpret_cast<INT_PTR>(&((vertex *)0)->Bitangent);
-        /* Create OpenGL vertex array */
-        glGenVertexArrays(1, &VA);
+          VertexOffsets[semantic::BITANGENT] = (INT)reinterpret_cast<INT_PTR>(&((vertex *)0)->Bitangent);
+        /* Vertex arrays are shared between primitives of the same format */
+        FormatKey = Hash64(VertexOffsets, sizeof(VertexOffsets));
         if (V.size() != 0)
         {
           /* Collect min-max info */
@@ -124,16 +127,13 @@ namespace tse
           }
           /* Create OpenGL buffers */
           glGenBuffers(1, &VBuf);
-          /* Activate vertex array */
-          glBindVertexArray(VA);
           /* Activate vertex buffer */
           glBindBuffer(GL_ARRAY_BUFFER, VBuf);
           /* Store vertex data */
           glBufferData(GL_ARRAY_BUFFER, sizeof(vertex) * V.size(), V.data(),
             GL_STATIC_DRAW);
+          glBindBuffer(GL_ARRAY_BUFFER, 0);
         }
-        /* Disable vertex array */
-        glBindVertexArray(0);
  
         /* Indices */
         if (Ind.size() > 0)
@@ -151,15 +151,42 @@ namespace tse
         }
         else
           NumOfElements = (INT)V.size();
-        tse::logger::Info(std::format("PRIMITIVE created: {} vertices, {} triangles", V.size(), NumOfElements / 3));
+        MemSize = (VBuf != 0 ? sizeof(vertex) * V.size() : 0) + (IBuf != 0 ? sizeof(INT) * Ind.size() : 0);
+        TSE_LOGF(DBG, "PRIMITIVE created: {} vertices, {} triangles", V.size(), NumOfElements / 3);
         return *this;
       } /* End of 'Create' function */
  
-    /* Update primitive vertex array function.
-     * ARGUMENTS: None.
-     * RETURNS: Non.
+    /* Update primitive vertex data (streaming primitives) function.
+     * ARGUMENTS:
+     *   - new vertex array (same vertex type as on creation):
+     *       const std::span<vertex> &V;
+     * RETURNS: None.
      */
-    VOID UpdateVA( VOID ) const;
+    template<class vertex>
+      VOID Update( const std::span<vertex> &V )
+      {
+        if (VBuf == 0)
+          return;
+        /* Buffer orphaning: driver gives new storage, no wait for frames still reading the old one */
+        glBindBuffer(GL_ARRAY_BUFFER, VBuf);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(vertex) * V.size(), V.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        FirstElement = 0;
+        NumOfElements = (INT)V.size();
+        MemSize = sizeof(vertex) * V.size();
+      } /* End of 'Update' function */
+
+    /* Set primitive elements draw range function.
+     * ARGUMENTS:
+     *   - first element and number of elements to draw:
+     *       INT First, Count;
+     * RETURNS: None.
+     */
+    VOID SetDrawRange( INT First, INT Count )
+    {
+      FirstElement = First;
+      NumOfElements = Count;
+    } /* End of 'SetDrawRange' function */
  
     /* Primitive with empty vertex stream creation function.
      * ARGUMENTS:
@@ -187,11 +214,82 @@ namespace tse
                  const matr &Transform = matr::Identity(),
                  const vec3 &FitSize = vec3(1, 0, 0) );
 
+    /* Parse .OBJ file (any thread) function.
+     * ARGUMENTS:
+     *   - file name (*.OBJ model) to be load:
+     *       const std::string &FileName;
+     *   - transform matrix:
+     *       const matr &Transform;
+     *   - result vertex and index arrays:
+     *       std::vector<vertex_std4> &V;
+     *       std::vector<INT> &Ind;
+     * RETURNS:
+     *   (BOOL) TRUE if success.
+     */
+    static BOOL Parse( const std::string &FileName, const matr &Transform,
+                       std::vector<vertex_std4> &V, std::vector<INT> &Ind );
+
   }; /* End of 'prim' class */
  
   /* Set of primitives class */
   class model
   {
+  public:
+    /* Stored (*.G3DM) material structure */
+    struct STORE_MATERIAL
+    {
+      CHAR Name[300]; // Material name
+
+      /* Illumination coefficients */
+      mth::vec3<FLT> Ka, Kd, Ks; // Ambient, diffuse, specular coefficients
+      FLT Ph;                    // Phong power coefficient
+      FLT Trans;                 // Transparency factor
+      INT Tex[8];                // Texture references
+
+      CHAR ShaderStr[300];       // Shader string
+      INT Shader;                // Shader index (not used)
+    }; /* End of 'STORE_MATERIAL' struct */
+
+    /* Decoded model data (filled by 'Decode' on any thread, consumed by 'Upload') */
+    struct LOAD_DATA
+    {
+      /* Decoded primitive structure */
+      struct PRIM
+      {
+        std::vector<vertex_std4> V; // Transformed vertices
+        std::vector<INT> Ind;       // Indices
+        INT Mtl = -1;               // Material number
+      }; /* End of 'PRIM' structure */
+
+      /* Decoded texture structure */
+      struct TEX
+      {
+        std::string Name;                    // Texture name
+        std::shared_ptr<texture::MIPS> Mips; // Mip levels
+      }; /* End of 'TEX' structure */
+
+      std::string FileName;             // Model file name
+      UINT64 Bytes = 0;                 // File size
+      vec3 MinBB {0}, MaxBB {0};        // Transformed bound box
+      std::vector<PRIM> Prims;          // Primitives
+      std::vector<STORE_MATERIAL> Mtls; // Materials
+      std::vector<TEX> Texs;            // Textures
+      BOOL IsStream = FALSE;            // Textures streaming flag (placeholders until streamed)
+      INT Step = 0;                     // Upload progress (textures, then primitives)
+      std::vector<texture *> TexRes;    // Uploaded textures
+      std::vector<prim *> PrimRes;      // Uploaded primitives
+    }; /* End of 'LOAD_DATA' structure */
+
+  private:
+    std::shared_ptr<LOAD_DATA> Pending; // Not completed asynchronous load data
+
+    /* Cancel not completed asynchronous load function.
+     * Partially uploaded textures and primitives are freed.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID CancelLoad( VOID );
+
   public:
     matr Transform;      // Transformation matrix
     stock<prim *> Prims; // Stock of primitives
@@ -229,12 +327,82 @@ namespace tse
                   const matr &Transform = matr::Identity(),
                   const vec3 &FitSize = vec3(1, 0, 0) );
 
+    /* Load model from .G3DM asynchronously function.
+     * Model keeps previous primitives (empty at first) until new ones are
+     * uploaded, previous not completed load and load of destroyed model
+     * are cancelled.
+     * ARGUMENTS:
+     *   - file name (*.G3DM model) to be load:
+     *       const std::string &FileName;
+     *   - transform matrix:
+     *       const matr &Transform;
+     *   - fit size flag vector:
+     *       const vec3 &FitSize;
+     *   - ready callback (called on render thread, may be empty):
+     *       std::function<VOID( model *, BOOL )> OnReady;
+     * RETURNS:
+     *   (std::shared_future<BOOL>) load success future.
+     */
+    std::shared_future<BOOL> LoadAsync( const std::string &FileName,
+                                        const matr &Transform = matr::Identity(),
+                                        const vec3 &FitSize = vec3(1, 0, 0),
+                                        std::function<VOID( model *, BOOL )> OnReady = {} );
+
+    /* Decode model from *.G3DM file (any thread, no render calls) function.
+     * ARGUMENTS:
+     *   - file name (*.G3DM model) to be load:
+     *       const std::string &FileName;
+     *   - transform matrix:
+     *       const matr &Transform;
+     *   - fit size vector flag:
+     *       const vec3 &FitSize;
+     *   - decoded data:
+     *       LOAD_DATA &Data;
+     * RETURNS:
+     *   (BOOL) TRUE if success.
+     */
+    static BOOL Decode( const std::string &FileName, const matr &Transform,
+                        const vec3 &FitSize, LOAD_DATA &Data );
+
+    /* Upload decoded model (render thread, one bounded step per call) function.
+     * ARGUMENTS:
+     *   - decoded data:
+     *       LOAD_DATA &Data;
+     * RETURNS:
+     *   (BOOL) TRUE if model is complete.
+     */
+    BOOL Upload( LOAD_DATA &Data );
+
   }; /* End of model' class */
  
   /* Primitive manager */
   class primitive_manager : public resource_manager<prim>
   {
+  private:
+    // Shared vertex arrays by vertex format and shader attributes layout keys
+    std::map<std::pair<UINT64, UINT64>, UINT> VertexArrays;
+
+    /* Load primitive from source file asynchronously function.
+     * ARGUMENTS:
+     *   - primitive with source file:
+     *       prim *Pr;
+     *   - ready callback (render thread, may be empty):
+     *       std::function<VOID( prim *, BOOL )> OnReady;
+     * RETURNS: None.
+     */
+    VOID PrimLoad( prim *Pr, std::function<VOID( prim *, BOOL )> OnReady );
+
+    /* Cancel pending loads of primitive to be deleted function.
+     * ARGUMENTS:
+     *   - primitive pointer:
+     *       prim *Pr;
+     * RETURNS: None.
+     */
+    VOID CancelLoads( prim *Pr ) override;
+
   public:
+    DBL VertexArraysSetupTime = 0; // Total vertex arrays setup time (ms)
+
     /* Default type constructor function */
     primitive_manager( render &Rnd );
 
@@ -269,6 +437,48 @@ namespace tse
      *   (prim *) created primitive interface.
      */
     prim * PrimCreate( prim_type Type, INT NumOfV );
+
+    /* Create primitive from parsed source file function.
+     * Primitive keeps source file to be reloaded after eviction.
+     * ARGUMENTS:
+     *   - file name (*.OBJ model):
+     *       const std::string &FileName;
+     *   - transform matrix vertices were parsed with:
+     *       const matr &Transform;
+     *   - parsed vertex and index arrays (see 'prim::Parse'):
+     *       std::vector<vertex_std4> &V;
+     *       std::vector<INT> &Ind;
+     * RETURNS:
+     *   (prim *) created primitive interface.
+     */
+    prim * PrimCreate( const std::string &FileName, const matr &Transform,
+                       std::vector<vertex_std4> &V, std::vector<INT> &Ind );
+
+    /* Create primitive with asynchronous .OBJ loading function.
+     * Primitive is empty until file is parsed by loader thread and
+     * uploaded at frame start.
+     * ARGUMENTS:
+     *   - file name (*.OBJ model) to be load:
+     *       const std::string &FileName;
+     *   - transform matrix:
+     *       const matr &Transform;
+     *   - ready callback (render thread, may be empty):
+     *       std::function<VOID( prim *, BOOL )> OnReady;
+     * RETURNS:
+     *   (prim *) created primitive interface.
+     */
+    prim * PrimLoadAsync( const std::string &FileName,
+                          const matr &Transform = matr::Identity(),
+                          std::function<VOID( prim *, BOOL )> OnReady = {} );
+
+    /* Reload evicted primitive function.
+     * Primitive is empty until its source file is parsed again.
+     * ARGUMENTS:
+     *   - evicted primitive:
+     *       const prim *Pr;
+     * RETURNS: None.
+     */
+    VOID PrimReload( const prim *Pr );
  
     /* Create primitive function.
      * ARGUMENTS:
@@ -279,6 +489,33 @@ namespace tse
      */
     VOID PrimFree( prim *Pr );
 
+    /* Obtain shared vertex array for primitive drawn with shader function.
+     * ARGUMENTS:
+     *   - primitive pointer:
+     *       const prim *Pr;
+     *   - shader to draw with:
+     *       const shader *Shd;
+     * RETURNS:
+     *   (UINT) vertex array (vertex buffer is bound to binding 0 at draw).
+     */
+    UINT VertexArray( const prim *Pr, const shader *Shd );
+
+    /* Obtain number of shared vertex arrays function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) number of vertex arrays.
+     */
+    INT NumOfVertexArrays( VOID ) const
+    {
+      return (INT)VertexArrays.size();
+    } /* End of 'NumOfVertexArrays' function */
+
+    /* Delete all shared vertex arrays function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID VertexArraysClear( VOID );
+
   }; /* End of 'primitive_manager' class */
 
 } /* end of 'tse' namespace */
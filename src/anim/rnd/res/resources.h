@@ -9,7 +9,7 @@
  *               Common definitions module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 01.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -24,20 +24,145 @@ namespace tse
 {
   /* Forward class declaration reference */
   class render;
+  class resource;
+
+  /* Resource owner (manager) interface class */
+  class resource_owner
+  {
+  public:
+    /* Release resource with no handles left function.
+     * ARGUMENTS:
+     *   - resource pointer:
+     *       resource *Res;
+     * RETURNS: None.
+     */
+    virtual VOID Release( resource *Res ) = 0;
+  }; /* End of 'resource_owner' class */
 
   /* Base resource class (should be base class for all resources) */
   class resource
   {
     template<typename entry_type, typename index_type>
       friend class resource_manager;
+    template<typename entry_type>
+      friend class res_ref;
 
   protected:
-    render *Rnd {}; // Pointer to render object
+    render *Rnd {};           // Pointer to render object
+    resource_owner *Owner {}; // Resource manager
+    INT RefCnt = 0;           // Number of handles
+
+  public:
+    inline static UINT64 UseClock = 0; // Current use time (frame number, advanced by render)
+
+    SIZE_T MemSize = 0;         // Resident data size in bytes
+    std::string Source;         // Source file to reload from (empty if resource can't be evicted)
+    mutable UINT64 LastUse = 0; // Last use time
+    BOOL IsEvicted = FALSE;     // Data freed until next use flag
+    BOOL IsPending = FALSE;     // Loading in progress flag (not evictable)
+
+    /* Mark resource as used function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Touch( VOID ) const
+    {
+      LastUse = UseClock;
+    } /* End of 'Touch' function */
   }; /* End of 'resource' class */
 
+  /* Reference counted resource handle class.
+   * Resource is deleted from its manager when last handle is released,
+   * resources referenced only by plain pointers are never deleted automatically. */
+  template<typename entry_type>
+    class res_ref
+    {
+    private:
+      entry_type *Ptr = nullptr; // Referenced resource
+
+    public:
+      /* Class constructor.
+       * ARGUMENTS:
+       *   - resource pointer:
+       *       entry_type *NewPtr;
+       */
+      res_ref( entry_type *NewPtr = nullptr ) : Ptr(NewPtr)
+      {
+        if (Ptr != nullptr)
+          Ptr->RefCnt++;
+      } /* End of 'res_ref' function */
+
+      /* Copy constructor.
+       * ARGUMENTS:
+       *   - handle to copy:
+       *       const res_ref &Ref;
+       */
+      res_ref( const res_ref &Ref ) : res_ref(Ref.Ptr)
+      {
+      } /* End of 'res_ref' function */
+
+      /* Move constructor.
+       * ARGUMENTS:
+       *   - handle to move:
+       *       res_ref &&Ref;
+       */
+      res_ref( res_ref &&Ref ) : Ptr(Ref.Ptr)
+      {
+        Ref.Ptr = nullptr;
+      } /* End of 'res_ref' function */
+
+      /* Class destructor */
+      ~res_ref( VOID )
+      {
+        Reset();
+      } /* End of '~res_ref' function */
+
+      /* Assignment operator function.
+       * ARGUMENTS:
+       *   - handle to assign:
+       *       res_ref Ref;
+       * RETURNS:
+       *   (res_ref &) self reference.
+       */
+      res_ref & operator=( res_ref Ref )
+      {
+        std::swap(Ptr, Ref.Ptr);
+        return *this;
+      } /* End of 'operator=' function */
+
+      /* Release handle function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID Reset( VOID )
+      {
+        if (Ptr != nullptr && --Ptr->RefCnt == 0 && Ptr->Owner != nullptr)
+          Ptr->Owner->Release(Ptr);
+        Ptr = nullptr;
+      } /* End of 'Reset' function */
+
+      /* Obtain resource pointer functions.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (entry_type *) resource pointer.
+       */
+      entry_type * Get( VOID ) const
+      {
+        return Ptr;
+      } /* End of 'Get' function */
+      entry_type * operator->( VOID ) const
+      {
+        return Ptr;
+      } /* End of 'operator->' function */
+      operator entry_type *( VOID ) const
+      {
+        return Ptr;
+      } /* End of 'operator entry_type *' function */
+    }; /* End of 'res_ref' class */
+
   /* Resource manager class */
   template<typename entry_type, typename index_type = INT>
-    class resource_manager
+    class resource_manager : private resource_owner
     {
       // Check for correct entry resource class based on resource
       static_assert(std::is_convertible_v<entry_type, resource>,
@@ -72,6 +197,8 @@ namespace tse
 
       std::map<index_type, entry_ref> Stock; // Resource entries stock
       INT TotalRefCnt = 0;                   // Manager reference counter
+      INT NumOfEvictions = 0;                // Evicted resources counter
+      INT NumOfReloads = 0;                  // Reloaded resources counter
  
       /* Add to stock function.
        * ARGUMENTS:
@@ -86,12 +213,14 @@ namespace tse
         {
           entry_ref ref(Entry, TotalRefCnt);
           ref.Rnd = &RndRef;
+          ref.Owner = this;
           return &(Stock[TotalRefCnt++] = ref);
         }
         else
         {
           entry_ref ref(Entry, Entry.Name);
           ref.Rnd = &RndRef;
+          ref.Owner = this;
           return &(Stock[Entry.Name] = ref);
         }
       } /* End of 'Add' function */
@@ -123,8 +252,104 @@ namespace tse
         Stock.clear();
         return *this;
       } /* End of 'Clear' function */
+
+      /* Release resource with no handles left function.
+       * ARGUMENTS:
+       *   - resource pointer:
+       *       resource *Res;
+       * RETURNS: None.
+       */
+      VOID Release( resource *Res ) override
+      {
+        Delete(static_cast<entry_type *>(Res));
+      } /* End of 'Release' function */
+
+      /* Cancel pending loads of resource to be deleted function.
+       * ARGUMENTS:
+       *   - resource pointer:
+       *       entry_type *Entry;
+       * RETURNS: None.
+       */
+      virtual VOID CancelLoads( entry_type *Entry )
+      {
+      } /* End of 'CancelLoads' function */
  
     public:
+      SIZE_T Budget = 0; // Resident data budget in bytes (0 for unlimited)
+
+      /* Memory usage structure */
+      struct USAGE
+      {
+        INT Count = 0;          // Number of resources
+        INT Referenced = 0;     // Number of resources held by handles
+        INT Evicted = 0;        // Number of evicted resources
+        SIZE_T Bytes = 0;       // Resident data size
+        SIZE_T Budget = 0;      // Resident data budget (0 for unlimited)
+        INT Evictions = 0;      // Total evictions
+        INT Reloads = 0;        // Total reloads
+      }; /* End of 'USAGE' structure */
+
+      /* Obtain memory usage function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (USAGE) current usage.
+       */
+      USAGE Usage( VOID ) const
+      {
+        USAGE u;
+        for (auto &entry : Stock)
+        {
+          u.Count++;
+          u.Referenced += entry.second.RefCnt > 0;
+          u.Evicted += entry.second.IsEvicted;
+          u.Bytes += entry.second.IsEvicted ? 0 : entry.second.MemSize;
+        }
+        u.Budget = Budget;
+        u.Evictions = NumOfEvictions;
+        u.Reloads = NumOfReloads;
+        return u;
+      } /* End of 'Usage' function */
+
+      /* Evict least recently used resources over budget function.
+       * Only resources with source file which were not used in current and
+       * previous frames are evicted, they are reloaded on next use.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (INT) number of evicted resources.
+       */
+      INT Evict( VOID )
+      {
+        if (Budget == 0)
+          return 0;
+        SIZE_T bytes = 0;
+        std::vector<entry_ref *> lru;
+        for (auto &entry : Stock)
+          if (!entry.second.IsEvicted)
+          {
+            bytes += entry.second.MemSize;
+            if (!entry.second.Source.empty() && !entry.second.IsPending &&
+                entry.second.LastUse + 1 < resource::UseClock)
+              lru.push_back(&entry.second);
+          }
+        if (bytes <= Budget)
+          return 0;
+
+        std::sort(lru.begin(), lru.end(),
+          []( const entry_ref *A, const entry_ref *B ){ return A->LastUse < B->LastUse; });
+        INT n = 0;
+        for (auto *entry : lru)
+        {
+          if (bytes <= Budget)
+            break;
+          bytes -= entry->MemSize;
+          entry->Free();
+          entry->IsEvicted = TRUE;
+          n++;
+        }
+        NumOfEvictions += n;
+        return n;
+      } /* End of 'Evict' function */
+
       /* Find resource at stock function.
        * ARGUMENTS:
        *   - resource name to find:
@@ -150,6 +375,7 @@ namespace tse
       {
         if (Entry == nullptr)
           return *this;
+        CancelLoads(Entry);
         Entry->Free();
         auto find_entry =
           Stock.find(reinterpret_cast<entry_ref *>(Entry)->EntryRef);
@@ -0,0 +1,108 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : semantic.h
+ * PURPOSE     : Tough Space Exploration project.
+ *               Render resources module.
+ *               Interned semantic names module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __semantic_h_
+#define __semantic_h_
+
+/* Main program namespace */
+namespace tse
+{
+  /* Interned semantic names class.
+   * Shader attributes, uniforms and blocks names are mapped once to small
+   * integer ids, so reflection tables are flat arrays indexed by id. */
+  class semantic
+  {
+  private:
+    /* Obtain names table function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (std::vector<std::string> &) names by id.
+     */
+    static std::vector<std::string> & Names( VOID )
+    {
+      // Vertex semantics are preregistered with fixed ids
+      static std::vector<std::string> names
+      {
+        "InPosition", "InTexCoord", "InNormal", "InColor", "InTangent", "InBitangent"
+      };
+      return names;
+    } /* End of 'Names' function */
+
+  public:
+    /* Vertex attributes semantics */
+    enum : INT
+    {
+      POSITION,     // 'InPosition' attribute
+      TEXCOORD,     // 'InTexCoord' attribute
+      NORMAL,       // 'InNormal' attribute
+      COLOR,        // 'InColor' attribute
+      TANGENT,      // 'InTangent' attribute
+      BITANGENT,    // 'InBitangent' attribute
+      NUM_OF_VERTEX // Number of vertex semantics
+    };
+
+    /* Obtain (intern) semantic id by name function.
+     * ARGUMENTS:
+     *   - semantic name:
+     *       const std::string &Name;
+     * RETURNS:
+     *   (INT) semantic id.
+     */
+    static INT Id( const std::string &Name )
+    {
+      static std::map<std::string, INT> ids;
+      std::vector<std::string> &names = Names();
+
+      if (ids.empty())
+        for (INT i = 0; i < names.size(); i++)
+          ids[names[i]] = i;
+      if (auto id = ids.find(Name); id != ids.end())
+        return id->second;
+      names.push_back(Name);
+      return ids[Name] = (INT)names.size() - 1;
+    } /* End of 'Id' function */
+
+    /* Obtain semantic name by id function.
+     * ARGUMENTS:
+     *   - semantic id:
+     *       INT Id;
+     * RETURNS:
+     *   (const std::string &) semantic name.
+     */
+    static const std::string & Name( INT Id )
+    {
+      return Names()[Id];
+    } /* End of 'Name' function */
+
+    /* Obtain number of interned semantics function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) number of semantics.
+     */
+    static INT Count( VOID )
+    {
+      return (INT)Names().size();
+    } /* End of 'Count' function */
+
+  }; /* End of 'semantic' class */
+
+} /* end of 'tse' namespace */
+
+#endif /* __semantic_h_ */
+
+/* END OF 'semantic.h' FILE */
@@ -9,7 +9,7 @@
  *               Shaders implementation module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 02.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -34,9 +34,7 @@ tse::shader::shader( VOID )
  */
 tse::shader::shader( const std::string &FileNamePrefix )
 {
-  Name = FileNamePrefix;
-  Watcher.StopWatch();
-  Watcher.StartWatch(anim::Path() + "bin/shaders/" + Name);
+  Name = Dir = FileNamePrefix;
 } /* End of 'tse::shader::shader' function */
 
 /* Class destructor */
@@ -56,19 +54,24 @@ UINT tse::shader::Apply( VOID )
   return ProgId;
 } /* End of 'tse::shader::Apply' function */
 
-/* Update shader function.
- * ARGUMENTS: None.
+/* Swap program with other (rebuilt) shader function.
+ * ARGUMENTS:
+ *   - shader to swap program and reflection data with:
+ *       shader &Other;
  * RETURNS: None.
  */
-VOID tse::shader::Update( VOID )
+VOID tse::shader::Swap( shader &Other )
 {
-  if (Watcher.IsChanged())
-  {
-    Free();
-    Load();
-    Watcher.StartWatch("bin/shaders/" + Name);
-  }
-} /* End of 'tse::shader::Update' function */
+  std::swap(ProgId, Other.ProgId);
+  std::swap(IsFromCache, Other.IsFromCache);
+  std::swap(IsTexVariants, Other.IsTexVariants);
+  std::swap(LoadTime, Other.LoadTime);
+  std::swap(Deps, Other.Deps);
+  std::swap(Attributes, Other.Attributes);
+  std::swap(Uniforms, Other.Uniforms);
+  std::swap(SSBOBuffers, Other.SSBOBuffers);
+  std::swap(LayoutKey, Other.LayoutKey);
+} /* End of 'tse::shader::Swap' function */
 
 /* Update shader internal data info function.
  * ARGUMENTS: None.
@@ -115,7 +118,7 @@ VOID tse::shader::UpdateInfo( VOID )
   std::vector<std::tuple<INT, std::function<INT( INT, const CHAR * )>,
     std::function<VOID( UINT, UINT, INT, INT *, INT *,
                         GLenum *, CHAR * )>,
-    std::map<std::string, ATTR_INFO>&>> attr_data
+    std::vector<ATTR_INFO>&>> attr_data
   {
     {GL_ACTIVE_ATTRIBUTES, glGetAttribLocation, glGetActiveAttrib, Attributes},
     {GL_ACTIVE_UNIFORMS, glGetUniformLocation, glGetActiveUniform, Uniforms},
@@ -135,9 +138,11 @@ VOID tse::shader::UpdateInfo( VOID )
       GLenum type;
       std::get<2>(d)(ProgId, i, sizeof(name), nullptr, &size, &type, name);
       auto attr_info = attr_types[type];
-      INT loc = std::get<1>(d)(ProgId, name);
+      INT loc = std::get<1>(d)(ProgId, name), id = semantic::Id(name);
  
-      std::get<3>(d)[name] =
+      if (id >= std::get<3>(d).size())
+        std::get<3>(d).resize(id + 1);
+      std::get<3>(d)[id] =
       {
         std::get<0>(attr_info),
         std::get<1>(attr_info),
@@ -161,8 +166,20 @@ VOID tse::shader::UpdateInfo( VOID )
     INT bind;
     glGetProgramResourceiv(ProgId, GL_SHADER_STORAGE_BLOCK, idx,
       1, prop, 1, nullptr, &bind);
-    SSBOBuffers[name] = {name, idx, bind};
+    INT id = semantic::Id(name);
+    if (id >= SSBOBuffers.size())
+      SSBOBuffers.resize(id + 1);
+    SSBOBuffers[id] = {name, idx, bind};
   }
+
+  /* Vertex layout key */
+  LayoutKey = Hash64(nullptr, 0);
+  for (INT id = 0; id < semantic::NUM_OF_VERTEX; id++)
+    if (const ATTR_INFO *a = Attribute(id); a != nullptr)
+    {
+      INT data[] {id, a->Loc, a->Components, a->IsFloat};
+      LayoutKey = Hash64(data, sizeof(data), LayoutKey);
+    }
 } /* End of 'tse::shader::UpdateInfo' function */
 
 /* Save text to log file function.
@@ -190,91 +207,206 @@ VOID tse::shader::Log( const std::string &Stage, const std::string &Text )
  */
 std::string tse::shader::LoadTextFile( const std::string &FileName )
 {
-  std::ifstream f(anim::Path() + FileName);
- 
-  return std::string((std::istreambuf_iterator<char>(f)),
-                     std::istreambuf_iterator<char>());
+  /* Hot reload watches loose files, so they are preferred to packed ones */
+  return vfs::ReadText(anim::Path() + FileName, TRUE);
 } /* End of 'tse::shader::LoadTextFile' function */
 
-/* Load shader function.
+/* Obtain program binary cache file name function.
  * ARGUMENTS: None.
  * RETURNS:
- *   (shader &) self reference.
+ *   (std::string) cache file name.
  */
-tse::shader & tse::shader::Load( VOID )
+std::string tse::shader::CacheFileName( VOID ) const
 {
-  /* Load common shader include 'commondf.glsl' file */
-  static std::string CommonShaderIncludes =
-    LoadTextFile("bin/shaders/includes/commondf.glsl");
+  if (VariantKey != 0)
+    return anim::Path() + std::format("bin/shaders/~cache/{}_{:016X}.bin", Dir, VariantKey);
+  return anim::Path() + "bin/shaders/~cache/" + Dir + ".bin";
+} /* End of 'tse::shader::CacheFileName' function */
 
-  /* Shader file load structure */
-  struct
+/* Load program from binary cache function.
+ * ARGUMENTS:
+ *   - program sources key:
+ *       UINT64 Key;
+ *   - created program id:
+ *       INT &Prg;
+ * RETURNS:
+ *   (BOOL) TRUE if program is loaded, FALSE on cache miss or mismatch.
+ */
+BOOL tse::shader::LoadBinary( UINT64 Key, INT &Prg )
+{
+  std::fstream f(CacheFileName(), std::fstream::in | std::fstream::binary);
+  if (!f.is_open())
+    return FALSE;
+
+  /* Header: signature, key, binary format, binary length */
+  DWORD sign = 0;
+  UINT64 key = 0;
+  GLenum format = 0;
+  INT len = 0;
+  f.read((CHAR *)&sign, sizeof(sign));
+  f.read((CHAR *)&key, sizeof(key));
+  f.read((CHAR *)&format, sizeof(format));
+  f.read((CHAR *)&len, sizeof(len));
+  if (!f || sign != *(DWORD *)"TSPB" || key != Key || len <= 0)
+    return FALSE;
+  std::vector<BYTE> bin(len);
+  if (!f.read((CHAR *)bin.data(), len))
+    return FALSE;
+
+  /* Driver may still reject binary (e.g. after update) - fall back to compilation */
+  INT prg = glCreateProgram(), res = 0;
+  glProgramBinary(prg, format, bin.data(), len);
+  glGetProgramiv(prg, GL_LINK_STATUS, &res);
+  if (res != 1)
   {
-    const CHAR *Name;   // Shader file suffix name
-    UINT Type;          // Shader OpenGL type
-    const CHAR *Define; // Mandatory define and shader version
-    UINT Id;            // Shader id created by OpenGL
-  } shds[] =
+    glDeleteProgram(prg);
+    return FALSE;
+  }
+  Prg = prg;
+  return TRUE;
+} /* End of 'tse::shader::LoadBinary' function */
+
+/* Save program to binary cache function.
+ * ARGUMENTS:
+ *   - program sources key:
+ *       UINT64 Key;
+ *   - program id:
+ *       INT Prg;
+ * RETURNS: None.
+ */
+VOID tse::shader::SaveBinary( UINT64 Key, INT Prg )
+{
+  INT len = 0;
+  glGetProgramiv(Prg, GL_PROGRAM_BINARY_LENGTH, &len);
+  if (len <= 0)
+    return;
+  std::vector<BYTE> bin(len);
+  GLenum format = 0;
+  glGetProgramBinary(Prg, len, &len, &format, bin.data());
+
+  std::error_code ec;
+  std::filesystem::create_directories(anim::Path() + "bin/shaders/~cache", ec);
+  std::fstream f(CacheFileName(), std::fstream::out | std::fstream::binary);
+  if (!f.is_open())
+    return;
+  f.write("TSPB", 4);
+  f.write((CHAR *)&Key, sizeof(Key));
+  f.write((CHAR *)&format, sizeof(format));
+  f.write((CHAR *)&len, sizeof(len));
+  f.write((CHAR *)bin.data(), len);
+} /* End of 'tse::shader::SaveBinary' function */
+
+/* Shader stages table */
+static const struct
+{
+  const CHAR *Name;   // Shader file suffix name
+  UINT Type;          // Shader OpenGL type
+  const CHAR *Define; // Mandatory define and shader version
+} ShaderStages[tse::shader::MaxStages] =
+{
+  {"vert", GL_VERTEX_SHADER,          "#version 460\n#define VERTEX_SHADER 1\n"},
+  {"ctrl", GL_TESS_CONTROL_SHADER,    "#version 460\n#define TESS_CONTROL_SHADER 1\n"},
+  {"eval", GL_TESS_EVALUATION_SHADER, "#version 460\n#define TESS_EVALUATION_SHADER 1\n"},
+  {"geom", GL_GEOMETRY_SHADER,        "#version 460\n#define GEOMETRY_SHADER 1\n"},
+  {"comp", GL_COMPUTE_SHADER,         "#version 460\n#define COMPUTE_SHADER 1\n"},
+  {"frag", GL_FRAGMENT_SHADER,        "#version 460\n#define FRAGMENT_SHADER 1\n"},
+};
+
+/* Load shader function.
+ * ARGUMENTS:
+ *   - asynchronous compilation flag (status is checked later in 'Poll'):
+ *       BOOL IsAsync;
+ * RETURNS:
+ *   (shader &) self reference.
+ */
+tse::shader & tse::shader::Load( BOOL IsAsync )
+{
+  TSE_PROFILE("ShaderLoad");
+  /* Load common shader include 'commondf.glsl' file (again after hot reload reported its change) */
+  if (!IsCommonIncludesValid)
   {
-    {"vert", GL_VERTEX_SHADER,          "#version 460\n#define VERTEX_SHADER 1\n",          0},
-    {"ctrl", GL_TESS_CONTROL_SHADER,    "#version 460\n#define TESS_CONTROL_SHADER 1\n",    0},
-    {"eval", GL_TESS_EVALUATION_SHADER, "#version 460\n#define TESS_EVALUATION_SHADER 1\n", 0},
-    {"geom", GL_GEOMETRY_SHADER,        "#version 460\n#define GEOMETRY_SHADER 1\n",        0},
-    {"comp", GL_COMPUTE_SHADER,         "#version 460\n#define COMPUTE_SHADER 1\n",         0},
-    {"frag", GL_FRAGMENT_SHADER,        "#version 460\n#define FRAGMENT_SHADER 1\n",        0},
-  };
-  INT ns = sizeof(shds) / sizeof(shds[0]), res;
+    CommonIncludes = LoadTextFile("bin/shaders/includes/commondf.glsl");
+    IsCommonIncludesValid = TRUE;
+  }
   BOOL is_ok = TRUE;
-  CHAR Buf[3000];
+
+  LoadStart = std::chrono::steady_clock::now();
+  Deps = {"includes/commondf.glsl", Dir + "/incl.glsl"};
+  IsFromCache = FALSE;
+  IsPending = FALSE;
+  PendingProg = 0;
+  for (auto &id : StageIds)
+    id = 0;
 
   /* Load local shader include 'incl.glsl' file */
   std::string LocalShaderIncludes =
-    LoadTextFile("bin/shaders/" + Name + "/incl.glsl");
+    LoadTextFile("bin/shaders/" + Dir + "/incl.glsl");
 
-  for (INT i = 0; i < ns; i++)
+  /* Variant defines block */
+  std::string defines;
+  for (auto &d : Defines)
+    defines += "#define " + d + "\n";
+
+  /* Load all stages texts and evaluate program key */
+  std::string txts[MaxStages];
+  static const std::string DriverInfo =
+    std::string((CHAR *)glGetString(GL_RENDERER)) + (CHAR *)glGetString(GL_VERSION) +
+    (CHAR *)glGetString(GL_VENDOR);
+  UINT64 key = Hash64(DriverInfo);
+  key = Hash64(CommonIncludes, key);
+  key = Hash64(LocalShaderIncludes, key);
+  key = Hash64(defines, key);
+  IsTexVariants = LocalShaderIncludes.find("TEX_VARIANTS") != std::string::npos;
+  for (INT i = 0; i < MaxStages; i++)
   {
-    /* Load text file */
-    std::string txt =
-      LoadTextFile("bin/shaders/" + Name + "/" + shds[i].Name + ".glsl");
-    if (txt == "")
+    Deps.push_back(Dir + "/" + ShaderStages[i].Name + ".glsl");
+    txts[i] = LoadTextFile("bin/shaders/" + Deps.back());
+    IsTexVariants = IsTexVariants || txts[i].find("TEX_VARIANTS") != std::string::npos;
+    if (txts[i] == "" && !(i > 0 && i < MaxStages - 1))
     {
-      if (i > 0 && i < ns - 1)
-        continue;
-      Log(shds[i].Name, "Error load file");
+      Log(ShaderStages[i].Name, "Error load file");
       is_ok = FALSE;
       break;
     }
+    key = Hash64(ShaderStages[i].Define, strlen(ShaderStages[i].Define), key);
+    key = Hash64(txts[i], key);
+  }
+  PendingKey = key;
+
+  /* Program binary cache */
+  INT prg = 0;
+  IsFromCache = is_ok && LoadBinary(key, prg);
+
+  /* Issue all stages compilation: no status queries here to let driver compile in parallel */
+  for (INT i = 0; is_ok && !IsFromCache && i < MaxStages; i++)
+  {
+    /* Skip absent optional stages */
+    const std::string &txt = txts[i];
+    if (txt == "")
+      continue;
     /* Create shader */
-    if ((shds[i].Id = glCreateShader(shds[i].Type)) == 0)
+    if ((StageIds[i] = glCreateShader(ShaderStages[i].Type)) == 0)
     {
-      Log(shds[i].Name, "Error shader creation");
+      Log(ShaderStages[i].Name, "Error shader creation");
       is_ok = FALSE;
       break;
     }
     /* Attach text to shader */
     const CHAR *Src[] = 
     {
-      shds[i].Define,
-      CommonShaderIncludes.c_str(),
+      ShaderStages[i].Define,
+      defines.c_str(),
+      CommonIncludes.c_str(),
       LocalShaderIncludes.c_str(),
       txt.c_str()
     };
     /* Set shader program source text */
-    glShaderSource(shds[i].Id, sizeof(Src) / sizeof(Src[0]), Src, nullptr);
+    glShaderSource(StageIds[i], sizeof(Src) / sizeof(Src[0]), Src, nullptr);
     /* Compile shader */
-    glCompileShader(shds[i].Id);
-    glGetShaderiv(shds[i].Id, GL_COMPILE_STATUS, &res);
-    if (res != 1)
-    {
-      glGetShaderInfoLog(shds[i].Id, sizeof(Buf), &res, Buf);
-      Log(shds[i].Name, Buf);
-      is_ok = FALSE;
-      break;
-    }
+    glCompileShader(StageIds[i]);
   }
   /* Create program */
-  INT prg = 0;
-  if (is_ok)
+  if (is_ok && !IsFromCache)
   {
     if ((prg = glCreateProgram()) == 0)
     {
@@ -284,42 +416,119 @@ tse::shader & tse::shader::Load( VOID )
     else
     {
       /* Attach shaders to program */
-      for (INT i = 0; i < ns; i++)
-        if (shds[i].Id != 0)
-          glAttachShader(prg, shds[i].Id);
+      for (INT i = 0; i < MaxStages; i++)
+        if (StageIds[i] != 0)
+          glAttachShader(prg, StageIds[i]);
       /* Link shader program */
+      glProgramParameteri(prg, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
       glLinkProgram(prg);
-      glGetProgramiv(prg, GL_LINK_STATUS, &res);
+    }
+  }
+  PendingProg = prg;
+  IsPending = is_ok;
+  if (!is_ok)
+    Discard();
+
+  /* Synchronous load */
+  if (!IsAsync || !is_ok)
+    Finish();
+  return *this;
+} /* End of 'tse::shader::Load' function */
+
+/* Check asynchronous compilation completion function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (BOOL) TRUE if shader is not compiling anymore, FALSE otherwise.
+ */
+BOOL tse::shader::Poll( VOID )
+{
+  if (!IsPending)
+    return TRUE;
+  /* Without KHR_parallel_shader_compile status query blocks until link is done */
+  if (GLEW_KHR_parallel_shader_compile)
+  {
+    INT is_done = 0;
+    glGetProgramiv(PendingProg, GL_COMPLETION_STATUS_KHR, &is_done);
+    if (!is_done)
+      return FALSE;
+  }
+  Finish();
+  return TRUE;
+} /* End of 'tse::shader::Poll' function */
+
+/* Finish shader loading (check compile and link status) function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::shader::Finish( VOID )
+{
+  TSE_PROFILE("ShaderFinish");
+
+  BOOL is_ok = IsPending;
+  INT res;
+  CHAR Buf[3000];
+
+  if (is_ok && !IsFromCache)
+  {
+    /* Check compilation */
+    for (INT i = 0; i < MaxStages; i++)
+      if (StageIds[i] != 0)
+      {
+        glGetShaderiv(StageIds[i], GL_COMPILE_STATUS, &res);
+        if (res != 1)
+        {
+          glGetShaderInfoLog(StageIds[i], sizeof(Buf), &res, Buf);
+          Log(ShaderStages[i].Name, Buf);
+          is_ok = FALSE;
+        }
+      }
+    /* Check linking */
+    if (is_ok)
+    {
+      glGetProgramiv(PendingProg, GL_LINK_STATUS, &res);
       if (res != 1)
       {
-        glGetProgramInfoLog(prg, sizeof(Buf), &res, Buf);
+        glGetProgramInfoLog(PendingProg, sizeof(Buf), &res, Buf);
         Log(Name, Buf);
         is_ok = FALSE;
       }
+      else
+        SaveBinary(PendingKey, PendingProg);
     }
   }
   /* Error handle */
   if (!is_ok)
-  {
-    /* Remove all shaders */
-    for (INT i = 0; i < ns; i++)
-      if (shds[i].Id != 0)
-      {
-        if (prg != 0)
-          glDetachShader(prg, shds[i].Id);
-        glDeleteShader(shds[i].Id);
-      }
-    /* Remove program */
-    if (prg != 0)
-      glDeleteProgram(prg);
-    prg = 0;
-  }
-  else
-    tse::logger::Info("SHADER created: " + Name);
-  ProgId = prg;
+    Discard();
+  ProgId = PendingProg;
+  PendingProg = 0;
+  IsPending = FALSE;
   UpdateInfo();
-  return *this;
-} /* End of 'tse::shader::Load' function */
+  LoadTime = std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - LoadStart).count();
+  if (is_ok)
+    TSE_LOGF(DBG, "SHADER created: {} ({}, {:.2f} ms)", Name,
+      IsFromCache ? "binary cache" : "compiled", LoadTime);
+} /* End of 'tse::shader::Finish' function */
+
+/* Remove pending program and stages function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::shader::Discard( VOID )
+{
+  /* Remove all shaders */
+  for (auto &id : StageIds)
+    if (id != 0)
+    {
+      if (PendingProg != 0)
+        glDetachShader(PendingProg, id);
+      glDeleteShader(id);
+      id = 0;
+    }
+  /* Remove program */
+  if (PendingProg != 0)
+    glDeleteProgram(PendingProg);
+  PendingProg = 0;
+} /* End of 'tse::shader::Discard' function */
 
 /* Free shader function.
  * ARGUMENTS: None.
@@ -327,10 +536,14 @@ tse::shader & tse::shader::Load( VOID )
  */
 VOID tse::shader::Free( VOID )
 {
+  if (IsPending)
+  {
+    Discard();
+    IsPending = FALSE;
+  }
   if (ProgId == 0 || !glIsProgram(ProgId))
     return;
 
-  Watcher.StopWatch();
   UINT shdrs[5];
   INT n;
   glGetAttachedShaders(ProgId, 5, &n, shdrs);
@@ -347,18 +560,76 @@ VOID tse::shader::Free( VOID )
  * SHADER MANAGER FUNCTIONS
  ***/
 
+/* Account loaded shader statistics function.
+ * ARGUMENTS:
+ *   - loaded shader:
+ *       const shader *Shd;
+ * RETURNS: None.
+ */
+VOID tse::shader_manager::AccountLoad( const shader *Shd )
+{
+  (Shd->IsFromCache ? LoadStats.CacheHits : LoadStats.CacheMisses)++;
+  LoadStats.LoadTime += Shd->LoadTime;
+} /* End of 'tse::shader_manager::AccountLoad' function */
+
 /* Create shader function.
  * ARGUMENTS:
  *   - shader file name prefix:
  *       const std::string &FileNamePrefix;
+ *   - asynchronous compilation flag (materials use default shader until ready):
+ *       BOOL IsAsync;
  * RETURNS:
  *   (shader *) created primitive interface.
  */
-tse::shader * tse::shader_manager::ShdCreate( const std::string &FileNamePrefix )
+tse::shader * tse::shader_manager::ShdCreate( const std::string &FileNamePrefix, BOOL IsAsync )
 {
-  return resource_manager::Add(shader(FileNamePrefix).Load());
+  shader *shd = resource_manager::Add(shader(FileNamePrefix).Load(IsAsync));
+
+  if (shd->IsPending)
+    NumOfPending++;
+  else
+    AccountLoad(shd);
+  return shd;
 } /* End of 'tse::shader_manager::ShdCreate' function */
 
+/* Obtain shader variant (compiled lazily and asynchronously) function.
+ * ARGUMENTS:
+ *   - base shader:
+ *       shader *Base;
+ *   - variant defines ("NAME" or "NAME VALUE"):
+ *       std::vector<std::string> Defines;
+ * RETURNS:
+ *   (shader *) variant shader interface.
+ */
+tse::shader * tse::shader_manager::ShdVariant( shader *Base, std::vector<std::string> Defines )
+{
+  if (Defines.empty())
+    return Base;
+
+  /* Defines order does not matter */
+  std::sort(Defines.begin(), Defines.end());
+  UINT64 key = 0xCBF29CE484222325;
+  for (auto &d : Defines)
+    key = Hash64(d + "\n", key);
+  if (auto v = Variants.find({Base, key}); v != Variants.end())
+    return v->second;
+
+  shader var(Base->Dir);
+  var.Name += "{";
+  for (auto &d : Defines)
+    var.Name += (&d == &Defines[0] ? "" : ",") + d;
+  var.Name += "}";
+  var.Defines = Defines;
+  var.VariantKey = key;
+  shader *shd = resource_manager::Add(var.Load(TRUE));
+
+  if (shd->IsPending)
+    NumOfPending++;
+  else
+    AccountLoad(shd);
+  return Variants[{Base, key}] = shd;
+} /* End of 'tse::shader_manager::ShdVariant' function */
+
 /* Class constructor.
  * ARGUMENTS:
  *   - render instance reference:
@@ -381,12 +652,114 @@ tse::shader_manager::~shader_manager( VOID )
  */
 VOID tse::shader_manager::Update( VOID )
 {
-  if (Watcher.IsChanged())
+  TSE_PROFILE("ShaderUpdate");
+  /* Asynchronous compilation results */
+  if (NumOfPending > 0)
   {
+    NumOfPending = 0;
     for (auto &shd : Stock)
-      shd.second.Update();
-    Watcher.StartWatch(anim::Path() + "bin/shaders/");
+      if (shd.second.IsPending)
+      {
+        if (shd.second.Poll())
+          AccountLoad(&shd.second);
+        else
+          NumOfPending++;
+      }
+    if (NumOfPending == 0)
+    {
+      LoadStats.AllReadyTime = std::chrono::duration<DBL, std::milli>(
+        std::chrono::steady_clock::now() - anim::Get().StartupTime).count();
+      tse::logger::Info(std::format("All shaders ready in {:.1f} ms since startup ({} compiled, {} from cache, {:.1f} ms total)",
+        LoadStats.AllReadyTime, LoadStats.CacheMisses, LoadStats.CacheHits, LoadStats.LoadTime));
+    }
   }
+
+  /* Hot reload: editors save files in several steps - wait until changes settle */
+  auto now = std::chrono::steady_clock::now();
+  for (auto &file : Watcher.Changes())
+  {
+    ChangedFiles.insert(file);
+    LastChangeTime = now;
+  }
+  if (!ChangedFiles.empty() &&
+      std::chrono::duration<DBL, std::milli>(now - LastChangeTime).count() >= DebounceTime)
+  {
+    Rebuild();
+    ChangedFiles.clear();
+  }
+
+  /* Swap successfully rebuilt programs, failed ones keep previous program */
+  for (auto r = Reloads.begin(); r != Reloads.end(); )
+    if (r->second.Poll())
+    {
+      if (r->second.ProgId != 0)
+      {
+        r->first->Swap(r->second);
+        tse::logger::Info(std::format("SHADER reloaded: {} ({:.2f} ms)", r->first->Name, r->first->LoadTime));
+      }
+      else
+        tse::logger::Warn("SHADER reload failed, previous program kept: " + r->first->Name);
+      r->second.Free();
+      r = Reloads.erase(r);
+    }
+    else
+      r++;
 } /* End of 'tse::shader_manager::Update' function */
 
+/* Start rebuilding shaders affected by changed files function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::shader_manager::Rebuild( VOID )
+{
+  /* Source file -> dependent shaders map */
+  std::map<std::string, std::vector<shader *>> dependents;
+  for (auto &shd : Stock)
+    for (auto &dep : shd.second.Deps)
+      dependents[dep].push_back(&shd.second);
+
+  std::set<shader *> affected;
+  for (auto &file : ChangedFiles)
+  {
+    /* Common include text is shared by all loads: re-read it before rebuilding */
+    if (file == "" || file == "includes/commondf.glsl")
+      shader::IsCommonIncludesValid = FALSE;
+    if (file == "")
+    {
+      /* Unknown changes - rebuild everything */
+      for (auto &shd : Stock)
+        affected.insert(&shd.second);
+    }
+    else if (auto d = dependents.find(file); d != dependents.end())
+      affected.insert(d->second.begin(), d->second.end());
+  }
+
+  for (auto *shd : affected)
+  {
+    /* Restart already running rebuild */
+    if (auto r = Reloads.find(shd); r != Reloads.end())
+    {
+      r->second.Free();
+      Reloads.erase(r);
+    }
+    shader fresh;
+    fresh.Name = shd->Name;
+    fresh.Dir = shd->Dir;
+    fresh.Defines = shd->Defines;
+    fresh.VariantKey = shd->VariantKey;
+    Reloads[shd] = fresh;
+    Reloads[shd].Load(TRUE);
+  }
+} /* End of 'tse::shader_manager::Rebuild' function */
+
+/* Wait all asynchronously compiling shaders function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::shader_manager::WaitAll( VOID )
+{
+  while (NumOfPending > 0)
+    Update();
+} /* End of 'tse::shader_manager::WaitAll' function */
+
 /* END OF 'shd.cpp' FILE */
@@ -9,7 +9,7 @@
  *               Shaders declaration module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 02.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -20,6 +20,7 @@
 #define __shd_h_
 
 #include "resources.h"
+#include "semantic.h"
 
 /* Main program namespace */
 namespace tse
@@ -30,9 +31,19 @@ namespace tse
   class shader : public resource
   {
     friend class render;
+    friend class shader_manager;
+
+  public:
+    static const INT MaxStages = 6; // Number of program stages (vert, ctrl, eval, geom, comp, frag)
 
   private:
-    dir_watcher Watcher; // Directory watcher
+    UINT StageIds[MaxStages] {};                     // Compiling stages ids
+    UINT PendingProg = 0;                            // Compiling (linking) program id
+    UINT64 PendingKey = 0;                           // Compiling program sources key
+    std::chrono::steady_clock::time_point LoadStart; // Load start time
+
+    inline static std::string CommonIncludes;         // Common include 'includes/commondf.glsl' text
+    inline static BOOL IsCommonIncludesValid = FALSE; // Common include is read and not changed since flag
 
     /* Save text to log file function.
      * ARGUMENTS:
@@ -52,14 +63,63 @@ namespace tse
      *   (std::string) load text.
      */
     std::string LoadTextFile( const std::string &FileName );
+
+    /* Obtain program binary cache file name function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (std::string) cache file name.
+     */
+    std::string CacheFileName( VOID ) const;
+
+    /* Load program from binary cache function.
+     * ARGUMENTS:
+     *   - program sources key:
+     *       UINT64 Key;
+     *   - created program id:
+     *       INT &Prg;
+     * RETURNS:
+     *   (BOOL) TRUE if program is loaded, FALSE on cache miss or mismatch.
+     */
+    BOOL LoadBinary( UINT64 Key, INT &Prg );
+
+    /* Save program to binary cache function.
+     * ARGUMENTS:
+     *   - program sources key:
+     *       UINT64 Key;
+     *   - program id:
+     *       INT Prg;
+     * RETURNS: None.
+     */
+    VOID SaveBinary( UINT64 Key, INT Prg );
+
+    /* Finish shader loading (check compile and link status) function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Finish( VOID );
+
+    /* Remove pending program and stages function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Discard( VOID );
  
   public:
     /* Load shader function.
-     * ARGUMENTS: None.
+     * ARGUMENTS:
+     *   - asynchronous compilation flag (status is checked later in 'Poll'):
+     *       BOOL IsAsync;
      * RETURNS:
      *   (shader &) self reference.
      */
-    shader & Load( VOID );
+    shader & Load( BOOL IsAsync = FALSE );
+
+    /* Check asynchronous compilation completion function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (BOOL) TRUE if shader is not compiling anymore, FALSE otherwise.
+     */
+    BOOL Poll( VOID );
 
     /* Free shader function.
      * ARGUMENTS: None.
@@ -68,8 +128,16 @@ namespace tse
     VOID Free( VOID );
  
   public:
-    std::string Name; // Shader name
-    UINT ProgId;      // Shader program Id
+    std::string Name;           // Shader name (unique, variant defines included)
+    std::string Dir;            // Shader directory name (in 'bin/shaders')
+    std::vector<std::string> Defines; // Variant defines ("NAME" or "NAME VALUE")
+    UINT64 VariantKey = 0;      // Variant defines key (0 for base shader)
+    BOOL IsTexVariants = FALSE; // Shader sources use 'TEX_VARIANTS' (texture slots variants supported) flag
+    UINT ProgId = 0;            // Shader program Id (0 while compiling)
+    BOOL IsPending = FALSE;     // Asynchronous compilation is in progress flag
+    BOOL IsFromCache = FALSE;   // Program was loaded from binary cache flag
+    DBL LoadTime = 0;           // Last load time (ms)
+    std::vector<std::string> Deps; // Source files (relative to 'bin/shaders') program is built from
  
     /* Shader input attributes and uniforms information structure */
     struct ATTR_INFO
@@ -78,21 +146,59 @@ namespace tse
       INT Components;    // Number of components
       BOOL IsFloat;      // Float value flag (otherwise integer)
       INT MatrRows;      // For matrix number of rows
-      INT Loc;           // Shader attribute location
+      INT Loc = -1;      // Shader attribute location (-1 if absent)
     }; /* End of 'ATTR_INFO' structure */
  
     /* Shader buffer block information structure */
     struct BLOCK_INFO
     {
       std::string SType; // String type like shader
-      INT Index;         // Buffer block index
-      INT Bind;          // Buffer bind point
+      INT Index = -1;    // Buffer block index (-1 if absent)
+      INT Bind = -1;     // Buffer bind point
     }; /* End of 'BLOCK_INFO' structure */
  
-    // Attributes and uniforms information
-    std::map<std::string, ATTR_INFO> Attributes, Uniforms;
-    // Shader storage blocks informations (type, index, bind point)
-    std::map<std::string, BLOCK_INFO> SSBOBuffers;
+    // Attributes and uniforms information (flat tables indexed by semantic id)
+    std::vector<ATTR_INFO> Attributes, Uniforms;
+    // Shader storage blocks informations (type, index, bind point) by semantic id
+    std::vector<BLOCK_INFO> SSBOBuffers;
+    // Vertex attributes layout key (shaders with equal keys share vertex arrays)
+    UINT64 LayoutKey = 0;
+
+    /* Obtain attribute information function.
+     * ARGUMENTS:
+     *   - semantic id:
+     *       INT Id;
+     * RETURNS:
+     *   (const ATTR_INFO *) attribute information or nullptr if absent.
+     */
+    const ATTR_INFO * Attribute( INT Id ) const
+    {
+      return Id < Attributes.size() && Attributes[Id].Loc != -1 ? &Attributes[Id] : nullptr;
+    } /* End of 'Attribute' function */
+
+    /* Obtain uniform location function.
+     * ARGUMENTS:
+     *   - semantic id:
+     *       INT Id;
+     * RETURNS:
+     *   (INT) uniform location or -1 if absent.
+     */
+    INT UniformLoc( INT Id ) const
+    {
+      return Id < Uniforms.size() ? Uniforms[Id].Loc : -1;
+    } /* End of 'UniformLoc' function */
+
+    /* Obtain shader storage block bind point function.
+     * ARGUMENTS:
+     *   - semantic id:
+     *       INT Id;
+     * RETURNS:
+     *   (INT) block bind point or -1 if absent.
+     */
+    INT BlockBind( INT Id ) const
+    {
+      return Id < SSBOBuffers.size() ? SSBOBuffers[Id].Bind : -1;
+    } /* End of 'BlockBind' function */
  
     /* Class default constructor */
     shader( VOID );
@@ -114,11 +220,13 @@ namespace tse
      */
     UINT Apply( VOID );
  
-    /* Update shader function.
-     * ARGUMENTS: None.
+    /* Swap program with other (rebuilt) shader function.
+     * ARGUMENTS:
+     *   - shader to swap program and reflection data with:
+     *       shader &Other;
      * RETURNS: None.
      */
-    VOID Update( VOID );
+    VOID Swap( shader &Other );
  
     /* Update shader internal data info function.
      * ARGUMENTS: None.
@@ -132,17 +240,60 @@ namespace tse
   class shader_manager : public resource_manager<shader, std::string>
   {
   private:
-    dir_watcher Watcher;
+    dir_watcher Watcher;                  // Shaders directory watcher
+    std::set<std::string> ChangedFiles;   // Changed files waiting for debounce (relative to 'bin/shaders')
+    std::chrono::steady_clock::time_point LastChangeTime; // Last file change time
+    std::map<shader *, shader> Reloads;   // Rebuilding programs by shader to be replaced
+    INT NumOfPending = 0; // Number of asynchronously compiling shaders
+    std::map<std::pair<shader *, UINT64>, shader *> Variants; // Variants by base shader and defines key
+
+    /* Account loaded shader statistics function.
+     * ARGUMENTS:
+     *   - loaded shader:
+     *       const shader *Shd;
+     * RETURNS: None.
+     */
+    VOID AccountLoad( const shader *Shd );
+
+    /* Start rebuilding shaders affected by changed files function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Rebuild( VOID );
 
   public:
+    BOOL IsVariantsEnabled = TRUE; // Materials select texture slots shader variants flag
+    DBL DebounceTime = 150;        // Hot reload delay after last file change (ms)
+
+    /* Shaders loading statistics structure */
+    struct LOAD_STATS
+    {
+      INT CacheHits = 0, CacheMisses = 0; // Number of programs loaded from binary cache and compiled
+      DBL LoadTime = 0;                   // Total load time (ms)
+      DBL AllReadyTime = 0;               // Time from startup to all shaders compiled (ms)
+    } LoadStats;
+
     /* Create shader function.
      * ARGUMENTS:
      *   - shader file name prefix:
      *       const std::string &FileNamePrefix;
+     *   - asynchronous compilation flag (materials use default shader until ready):
+     *       BOOL IsAsync;
      * RETURNS:
      *   (shader *) created primitive interface.
      */
-    shader * ShdCreate( const std::string &FileNamePrefix );
+    shader * ShdCreate( const std::string &FileNamePrefix, BOOL IsAsync = TRUE );
+
+    /* Obtain shader variant (compiled lazily and asynchronously) function.
+     * ARGUMENTS:
+     *   - base shader:
+     *       shader *Base;
+     *   - variant defines ("NAME" or "NAME VALUE"):
+     *       std::vector<std::string> Defines;
+     * RETURNS:
+     *   (shader *) variant shader interface.
+     */
+    shader * ShdVariant( shader *Base, std::vector<std::string> Defines );
  
     /* Class constructor.
      * ARGUMENTS:
@@ -160,6 +311,12 @@ namespace tse
      */
     VOID Update( VOID );
 
+    /* Wait all asynchronously compiling shaders function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID WaitAll( VOID );
+
   }; /* End of 'shader_manager' class */
 
 } /* end of 'tse' namespace */
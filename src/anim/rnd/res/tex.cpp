@@ -9,7 +9,7 @@
  *               Textures implementation module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 03.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -65,7 +65,7 @@ tse::texture & tse::texture::Create( const std::string &NewName, INT NewW, INT N
   {
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, W, H, 
-      BytesPerPixel == 4 ? GL_BGRA : BytesPerPixel == 3 ? GL_BGR : GL_LUMINANCE,
+      BytesPerPixel == 4 ? GL_BGRA : BytesPerPixel == 3 ? GL_BGR : GL_RED,
       GL_UNSIGNED_BYTE, Pixels);
   }
   glGenerateMipmap(GL_TEXTURE_2D);
@@ -73,7 +73,8 @@ tse::texture & tse::texture::Create( const std::string &NewName, INT NewW, INT N
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
   glBindTexture(GL_TEXTURE_2D, 0);
-  tse::logger::Info("TEXTURE created: " + NewName);
+  MemSize = (SIZE_T)W * H * BytesPerPixel * (mips > 1 ? 4 : 3) / 3;
+  TSE_LOGF(DBG, "TEXTURE created: {}", NewName);
   return *this;
 } /* End of 'tse::texture::Create' function */
 
@@ -86,16 +87,119 @@ tse::texture & tse::texture::Create( const std::string &NewName, INT NewW, INT N
  */
 tse::texture & tse::texture::Create( const std::string &FileName )
 {
+  TSE_PROFILE("TextureLoad");
+
   image img(FileName);
+  Source = FileName;
   return Create(FileName, img.W, img.H, 4, img.RowsB[0][0], TRUE);
 } /* End of 'tse::texture::Create' function */
 
+/* Texture create from prepared mip levels function.
+ * ARGUMENTS:
+ *   - texture name:
+ *       const std::string &NewName;
+ *   - mip levels:
+ *       const MIPS &Mips;
+ * RETURNS:
+ *   (texture &) self reference.
+ */
+tse::texture & tse::texture::Create( const std::string &NewName, const MIPS &Mips )
+{
+  W = Mips.W;
+  H = Mips.H;
+  INT levels = (INT)Mips.Offsets.size();
+  /* Setup OpenGL texture: levels are ready, no mipmap generation */
+  glGenTextures(1, &TexId);
+  glBindTexture(GL_TEXTURE_2D, TexId);
+  glTexStorage2D(GL_TEXTURE_2D, levels,
+    Mips.C == 4 ? GL_RGBA8 : Mips.C == 3 ? GL_RGB8 : GL_R8, W, H);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  for (INT l = 0; l < levels; l++)
+  {
+    auto [w, h] = Mips.Size(l);
+    glTexSubImage2D(GL_TEXTURE_2D, l, 0, 0, w, h,
+      Mips.C == 4 ? GL_BGRA : Mips.C == 3 ? GL_BGR : GL_RED,
+      GL_UNSIGNED_BYTE, Mips.Data.data() + Mips.Offsets[l]);
+  }
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  MemSize = Mips.Data.size();
+  TSE_LOGF(DBG, "TEXTURE created: {}", NewName);
+  return *this;
+} /* End of 'tse::texture::Create' function */
+
+/* Build mip levels chain with box filter (any thread) function.
+ * ARGUMENTS:
+ *   - image size:
+ *       INT NewW, NewH;
+ *   - components count:
+ *       INT BytesPerPixel;
+ *   - image pixel data:
+ *       const BYTE *Pixels;
+ *   - mip levels build flag (only top level if FALSE):
+ *       BOOL IsMips;
+ * RETURNS:
+ *   (MIPS) built levels.
+ */
+tse::texture::MIPS tse::texture::BuildMips( INT NewW, INT NewH, INT BytesPerPixel,
+                                            const BYTE *Pixels, BOOL IsMips )
+{
+  TSE_PROFILE("TextureMips");
+
+  MIPS m;
+  m.W = NewW;
+  m.H = NewH;
+  m.C = BytesPerPixel;
+  INT levels = 1;
+  if (IsMips)
+    while ((std::max(NewW, NewH) >> levels) > 0)
+      levels++;
+
+  /* Levels placement */
+  SIZE_T size = 0;
+  for (INT l = 0; l < levels; l++)
+  {
+    auto [w, h] = m.Size(l);
+    m.Offsets.push_back(size);
+    size += (SIZE_T)w * h * m.C;
+  }
+  m.Data.resize(size);
+  std::memcpy(m.Data.data(), Pixels, (SIZE_T)NewW * NewH * m.C);
+
+  /* Each level averages 2x2 texels of previous one (edges are clamped) */
+  for (INT l = 1; l < levels; l++)
+  {
+    auto [sw, sh] = m.Size(l - 1);
+    auto [w, h] = m.Size(l);
+    const BYTE *src = m.Data.data() + m.Offsets[l - 1];
+    BYTE *dst = m.Data.data() + m.Offsets[l];
+    for (INT y = 0; y < h; y++)
+    {
+      INT y0 = std::min(y * 2, sh - 1), y1 = std::min(y * 2 + 1, sh - 1);
+      for (INT x = 0; x < w; x++)
+      {
+        INT x0 = std::min(x * 2, sw - 1), x1 = std::min(x * 2 + 1, sw - 1);
+        for (INT c = 0; c < m.C; c++)
+          dst[(y * w + x) * m.C + c] = (BYTE)((
+            src[(y0 * sw + x0) * m.C + c] + src[(y0 * sw + x1) * m.C + c] +
+            src[(y1 * sw + x0) * m.C + c] + src[(y1 * sw + x1) * m.C + c] + 2) / 4);
+      }
+    }
+  }
+  return m;
+} /* End of 'tse::texture::BuildMips' function */
+
 /* Apply texture function.
  * ARGUMENTS: None.
  * RETURNS: None.
  */
 VOID tse::texture::Apply( VOID )
 {
+  Touch();
+  if (IsEvicted)
+    Rnd->TexReload(this);
   glBindTexture(GL_TEXTURE_2D, TexId);
 } /* End of 'tse::texture::Apply' function */
 
@@ -106,6 +210,7 @@ VOID tse::texture::Apply( VOID )
 VOID tse::texture::Free( VOID )
 {
   glDeleteTextures(1, &TexId);
+  TexId = 0;
 } /* End of 'tse::texture::Free' function */
 
 /***
@@ -143,6 +248,293 @@ tse::texture * tse::texture_manager::TexCreate( const std::string &NewName, INT
   return resource_manager::Add(texture(NewName).Create(NewName, NewW, NewH, BytesPerPixel, Pixels, IsMips));
 } /* End of 'tse::texture_manager::TexCreate' function */
 
+/* Create texture with asynchronous image loading function.
+ * Texture is 1x1 white placeholder until image is read by loader
+ * thread and streamed at frame start.
+ * ARGUMENTS:
+ *   - texture file name:
+ *       const std::string &FileName;
+ *   - ready callback (render thread, may be empty):
+ *       std::function<VOID( texture *, BOOL )> OnReady;
+ * RETURNS:
+ *   (texture *) created texture interface.
+ */
+tse::texture * tse::texture_manager::TexLoadAsync( const std::string &FileName,
+                                                   std::function<VOID( texture *, BOOL )> OnReady )
+{
+  BYTE white[4] {255, 255, 255, 255};
+  texture *tex = TexCreate(FileName, 1, 1, 4, white, FALSE);
+  tex->Source = FileName;
+  TexLoad(tex, std::move(OnReady));
+  return tex;
+} /* End of 'tse::texture_manager::TexLoadAsync' function */
+
+/* Load texture image from source file asynchronously function.
+ * ARGUMENTS:
+ *   - texture with source file and placeholder image:
+ *       texture *Tex;
+ *   - ready callback (render thread, may be empty):
+ *       std::function<VOID( texture *, BOOL )> OnReady;
+ * RETURNS: None.
+ */
+VOID tse::texture_manager::TexLoad( texture *Tex, std::function<VOID( texture *, BOOL )> OnReady )
+{
+  auto mips = std::make_shared<texture::MIPS>();
+  std::string file_name = Tex->Source;
+
+  Tex->IsPending = TRUE;
+  RndRef.LoadAsync(file_name,
+    [file_name, mips]( UINT64 &Bytes ) -> BOOL
+    {
+      TSE_PROFILE("TextureRead");
+      image img(file_name);
+      if (img.W <= 0 || img.H <= 0)
+        return FALSE;
+      *mips = texture::BuildMips(img.W, img.H, 4, img.RowsB[0][0]);
+      Bytes = mips->Data.size();
+      return TRUE;
+    },
+    [this, Tex, mips, OnReady]( VOID ) -> BOOL
+    {
+      /* Loading is complete when all levels are streamed */
+      TexStream(Tex, mips, [OnReady]( texture *Done )
+        {
+          Done->IsPending = FALSE;
+          if (OnReady)
+            OnReady(Done, TRUE);
+        });
+      return TRUE;
+    },
+    [Tex, OnReady]( BOOL IsOk )
+    {
+      if (IsOk)
+        return;
+      Tex->IsPending = FALSE;
+      if (OnReady)
+        OnReady(Tex, FALSE);
+    }, Tex);
+} /* End of 'tse::texture_manager::TexLoad' function */
+
+/* Cancel pending loads and streams of texture to be deleted function.
+ * ARGUMENTS:
+ *   - texture pointer:
+ *       texture *Tex;
+ * RETURNS: None.
+ */
+VOID tse::texture_manager::CancelLoads( texture *Tex )
+{
+  RndRef.LoaderCancel(Tex);
+  for (auto st = Streams.begin(); st != Streams.end(); )
+    if (st->Tex == Tex)
+    {
+      if (st->TexId != 0)
+        glDeleteTextures(1, &st->TexId);
+      st = Streams.erase(st);
+    }
+    else
+      st++;
+} /* End of 'tse::texture_manager::CancelLoads' function */
+
+/* Reload evicted texture function.
+ * Texture is placeholder until its source image is streamed again.
+ * ARGUMENTS:
+ *   - evicted texture:
+ *       texture *Tex;
+ * RETURNS: None.
+ */
+VOID tse::texture_manager::TexReload( texture *Tex )
+{
+  if (Tex == nullptr || !Tex->IsEvicted)
+    return;
+  BYTE white[4] {255, 255, 255, 255};
+  SIZE_T size = Tex->MemSize;
+  Tex->Create(Tex->Name, 1, 1, 4, white, FALSE);
+  Tex->MemSize = size;
+  Tex->IsEvicted = FALSE;
+  NumOfReloads++;
+  TexLoad(Tex, {});
+} /* End of 'tse::texture_manager::TexReload' function */
+
+/* Create texture from prepared mip levels function.
+ * ARGUMENTS:
+ *   - texture name:
+ *       const std::string &NewName;
+ *   - mip levels:
+ *       const texture::MIPS &Mips;
+ * RETURNS:
+ *   (texture *) created texture interface.
+ */
+tse::texture * tse::texture_manager::TexCreate( const std::string &NewName, const texture::MIPS &Mips )
+{
+  return resource_manager::Add(texture(NewName).Create(NewName, Mips));
+} /* End of 'tse::texture_manager::TexCreate' function */
+
+/* Stream mip levels to texture through staging ring function.
+ * Texture keeps its current image until all levels are uploaded.
+ * ARGUMENTS:
+ *   - destination texture:
+ *       texture *Tex;
+ *   - mip levels:
+ *       std::shared_ptr<texture::MIPS> Mips;
+ *   - completion callback (render thread, may be empty):
+ *       std::function<VOID( texture * )> OnDone;
+ * RETURNS: None.
+ */
+VOID tse::texture_manager::TexStream( texture *Tex, std::shared_ptr<texture::MIPS> Mips,
+                                      std::function<VOID( texture * )> OnDone )
+{
+  if (Tex == nullptr || Mips == nullptr || Mips->Offsets.empty())
+    return;
+  Streams.push_back({Tex, std::move(Mips), std::move(OnDone)});
+} /* End of 'tse::texture_manager::TexStream' function */
+
+/* Upload level slices under per frame byte budget (called every frame) function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::texture_manager::TexStreamUpdate( VOID )
+{
+  if (Streams.empty())
+    return;
+  TSE_PROFILE("TextureStream");
+  auto start = std::chrono::steady_clock::now();
+
+  /* Staging ring: segment is written by CPU only after GPU copied it out */
+  if (StreamPBO == 0)
+  {
+    StreamSegmentSize = std::max<SIZE_T>(StreamBudget, 1 << 18); // Any texture row fits
+    glGenBuffers(1, &StreamPBO);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, StreamPBO);
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, StreamSegmentSize * StreamSegments, nullptr, flags);
+    StreamMem = (BYTE *)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, StreamSegmentSize * StreamSegments, flags);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (StreamMem == nullptr)
+      tse::logger::Warn("Texture staging buffer mapping failed, streaming from client memory");
+  }
+  if (GLsync &fence = StreamFences[StreamSegment]; fence != nullptr)
+  {
+    if (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED)
+    {
+      StreamStats.Stalls++;
+      return;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+  }
+
+  SIZE_T base = StreamSegmentSize * StreamSegment, used = 0;
+  if (StreamMem != nullptr)
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, StreamPBO);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  while (!Streams.empty())
+  {
+    STREAM &st = Streams.front();
+    texture::MIPS &m = *st.Mips;
+    INT levels = (INT)m.Offsets.size();
+    if (st.TexId == 0)
+    {
+      glGenTextures(1, &st.TexId);
+      glBindTexture(GL_TEXTURE_2D, st.TexId);
+      glTexStorage2D(GL_TEXTURE_2D, levels,
+        m.C == 4 ? GL_RGBA8 : m.C == 3 ? GL_RGB8 : GL_R8, m.W, m.H);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    }
+
+    /* Slice of whole rows fitting rest of segment */
+    auto [w, h] = m.Size(st.Level);
+    SIZE_T row = (SIZE_T)w * m.C;
+    INT rows = (INT)std::min<SIZE_T>(h - st.Row, (StreamSegmentSize - used) / row);
+    if (rows <= 0)
+      break;
+    const BYTE *src = m.Data.data() + m.Offsets[st.Level] + row * st.Row;
+    const BYTE *pixels = src;
+    if (StreamMem != nullptr)
+    {
+      std::memcpy(StreamMem + base + used, src, row * rows);
+      pixels = reinterpret_cast<const BYTE *>(base + used);
+    }
+    glBindTexture(GL_TEXTURE_2D, st.TexId);
+    glTexSubImage2D(GL_TEXTURE_2D, st.Level, 0, st.Row, w, rows,
+      m.C == 4 ? GL_BGRA : m.C == 3 ? GL_BGR : GL_RED, GL_UNSIGNED_BYTE, pixels);
+    used += row * rows;
+    StreamStats.Slices++;
+
+    /* Level and texture completion: new image replaces old one at once */
+    if ((st.Row += rows) < h)
+      continue;
+    st.Row = 0;
+    if (++st.Level < levels)
+      continue;
+    texture *tex = st.Tex;
+    glDeleteTextures(1, &tex->TexId);
+    tex->TexId = st.TexId;
+    tex->W = m.W;
+    tex->H = m.H;
+    tex->MemSize = m.Data.size();
+    auto on_done = std::move(st.OnDone);
+    Streams.pop_front();
+    StreamStats.Textures++;
+    TSE_LOGF(DBG, "TEXTURE streamed: {}", tex->Name);
+    if (on_done)
+      on_done(tex);
+  }
+  glBindTexture(GL_TEXTURE_2D, 0);
+  if (StreamMem != nullptr)
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  if (used > 0)
+  {
+    if (StreamMem != nullptr)
+    {
+      StreamFences[StreamSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      StreamSegment = (StreamSegment + 1) % StreamSegments;
+    }
+    StreamStats.Frames++;
+    StreamStats.Bytes += used;
+    StreamStats.MaxFrameBytes = std::max(StreamStats.MaxFrameBytes, used);
+  }
+  DBL ms = std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - start).count();
+  StreamStats.Time += ms;
+  StreamStats.MaxFrameTime = std::max(StreamStats.MaxFrameTime, ms);
+} /* End of 'tse::texture_manager::TexStreamUpdate' function */
+
+/* Complete all texture streams function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::texture_manager::TexStreamWaitAll( VOID )
+{
+  while (!Streams.empty())
+    TexStreamUpdate();
+} /* End of 'tse::texture_manager::TexStreamWaitAll' function */
+
+/* Free staging ring (pending streams are dropped) function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::texture_manager::TexStreamClose( VOID )
+{
+  for (auto &st : Streams)
+    if (st.TexId != 0)
+      glDeleteTextures(1, &st.TexId);
+  Streams.clear();
+  for (auto &fence : StreamFences)
+    if (fence != nullptr)
+      glDeleteSync(fence), fence = nullptr;
+  if (StreamPBO != 0)
+  {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, StreamPBO);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glDeleteBuffers(1, &StreamPBO);
+    StreamPBO = 0;
+    StreamMem = nullptr;
+  }
+  StreamSegment = 0;
+} /* End of 'tse::texture_manager::TexStreamClose' function */
+
 /* Class constructor function.
  * ARGUMENTS:
  *   - render instance reference:
@@ -9,7 +9,7 @@
  *               Textures declaration module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 03.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -35,6 +35,26 @@ namespace tse
     std::string Name; // Texture name
     INT W = 0, H = 0; // Image size
     UINT TexId = 0;   // OpenGL texture Id
+
+    /* Image with mip levels chain structure (prepared on any thread) */
+    struct MIPS
+    {
+      INT W = 0, H = 0, C = 4;     // Top level size and components count
+      std::vector<BYTE> Data;      // All levels pixel data
+      std::vector<SIZE_T> Offsets; // Levels data offsets
+
+      /* Obtain level size function.
+       * ARGUMENTS:
+       *   - level number:
+       *       INT Level;
+       * RETURNS:
+       *   (std::pair<INT, INT>) level width and height.
+       */
+      std::pair<INT, INT> Size( INT Level ) const
+      {
+        return {std::max(W >> Level, 1), std::max(H >> Level, 1)};
+      } /* End of 'Size' function */
+    }; /* End of 'MIPS' structure */
  
     /* Default class constructor function */
     texture( VOID );
@@ -70,6 +90,33 @@ namespace tse
      *   (texture &) self reference.
      */
     texture & Create( const std::string &FileName );
+
+    /* Texture create from prepared mip levels function.
+     * ARGUMENTS:
+     *   - texture name:
+     *       const std::string &NewName;
+     *   - mip levels:
+     *       const MIPS &Mips;
+     * RETURNS:
+     *   (texture &) self reference.
+     */
+    texture & Create( const std::string &NewName, const MIPS &Mips );
+
+    /* Build mip levels chain with box filter (any thread) function.
+     * ARGUMENTS:
+     *   - image size:
+     *       INT NewW, NewH;
+     *   - components count:
+     *       INT BytesPerPixel;
+     *   - image pixel data:
+     *       const BYTE *Pixels;
+     *   - mip levels build flag (only top level if FALSE):
+     *       BOOL IsMips;
+     * RETURNS:
+     *   (MIPS) built levels.
+     */
+    static MIPS BuildMips( INT NewW, INT NewH, INT BytesPerPixel,
+                           const BYTE *Pixels, BOOL IsMips = TRUE );
  
     /* Apply texture function.
      * ARGUMENTS: None.
@@ -88,7 +135,59 @@ namespace tse
   /* Texture manager class */
   class texture_manager : public resource_manager<texture, std::string>
   {
+  private:
+    /* Texture streaming request structure */
+    struct STREAM
+    {
+      texture *Tex;                             // Destination texture (keeps old image until complete)
+      std::shared_ptr<texture::MIPS> Mips;      // Source mip levels
+      std::function<VOID( texture * )> OnDone;  // Completion callback
+      UINT TexId = 0;                           // Texture being filled
+      INT Level = 0, Row = 0;                   // Next slice position
+    }; /* End of 'STREAM' structure */
+
+    static const INT StreamSegments = 3;        // Staging ring segments (one per frame in flight)
+    std::deque<STREAM> Streams;                 // Streaming requests queue
+    UINT StreamPBO = 0;                         // Persistently mapped pixel unpack buffer
+    BYTE *StreamMem = nullptr;                  // Mapped staging memory
+    SIZE_T StreamSegmentSize = 0;               // Staging ring segment size
+    INT StreamSegment = 0;                      // Current staging ring segment
+    GLsync StreamFences[StreamSegments] {};     // Segments copies completion fences
+
+    /* Load texture image from source file asynchronously function.
+     * ARGUMENTS:
+     *   - texture with source file and placeholder image:
+     *       texture *Tex;
+     *   - ready callback (render thread, may be empty):
+     *       std::function<VOID( texture *, BOOL )> OnReady;
+     * RETURNS: None.
+     */
+    VOID TexLoad( texture *Tex, std::function<VOID( texture *, BOOL )> OnReady );
+
+    /* Cancel pending loads and streams of texture to be deleted function.
+     * ARGUMENTS:
+     *   - texture pointer:
+     *       texture *Tex;
+     * RETURNS: None.
+     */
+    VOID CancelLoads( texture *Tex ) override;
+
   public:
+    SIZE_T StreamBudget = 8 << 20; // Streamed bytes per frame (staging segment size, applied on first stream)
+
+    /* Texture streaming statistics structure (times in milliseconds) */
+    struct STREAM_STATS
+    {
+      UINT64 Bytes = 0;         // Streamed bytes
+      INT Textures = 0;         // Completed textures
+      INT Slices = 0;           // Uploaded level slices
+      INT Frames = 0;           // Frames with streaming
+      INT Stalls = 0;           // Frames skipped on busy staging segment
+      SIZE_T MaxFrameBytes = 0; // Most bytes streamed in one frame
+      DBL Time = 0;             // Total streaming CPU time
+      DBL MaxFrameTime = 0;     // Worst frame streaming CPU time
+    } StreamStats;
+
     /* Create tetxure function.
      * ARGUMENTS:
      *   - texture file name:
@@ -113,6 +212,82 @@ namespace tse
      */
     texture * TexCreate( const std::string &NewName, INT NewW, INT NewH,
                          INT BytesPerPixel, BYTE *Pixels, BOOL IsMips = TRUE );
+
+    /* Create texture with asynchronous image loading function.
+     * Texture is 1x1 white placeholder until image is read by loader
+     * thread and streamed at frame start.
+     * ARGUMENTS:
+     *   - texture file name:
+     *       const std::string &FileName;
+     *   - ready callback (render thread, may be empty):
+     *       std::function<VOID( texture *, BOOL )> OnReady;
+     * RETURNS:
+     *   (texture *) created texture interface.
+     */
+    texture * TexLoadAsync( const std::string &FileName,
+                            std::function<VOID( texture *, BOOL )> OnReady = {} );
+
+    /* Create texture from prepared mip levels function.
+     * ARGUMENTS:
+     *   - texture name:
+     *       const std::string &NewName;
+     *   - mip levels:
+     *       const texture::MIPS &Mips;
+     * RETURNS:
+     *   (texture *) created texture interface.
+     */
+    texture * TexCreate( const std::string &NewName, const texture::MIPS &Mips );
+
+    /* Reload evicted texture function.
+     * Texture is placeholder until its source image is streamed again.
+     * ARGUMENTS:
+     *   - evicted texture:
+     *       texture *Tex;
+     * RETURNS: None.
+     */
+    VOID TexReload( texture *Tex );
+
+    /* Stream mip levels to texture through staging ring function.
+     * Texture keeps its current image until all levels are uploaded.
+     * ARGUMENTS:
+     *   - destination texture:
+     *       texture *Tex;
+     *   - mip levels:
+     *       std::shared_ptr<texture::MIPS> Mips;
+     *   - completion callback (render thread, may be empty):
+     *       std::function<VOID( texture * )> OnDone;
+     * RETURNS: None.
+     */
+    VOID TexStream( texture *Tex, std::shared_ptr<texture::MIPS> Mips,
+                    std::function<VOID( texture * )> OnDone = {} );
+
+    /* Upload level slices under per frame byte budget (called every frame) function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID TexStreamUpdate( VOID );
+
+    /* Complete all texture streams function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID TexStreamWaitAll( VOID );
+
+    /* Free staging ring (pending streams are dropped) function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID TexStreamClose( VOID );
+
+    /* Obtain number of not completed texture streams function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) number of streams.
+     */
+    INT NumOfStreams( VOID ) const
+    {
+      return (INT)Streams.size();
+    } /* End of 'NumOfStreams' function */
  
     /* Class constructor function.
      * ARGUMENTS:
@@ -0,0 +1,667 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : bvh.cpp
+ * PURPOSE     : Tough Space Exploration project.
+ *               Scene module.
+ *               Bounding volume hierarchy module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include "tse.h"
+
+/* Anonymous namespace for correct name mangling */
+namespace
+{
+  /* Obtain vector coordinate by axis function.
+   * ARGUMENTS:
+   *   - vector:
+   *       const tse::vec3 &V;
+   *   - axis (0 - X, 1 - Y, 2 - Z):
+   *       INT Axis;
+   * RETURNS:
+   *   (FLT) coordinate.
+   */
+  inline FLT Coord( const tse::vec3 &V, INT Axis )
+  {
+    return (&V.X)[Axis];
+  } /* End of 'Coord' function */
+} /* end of anonymous namespace */
+
+/* Structure constructor.
+ * ARGUMENTS:
+ *   - view-projection matrix:
+ *       const matr &VP;
+ */
+tse::bvh::FRUSTUM::FRUSTUM( const matr &VP )
+{
+  /* Clip space -W <= X, Y, Z <= W with row vectors: planes are W column +- X, Y, Z columns */
+  for (INT i = 0; i < 3; i++)
+    for (INT k = 0; k < 4; k++)
+    {
+      Planes[i * 2][k] = VP.M[k][3] + VP.M[k][i];
+      Planes[i * 2 + 1][k] = VP.M[k][3] - VP.M[k][i];
+    }
+} /* End of 'tse::bvh::FRUSTUM::FRUSTUM' function */
+
+/* Check if box is outside frustum function.
+ * ARGUMENTS:
+ *   - bound box:
+ *       const vec3 &Min, &Max;
+ * RETURNS:
+ *   (BOOL) TRUE if box is completely outside of any plane.
+ */
+BOOL tse::bvh::FRUSTUM::IsOutside( const vec3 &Min, const vec3 &Max ) const
+{
+  for (auto &p : Planes)
+    if ((p[0] > 0 ? Max.X : Min.X) * p[0] + (p[1] > 0 ? Max.Y : Min.Y) * p[1] +
+        (p[2] > 0 ? Max.Z : Min.Z) * p[2] + p[3] < 0)
+      return TRUE;
+  return FALSE;
+} /* End of 'tse::bvh::FRUSTUM::IsOutside' function */
+
+/* Ray and box intersection (slabs) function.
+ * ARGUMENTS:
+ *   - ray:
+ *       const ray &R;
+ *   - ray direction inverse:
+ *       const vec3 &InvDir;
+ *   - bound box:
+ *       const vec3 &Min, &Max;
+ *   - entry distance (0 if ray starts inside):
+ *       FLT &T;
+ * RETURNS:
+ *   (BOOL) TRUE if ray hits box.
+ */
+BOOL tse::bvh::Intersect( const ray &R, const vec3 &InvDir, const vec3 &Min, const vec3 &Max, FLT &T )
+{
+  FLT tnear = 0, tfar = std::numeric_limits<FLT>::max();
+  for (INT i = 0; i < 3; i++)
+  {
+    FLT
+      t0 = (Coord(Min, i) - Coord(R.Org, i)) * Coord(InvDir, i),
+      t1 = (Coord(Max, i) - Coord(R.Org, i)) * Coord(InvDir, i);
+    /* Comparisons are written to drop NaN (ray in slab plane) */
+    if (t0 > t1)
+      std::swap(t0, t1);
+    if (t0 > tnear)
+      tnear = t0;
+    if (t1 < tfar)
+      tfar = t1;
+    if (tnear > tfar)
+      return FALSE;
+  }
+  T = tnear;
+  return TRUE;
+} /* End of 'tse::bvh::Intersect' function */
+
+/* Allocate node function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (INT) node index.
+ */
+INT tse::bvh::AllocNode( VOID )
+{
+  if (FreeNodes.empty())
+  {
+    Nodes.emplace_back();
+    return (INT)Nodes.size() - 1;
+  }
+  INT n = FreeNodes.back();
+  FreeNodes.pop_back();
+  Nodes[n] = NODE();
+  return n;
+} /* End of 'tse::bvh::AllocNode' function */
+
+/* Refit node and its ancestors until box stays the same function.
+ * ARGUMENTS:
+ *   - node:
+ *       INT N;
+ * RETURNS: None.
+ */
+VOID tse::bvh::RefitUp( INT N )
+{
+  for (; N != -1; N = Nodes[N].Parent)
+  {
+    NODE &n = Nodes[N];
+    const NODE &l = Nodes[n.Child[0]], &r = Nodes[n.Child[1]];
+    vec3 mn = l.Min.Min(r.Min), mx = l.Max.Max(r.Max);
+    if (mn.X == n.Min.X && mn.Y == n.Min.Y && mn.Z == n.Min.Z &&
+        mx.X == n.Max.X && mx.Y == n.Max.Y && mx.Z == n.Max.Z)
+      break;
+    n.Min = mn;
+    n.Max = mx;
+  }
+} /* End of 'tse::bvh::RefitUp' function */
+
+/* Attach leaf to tree function.
+ * ARGUMENTS:
+ *   - leaf node:
+ *       INT L;
+ * RETURNS: None.
+ */
+VOID tse::bvh::InsertLeaf( INT L )
+{
+  if (Root == -1)
+  {
+    Root = L;
+    Nodes[L].Parent = -1;
+    return;
+  }
+
+  /* Descend to sibling with the least area increase of the new subtree and ancestors */
+  vec3 lmin = Nodes[L].Min, lmax = Nodes[L].Max;
+  INT s = Root;
+  while (Nodes[s].Child[0] != -1)
+  {
+    const NODE &n = Nodes[s];
+    FLT
+      area = Area(n.Min, n.Max),
+      joined = Area(n.Min.Min(lmin), n.Max.Max(lmax)),
+      cost_here = 2 * joined,
+      inherited = 2 * (joined - area),
+      cost[2];
+    for (INT i = 0; i < 2; i++)
+    {
+      const NODE &c = Nodes[n.Child[i]];
+      cost[i] = Area(c.Min.Min(lmin), c.Max.Max(lmax)) + inherited;
+      if (c.Child[0] != -1)
+        cost[i] -= Area(c.Min, c.Max);
+    }
+    if (cost_here < cost[0] && cost_here < cost[1])
+      break;
+    s = n.Child[cost[0] < cost[1] ? 0 : 1];
+  }
+
+  /* New parent of sibling and leaf */
+  INT p = AllocNode(), old_parent = Nodes[s].Parent;
+  NODE &np = Nodes[p];
+  np.Parent = old_parent;
+  np.Min = Nodes[s].Min.Min(lmin);
+  np.Max = Nodes[s].Max.Max(lmax);
+  np.Child[0] = s;
+  np.Child[1] = L;
+  Nodes[s].Parent = p;
+  Nodes[L].Parent = p;
+  if (old_parent == -1)
+    Root = p;
+  else
+  {
+    Nodes[old_parent].Child[Nodes[old_parent].Child[0] == s ? 0 : 1] = p;
+    RefitUp(old_parent);
+  }
+} /* End of 'tse::bvh::InsertLeaf' function */
+
+/* Detach leaf from tree function.
+ * ARGUMENTS:
+ *   - leaf node:
+ *       INT L;
+ * RETURNS: None.
+ */
+VOID tse::bvh::RemoveLeaf( INT L )
+{
+  if (L == Root)
+  {
+    Root = -1;
+    return;
+  }
+
+  /* Sibling takes parent place */
+  INT p = Nodes[L].Parent, g = Nodes[p].Parent, s = Nodes[p].Child[Nodes[p].Child[0] == L ? 1 : 0];
+  Nodes[s].Parent = g;
+  if (g == -1)
+    Root = s;
+  else
+  {
+    Nodes[g].Child[Nodes[g].Child[0] == p ? 0 : 1] = s;
+    RefitUp(g);
+  }
+  FreeNodes.push_back(p);
+} /* End of 'tse::bvh::RemoveLeaf' function */
+
+/* Add object function.
+ * ARGUMENTS:
+ *   - object bound box:
+ *       const vec3 &Min, &Max;
+ *   - user data (returned by queries):
+ *       INT UserData;
+ * RETURNS:
+ *   (proxy) object handle.
+ */
+tse::bvh::proxy tse::bvh::Insert( const vec3 &Min, const vec3 &Max, INT UserData )
+{
+  proxy obj;
+  if (!FreeObjects.empty())
+    obj = FreeObjects.back(), FreeObjects.pop_back();
+  else
+  {
+    obj = (proxy)Leaf.size();
+    Leaf.push_back(-1);
+    Data.push_back(0);
+  }
+  INT l = AllocNode();
+  Nodes[l].Min = Min;
+  Nodes[l].Max = Max;
+  Nodes[l].Object = obj;
+  Leaf[obj] = l;
+  Data[obj] = UserData;
+  InsertLeaf(l);
+  return obj;
+} /* End of 'tse::bvh::Insert' function */
+
+/* Remove object function.
+ * ARGUMENTS:
+ *   - object:
+ *       proxy Object;
+ * RETURNS: None.
+ */
+VOID tse::bvh::Remove( proxy Object )
+{
+  if (Object < 0 || Object >= (INT)Leaf.size() || Leaf[Object] == -1)
+    return;
+  RemoveLeaf(Leaf[Object]);
+  FreeNodes.push_back(Leaf[Object]);
+  Leaf[Object] = -1;
+  FreeObjects.push_back(Object);
+  if (Data[Object] >= 0 && Data[Object] < (INT)NodeObject.size() && NodeObject[Data[Object]] == Object)
+    NodeObject[Data[Object]] = None;
+} /* End of 'tse::bvh::Remove' function */
+
+/* Change object bound box function (applied by 'Refit').
+ * ARGUMENTS:
+ *   - object:
+ *       proxy Object;
+ *   - new bound box:
+ *       const vec3 &Min, &Max;
+ * RETURNS: None.
+ */
+VOID tse::bvh::Move( proxy Object, const vec3 &Min, const vec3 &Max )
+{
+  if (Object < 0 || Object >= (INT)Leaf.size() || Leaf[Object] == -1)
+    return;
+  Nodes[Leaf[Object]].Min = Min;
+  Nodes[Leaf[Object]].Max = Max;
+  Moved.push_back(Object);
+} /* End of 'tse::bvh::Move' function */
+
+/* Refit moved objects ancestors function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::bvh::Refit( VOID )
+{
+  if (Moved.empty() || Root == -1)
+  {
+    Moved.clear();
+    return;
+  }
+
+  /* Many moves: all internal nodes once, children after parents in order */
+  if (Moved.size() * 8 > Leaf.size() - FreeObjects.size())
+  {
+    std::vector<INT> order {Root};
+    for (SIZE_T i = 0; i < order.size(); i++)
+      if (const NODE &n = Nodes[order[i]]; n.Child[0] != -1)
+        order.push_back(n.Child[0]), order.push_back(n.Child[1]);
+    for (SIZE_T i = order.size(); i-- > 0; )
+      if (NODE &n = Nodes[order[i]]; n.Child[0] != -1)
+      {
+        n.Min = Nodes[n.Child[0]].Min.Min(Nodes[n.Child[1]].Min);
+        n.Max = Nodes[n.Child[0]].Max.Max(Nodes[n.Child[1]].Max);
+      }
+  }
+  else
+    for (proxy obj : Moved)
+      if (Leaf[obj] != -1)
+        RefitUp(Nodes[Leaf[obj]].Parent);
+  Moved.clear();
+} /* End of 'tse::bvh::Refit' function */
+
+/* Rebuild tree by surface area heuristic function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::bvh::Build( VOID )
+{
+  /* Objects with box centers */
+  struct ITEM
+  {
+    vec3 Min, Max, C; // Bound box and its center
+    proxy Object;     // Object
+  };
+  std::vector<ITEM> items;
+  items.reserve(Leaf.size());
+  for (proxy obj = 0; obj < (INT)Leaf.size(); obj++)
+    if (Leaf[obj] != -1)
+    {
+      const NODE &n = Nodes[Leaf[obj]];
+      items.push_back({n.Min, n.Max, (n.Min + n.Max) / 2, obj});
+    }
+  Nodes.clear();
+  FreeNodes.clear();
+  Moved.clear();
+  Root = -1;
+  if (items.empty())
+    return;
+  Nodes.reserve(items.size() * 2);
+
+  /* Ranges to split (binned by centers on the widest axis) */
+  struct TASK
+  {
+    INT Begin, End, Node; // Items range and its node
+  };
+  const INT NumOfBins = 16;
+  std::vector<TASK> tasks {{0, (INT)items.size(), AllocNode()}};
+  Root = 0;
+  while (!tasks.empty())
+  {
+    TASK t = tasks.back();
+    tasks.pop_back();
+
+    vec3 mn = items[t.Begin].Min, mx = items[t.Begin].Max, cmn = items[t.Begin].C, cmx = cmn;
+    for (INT i = t.Begin + 1; i < t.End; i++)
+    {
+      mn = mn.Min(items[i].Min);
+      mx = mx.Max(items[i].Max);
+      cmn = cmn.Min(items[i].C);
+      cmx = cmx.Max(items[i].C);
+    }
+    Nodes[t.Node].Min = mn;
+    Nodes[t.Node].Max = mx;
+    if (t.End - t.Begin == 1)
+    {
+      Nodes[t.Node].Object = items[t.Begin].Object;
+      Leaf[items[t.Begin].Object] = t.Node;
+      continue;
+    }
+
+    vec3 ext = cmx - cmn;
+    INT axis = ext.X > ext.Y ? (ext.X > ext.Z ? 0 : 2) : (ext.Y > ext.Z ? 1 : 2), mid = t.Begin;
+    FLT start = Coord(cmn, axis), scale = NumOfBins * 0.9999f / std::max(Coord(ext, axis), 1e-30f);
+    if (Coord(ext, axis) > 0)
+    {
+      /* Bins bound boxes and counts */
+      struct BIN
+      {
+        vec3 Min {0}, Max {0}; // Bound box
+        INT Count = 0;         // Number of items
+      } bins[NumOfBins];
+      for (INT i = t.Begin; i < t.End; i++)
+      {
+        BIN &b = bins[(INT)((Coord(items[i].C, axis) - start) * scale)];
+        b.Min = b.Count == 0 ? items[i].Min : b.Min.Min(items[i].Min);
+        b.Max = b.Count == 0 ? items[i].Max : b.Max.Max(items[i].Max);
+        b.Count++;
+      }
+
+      /* Split cost: items count by box area on both sides */
+      FLT right_area[NumOfBins] {};
+      INT right_count[NumOfBins] {};
+      BIN acc;
+      for (INT i = NumOfBins - 1; i > 0; i--)
+      {
+        if (bins[i].Count != 0)
+        {
+          acc.Min = acc.Count == 0 ? bins[i].Min : acc.Min.Min(bins[i].Min);
+          acc.Max = acc.Count == 0 ? bins[i].Max : acc.Max.Max(bins[i].Max);
+          acc.Count += bins[i].Count;
+        }
+        right_area[i] = Area(acc.Min, acc.Max);
+        right_count[i] = acc.Count;
+      }
+      acc = BIN();
+      FLT best_cost = std::numeric_limits<FLT>::max();
+      INT best = -1;
+      for (INT i = 1; i < NumOfBins; i++)
+      {
+        if (bins[i - 1].Count != 0)
+        {
+          acc.Min = acc.Count == 0 ? bins[i - 1].Min : acc.Min.Min(bins[i - 1].Min);
+          acc.Max = acc.Count == 0 ? bins[i - 1].Max : acc.Max.Max(bins[i - 1].Max);
+          acc.Count += bins[i - 1].Count;
+        }
+        FLT cost = acc.Count * Area(acc.Min, acc.Max) + right_count[i] * right_area[i];
+        if (acc.Count != 0 && right_count[i] != 0 && cost < best_cost)
+          best_cost = cost, best = i;
+      }
+      if (best != -1)
+        mid = (INT)(std::partition(items.begin() + t.Begin, items.begin() + t.End,
+          [&]( const ITEM &It ){ return (INT)((Coord(It.C, axis) - start) * scale) < best; }) - items.begin());
+    }
+    /* Coincident centers: median split */
+    if (mid <= t.Begin || mid >= t.End)
+    {
+      mid = (t.Begin + t.End) / 2;
+      std::nth_element(items.begin() + t.Begin, items.begin() + mid, items.begin() + t.End,
+        [axis]( const ITEM &A, const ITEM &B ){ return Coord(A.C, axis) < Coord(B.C, axis); });
+    }
+
+    INT l = AllocNode(), r = AllocNode();
+    Nodes[t.Node].Child[0] = l;
+    Nodes[t.Node].Child[1] = r;
+    Nodes[l].Parent = Nodes[r].Parent = t.Node;
+    tasks.push_back({t.Begin, mid, l});
+    tasks.push_back({mid, t.End, r});
+  }
+} /* End of 'tse::bvh::Build' function */
+
+/* Find objects intersecting view frustum function.
+ * ARGUMENTS:
+ *   - view-projection matrix:
+ *       const matr &VP;
+ *   - visible objects user data (appended):
+ *       std::vector<INT> &Visible;
+ * RETURNS:
+ *   (INT) number of visited nodes.
+ */
+INT tse::bvh::Cull( const matr &VP, std::vector<INT> &Visible ) const
+{
+  if (Root == -1)
+    return 0;
+
+  /* Planes mask: subtree inside of plane is not tested with it */
+  FRUSTUM f(VP);
+  std::vector<std::pair<INT, INT>> stack {{Root, 0x3F}};
+  INT visited = 0;
+  while (!stack.empty())
+  {
+    auto [i, mask] = stack.back();
+    stack.pop_back();
+    visited++;
+    const NODE &n = Nodes[i];
+    BOOL is_outside = FALSE;
+    for (INT k = 0; k < 6 && !is_outside; k++)
+      if (mask & (1 << k))
+      {
+        const FLT *p = f.Planes[k];
+        if ((p[0] > 0 ? n.Max.X : n.Min.X) * p[0] + (p[1] > 0 ? n.Max.Y : n.Min.Y) * p[1] +
+            (p[2] > 0 ? n.Max.Z : n.Min.Z) * p[2] + p[3] < 0)
+          is_outside = TRUE;
+        else if ((p[0] > 0 ? n.Min.X : n.Max.X) * p[0] + (p[1] > 0 ? n.Min.Y : n.Max.Y) * p[1] +
+                 (p[2] > 0 ? n.Min.Z : n.Max.Z) * p[2] + p[3] >= 0)
+          mask &= ~(1 << k);
+      }
+    if (is_outside)
+      continue;
+    if (n.Child[0] == -1)
+      Visible.push_back(Data[n.Object]);
+    else
+    {
+      stack.push_back({n.Child[0], mask});
+      stack.push_back({n.Child[1], mask});
+    }
+  }
+  return visited;
+} /* End of 'tse::bvh::Cull' function */
+
+/* Find nearest object hit by ray function.
+ * ARGUMENTS:
+ *   - ray (e.g. 'camera::FrameRay'):
+ *       const ray &R;
+ *   - hit distance:
+ *       FLT &T;
+ *   - exact object hit test (by user data, distance is box entry on call), boxes if empty:
+ *       const std::function<BOOL ( INT UserData, FLT &T )> &Hit;
+ * RETURNS:
+ *   (INT) hit object user data (-1 if none).
+ */
+INT tse::bvh::Pick( const ray &R, FLT &T, const std::function<BOOL ( INT UserData, FLT &T )> &Hit ) const
+{
+  FLT best = std::numeric_limits<FLT>::max(), t;
+  INT res = -1;
+  vec3 inv(1 / R.Dir.X, 1 / R.Dir.Y, 1 / R.Dir.Z);
+  if (Root == -1 || !Intersect(R, inv, Nodes[Root].Min, Nodes[Root].Max, t))
+    return -1;
+
+  /* Nearer child is visited first, farther than found hit nodes are dropped */
+  std::vector<std::pair<INT, FLT>> stack {{Root, t}};
+  while (!stack.empty())
+  {
+    auto [i, tnear] = stack.back();
+    stack.pop_back();
+    if (tnear >= best)
+      continue;
+    const NODE &n = Nodes[i];
+    if (n.Child[0] == -1)
+    {
+      t = tnear;
+      if ((!Hit || Hit(Data[n.Object], t)) && t < best)
+        best = t, res = Data[n.Object];
+      continue;
+    }
+    FLT t0, t1;
+    BOOL
+      is_hit0 = Intersect(R, inv, Nodes[n.Child[0]].Min, Nodes[n.Child[0]].Max, t0),
+      is_hit1 = Intersect(R, inv, Nodes[n.Child[1]].Min, Nodes[n.Child[1]].Max, t1);
+    if (is_hit0 && is_hit1 && t0 < t1)
+    {
+      stack.push_back({n.Child[1], t1});
+      stack.push_back({n.Child[0], t0});
+    }
+    else
+    {
+      if (is_hit0)
+        stack.push_back({n.Child[0], t0});
+      if (is_hit1)
+        stack.push_back({n.Child[1], t1});
+    }
+  }
+  if (res != -1)
+    T = best;
+  return res;
+} /* End of 'tse::bvh::Pick' function */
+
+/* Track scene graph node world bound box function.
+ * Tracked object user data is node handle, remove object before node.
+ * ARGUMENTS:
+ *   - scene graph (updated):
+ *       const scene_graph &Scene;
+ *   - node:
+ *       scene_graph::node Node;
+ * RETURNS:
+ *   (proxy) object handle.
+ */
+tse::bvh::proxy tse::bvh::Track( const scene_graph &Scene, scene_graph::node Node )
+{
+  if (!Scene.IsAlive(Node))
+    return None;
+  if (Node >= (INT)NodeObject.size())
+    NodeObject.resize(Node + 1, -1);
+  if (NodeObject[Node] == None)
+  {
+    vec3 mn, mx;
+    Scene.GetWorldBB(Node, mn, mx);
+    NodeObject[Node] = Insert(mn, mx, Node);
+  }
+  return NodeObject[Node];
+} /* End of 'tse::bvh::Track' function */
+
+/* Obtain tracked scene graph node object function.
+ * ARGUMENTS:
+ *   - node:
+ *       scene_graph::node Node;
+ * RETURNS:
+ *   (proxy) object handle (None if node is not tracked).
+ */
+tse::bvh::proxy tse::bvh::Tracked( scene_graph::node Node ) const
+{
+  if (Node < 0 || Node >= (INT)NodeObject.size())
+    return None;
+  return NodeObject[Node];
+} /* End of 'tse::bvh::Tracked' function */
+
+/* Move tracked nodes changed by last scene graph update and refit function.
+ * ARGUMENTS:
+ *   - scene graph:
+ *       const scene_graph &Scene;
+ * RETURNS: None.
+ */
+VOID tse::bvh::Sync( const scene_graph &Scene )
+{
+  vec3 mn, mx;
+  for (scene_graph::node node : Scene.Changed())
+    if (node < (INT)NodeObject.size() && NodeObject[node] != None)
+    {
+      Scene.GetWorldBB(node, mn, mx);
+      Move(NodeObject[node], mn, mx);
+    }
+  Refit();
+} /* End of 'tse::bvh::Sync' function */
+
+/* Obtain tree statistics function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (STATS) statistics.
+ */
+tse::bvh::STATS tse::bvh::Stats( VOID ) const
+{
+  STATS st;
+  if (Root == -1)
+    return st;
+  std::vector<std::pair<INT, INT>> stack {{Root, 0}};
+  DBL area = 0;
+  while (!stack.empty())
+  {
+    auto [i, depth] = stack.back();
+    stack.pop_back();
+    const NODE &n = Nodes[i];
+    st.Nodes++;
+    if (n.Child[0] == -1)
+    {
+      st.Objects++;
+      st.Depth = std::max(st.Depth, depth);
+      continue;
+    }
+    area += Area(n.Min, n.Max);
+    stack.push_back({n.Child[0], depth + 1});
+    stack.push_back({n.Child[1], depth + 1});
+  }
+  st.Cost = area / std::max(Area(Nodes[Root].Min, Nodes[Root].Max), 1e-30f);
+  return st;
+} /* End of 'tse::bvh::Stats' function */
+
+/* Remove all objects function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::bvh::Clear( VOID )
+{
+  Nodes.clear();
+  FreeNodes.clear();
+  Root = -1;
+  Leaf.clear();
+  Data.clear();
+  FreeObjects.clear();
+  Moved.clear();
+  NodeObject.clear();
+} /* End of 'tse::bvh::Clear' function */
+
+/* END OF 'bvh.cpp' FILE */
@@ -0,0 +1,262 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : bvh.h
+ * PURPOSE     : Tough Space Exploration project.
+ *               Scene module.
+ *               Bounding volume hierarchy declaration module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __bvh_h_
+#define __bvh_h_
+
+/* Main program namespace */
+namespace tse
+{
+  /* Dynamic bounding volume hierarchy class.
+   * Binary tree with one object per leaf. 'Build' makes tree by binned
+   * surface area heuristic, 'Insert' descends to the cheapest sibling by the
+   * same heuristic, 'Remove' replaces parent by sibling. Moved objects are
+   * refitted by 'Refit' (tree quality slowly degrades, 'Cost' tells when to
+   * rebuild). Queries are valid after 'Refit'. */
+  class bvh
+  {
+  public:
+    using proxy = INT;            // Object handle
+    static const proxy None = -1; // No object
+
+    /* View frustum structure */
+    struct FRUSTUM
+    {
+      FLT Planes[6][4]; // Planes (inside is positive), from view-projection matrix columns
+
+      /* Structure constructor.
+       * ARGUMENTS:
+       *   - view-projection matrix:
+       *       const matr &VP;
+       */
+      FRUSTUM( const matr &VP );
+
+      /* Check if box is outside frustum function.
+       * ARGUMENTS:
+       *   - bound box:
+       *       const vec3 &Min, &Max;
+       * RETURNS:
+       *   (BOOL) TRUE if box is completely outside of any plane.
+       */
+      BOOL IsOutside( const vec3 &Min, const vec3 &Max ) const;
+    }; /* End of 'FRUSTUM' structure */
+
+    /* Tree statistics structure */
+    struct STATS
+    {
+      INT Objects = 0; // Number of objects
+      INT Nodes = 0;   // Number of nodes
+      INT Depth = 0;   // Maximal leaf depth
+      DBL Cost = 0;    // Surface area heuristic cost (internal nodes areas to root area)
+    }; /* End of 'STATS' structure */
+
+  private:
+    /* Tree node structure */
+    struct NODE
+    {
+      vec3 Min, Max;           // Bound box
+      INT Parent = -1;         // Parent node (-1 for root)
+      INT Child[2] {-1, -1};   // Children (-1 for leaf)
+      proxy Object = None;     // Leaf object
+    }; /* End of 'NODE' structure */
+
+    std::vector<NODE> Nodes;        // Nodes
+    std::vector<INT> FreeNodes;     // Free nodes
+    INT Root = -1;                  // Root node
+
+    std::vector<INT> Leaf;          // Leaf node by object (-1 for free objects)
+    std::vector<INT> Data;          // User data by object
+    std::vector<proxy> FreeObjects; // Free objects
+    std::vector<proxy> Moved;       // Objects moved since last refit
+
+    std::vector<proxy> NodeObject;  // Tracked scene graph nodes objects (by node handle)
+
+    /* Allocate node function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) node index.
+     */
+    INT AllocNode( VOID );
+
+    /* Attach leaf to tree function.
+     * ARGUMENTS:
+     *   - leaf node:
+     *       INT L;
+     * RETURNS: None.
+     */
+    VOID InsertLeaf( INT L );
+
+    /* Detach leaf from tree function.
+     * ARGUMENTS:
+     *   - leaf node:
+     *       INT L;
+     * RETURNS: None.
+     */
+    VOID RemoveLeaf( INT L );
+
+    /* Refit node and its ancestors until box stays the same function.
+     * ARGUMENTS:
+     *   - node:
+     *       INT N;
+     * RETURNS: None.
+     */
+    VOID RefitUp( INT N );
+
+  public:
+    /* Box surface area function.
+     * ARGUMENTS:
+     *   - bound box:
+     *       const vec3 &Min, &Max;
+     * RETURNS:
+     *   (FLT) surface area.
+     */
+    static FLT Area( const vec3 &Min, const vec3 &Max )
+    {
+      vec3 d = Max - Min;
+      return 2 * (d.X * d.Y + d.Y * d.Z + d.Z * d.X);
+    } /* End of 'Area' function */
+
+    /* Ray and box intersection (slabs) function.
+     * ARGUMENTS:
+     *   - ray:
+     *       const ray &R;
+     *   - ray direction inverse:
+     *       const vec3 &InvDir;
+     *   - bound box:
+     *       const vec3 &Min, &Max;
+     *   - entry distance (0 if ray starts inside):
+     *       FLT &T;
+     * RETURNS:
+     *   (BOOL) TRUE if ray hits box.
+     */
+    static BOOL Intersect( const ray &R, const vec3 &InvDir, const vec3 &Min, const vec3 &Max, FLT &T );
+
+    /* Add object function.
+     * ARGUMENTS:
+     *   - object bound box:
+     *       const vec3 &Min, &Max;
+     *   - user data (returned by queries):
+     *       INT UserData;
+     * RETURNS:
+     *   (proxy) object handle.
+     */
+    proxy Insert( const vec3 &Min, const vec3 &Max, INT UserData );
+
+    /* Remove object function.
+     * ARGUMENTS:
+     *   - object:
+     *       proxy Object;
+     * RETURNS: None.
+     */
+    VOID Remove( proxy Object );
+
+    /* Change object bound box function (applied by 'Refit').
+     * ARGUMENTS:
+     *   - object:
+     *       proxy Object;
+     *   - new bound box:
+     *       const vec3 &Min, &Max;
+     * RETURNS: None.
+     */
+    VOID Move( proxy Object, const vec3 &Min, const vec3 &Max );
+
+    /* Refit moved objects ancestors function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Refit( VOID );
+
+    /* Rebuild tree by surface area heuristic function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Build( VOID );
+
+    /* Find objects intersecting view frustum function.
+     * ARGUMENTS:
+     *   - view-projection matrix:
+     *       const matr &VP;
+     *   - visible objects user data (appended):
+     *       std::vector<INT> &Visible;
+     * RETURNS:
+     *   (INT) number of visited nodes.
+     */
+    INT Cull( const matr &VP, std::vector<INT> &Visible ) const;
+
+    /* Find nearest object hit by ray function.
+     * ARGUMENTS:
+     *   - ray (e.g. 'camera::FrameRay'):
+     *       const ray &R;
+     *   - hit distance:
+     *       FLT &T;
+     *   - exact object hit test (by user data, distance is box entry on call), boxes if empty:
+     *       const std::function<BOOL ( INT UserData, FLT &T )> &Hit;
+     * RETURNS:
+     *   (INT) hit object user data (-1 if none).
+     */
+    INT Pick( const ray &R, FLT &T, const std::function<BOOL ( INT UserData, FLT &T )> &Hit = {} ) const;
+
+    /* Track scene graph node world bound box function.
+     * Tracked object user data is node handle, remove object before node.
+     * ARGUMENTS:
+     *   - scene graph (updated):
+     *       const scene_graph &Scene;
+     *   - node:
+     *       scene_graph::node Node;
+     * RETURNS:
+     *   (proxy) object handle.
+     */
+    proxy Track( const scene_graph &Scene, scene_graph::node Node );
+
+    /* Obtain tracked scene graph node object function.
+     * ARGUMENTS:
+     *   - node:
+     *       scene_graph::node Node;
+     * RETURNS:
+     *   (proxy) object handle (None if node is not tracked).
+     */
+    proxy Tracked( scene_graph::node Node ) const;
+
+    /* Move tracked nodes changed by last scene graph update and refit function.
+     * ARGUMENTS:
+     *   - scene graph:
+     *       const scene_graph &Scene;
+     * RETURNS: None.
+     */
+    VOID Sync( const scene_graph &Scene );
+
+    /* Obtain tree statistics function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (STATS) statistics.
+     */
+    STATS Stats( VOID ) const;
+
+    /* Remove all objects function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Clear( VOID );
+
+  }; /* End of 'bvh' class */
+
+} /* end of 'tse' namespace */
+
+#endif /* __bvh_h_ */
+
+/* END OF 'bvh.h' FILE */
@@ -0,0 +1,450 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : scene.cpp
+ * PURPOSE     : Tough Space Exploration project.
+ *               Scene module.
+ *               Scene graph module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#include "tse.h"
+
+/* Anonymous namespace for correct name mangling */
+namespace
+{
+  /* Multiply 16 bytes aligned matrices (R = A * B) function.
+   * ARGUMENTS:
+   *   - matrices to multiply:
+   *       const FLT A[4][4], B[4][4];
+   *   - result matrix:
+   *       FLT R[4][4];
+   * RETURNS: None.
+   */
+  inline VOID MulSSE( const FLT A[4][4], const FLT B[4][4], FLT R[4][4] )
+  {
+    __m128
+      b0 = _mm_load_ps(B[0]),
+      b1 = _mm_load_ps(B[1]),
+      b2 = _mm_load_ps(B[2]),
+      b3 = _mm_load_ps(B[3]);
+    for (INT i = 0; i < 4; i++)
+    {
+      __m128 r = _mm_mul_ps(_mm_set1_ps(A[i][0]), b0);
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(A[i][1]), b1));
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(A[i][2]), b2));
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(A[i][3]), b3));
+      _mm_store_ps(R[i], r);
+    }
+  } /* End of 'MulSSE' function */
+
+  /* Transform 16 bytes aligned bound box function.
+   * Center is transformed as point, extents by absolute matrix values.
+   * ARGUMENTS:
+   *   - source box corners:
+   *       const FLT *Min, *Max;
+   *   - transform matrix:
+   *       const FLT M[4][4];
+   *   - result box corners:
+   *       FLT *RMin, *RMax;
+   * RETURNS: None.
+   */
+  inline VOID BoxSSE( const FLT *Min, const FLT *Max, const FLT M[4][4], FLT *RMin, FLT *RMax )
+  {
+    const __m128 half = _mm_set1_ps(0.5f), sign = _mm_set1_ps(-0.0f);
+    __m128
+      mn = _mm_load_ps(Min),
+      mx = _mm_load_ps(Max);
+    alignas(16) FLT c[4], e[4];
+    _mm_store_ps(c, _mm_mul_ps(_mm_add_ps(mn, mx), half));
+    _mm_store_ps(e, _mm_mul_ps(_mm_sub_ps(mx, mn), half));
+
+    __m128
+      r0 = _mm_load_ps(M[0]),
+      r1 = _mm_load_ps(M[1]),
+      r2 = _mm_load_ps(M[2]),
+      center = _mm_load_ps(M[3]), ext;
+    center = _mm_add_ps(center, _mm_mul_ps(_mm_set1_ps(c[0]), r0));
+    center = _mm_add_ps(center, _mm_mul_ps(_mm_set1_ps(c[1]), r1));
+    center = _mm_add_ps(center, _mm_mul_ps(_mm_set1_ps(c[2]), r2));
+    ext = _mm_mul_ps(_mm_set1_ps(e[0]), _mm_andnot_ps(sign, r0));
+    ext = _mm_add_ps(ext, _mm_mul_ps(_mm_set1_ps(e[1]), _mm_andnot_ps(sign, r1)));
+    ext = _mm_add_ps(ext, _mm_mul_ps(_mm_set1_ps(e[2]), _mm_andnot_ps(sign, r2)));
+    _mm_store_ps(RMin, _mm_sub_ps(center, ext));
+    _mm_store_ps(RMax, _mm_add_ps(center, ext));
+  } /* End of 'BoxSSE' function */
+} /* end of anonymous namespace */
+
+/* Class constructor */
+tse::scene_graph::scene_graph( VOID )
+{
+} /* End of 'tse::scene_graph::scene_graph' function */
+
+/* Mark node dirty function.
+ * ARGUMENTS:
+ *   - node index:
+ *       INT I;
+ * RETURNS: None.
+ */
+VOID tse::scene_graph::MarkDirty( INT I )
+{
+  Dirty[I] = 1;
+  for (INT first = FirstDirty; I < first && !FirstDirty.compare_exchange_weak(first, I); )
+    ;
+} /* End of 'tse::scene_graph::MarkDirty' function */
+
+/* Reorder nodes function.
+ * ARGUMENTS:
+ *   - new order (old indices):
+ *       const std::vector<INT> &Order;
+ * RETURNS: None.
+ */
+VOID tse::scene_graph::Reorder( const std::vector<INT> &Order )
+{
+  auto Permute = [&Order]( auto &Array )
+    {
+      std::remove_reference_t<decltype(Array)> res(Order.size());
+      for (SIZE_T i = 0; i < Order.size(); i++)
+        res[i] = Array[Order[i]];
+      Array = std::move(res);
+    };
+
+  std::vector<INT> remap(Parent.size(), -1);
+  for (SIZE_T i = 0; i < Order.size(); i++)
+    remap[Order[i]] = (INT)i;
+  Permute(Parent);
+  Permute(SubtreeEnd);
+  Permute(Handle);
+  Permute(Local);
+  Permute(World);
+  Permute(LocalBB);
+  Permute(WorldBB);
+  Permute(Dirty);
+
+  INT first = INT_MAX;
+  for (INT i = 0; i < (INT)Parent.size(); i++)
+  {
+    if (Parent[i] != -1)
+      Parent[i] = remap[Parent[i]];
+    Index[Handle[i]] = i;
+    if (Dirty[i] && first == INT_MAX)
+      first = i;
+  }
+  FirstDirty = first;
+} /* End of 'tse::scene_graph::Reorder' function */
+
+/* Restore depth first order function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::scene_graph::Rebuild( VOID )
+{
+  /* Children grouped by parent (roots are children of -1) */
+  INT n = (INT)Parent.size();
+  std::vector<INT> start(n + 2, 0), children(n);
+  for (INT i = 0; i < n; i++)
+    start[Parent[i] + 2]++;
+  for (INT i = 1; i < n + 2; i++)
+    start[i] += start[i - 1];
+  for (INT i = 0; i < n; i++)
+    children[start[Parent[i] + 1]++] = i;
+
+  /* Depth first traversal (children keep their relative order) */
+  std::vector<INT> order, stack;
+  order.reserve(n);
+  for (INT i = start[0]; i-- > 0; )
+    stack.push_back(children[i]);
+  while (!stack.empty())
+  {
+    INT i = stack.back();
+    stack.pop_back();
+    order.push_back(i);
+    for (INT k = start[i + 1]; k-- > start[i]; )
+      stack.push_back(children[k]);
+  }
+  Reorder(order);
+
+  /* Subtree ranges: children follow parents */
+  for (INT i = 0; i < n; i++)
+    SubtreeEnd[i] = i + 1;
+  for (INT i = n - 1; i > 0; i--)
+    if (Parent[i] != -1)
+      SubtreeEnd[Parent[i]] = std::max(SubtreeEnd[Parent[i]], SubtreeEnd[i]);
+  IsOrderValid = TRUE;
+} /* End of 'tse::scene_graph::Rebuild' function */
+
+/* Add node function.
+ * ARGUMENTS:
+ *   - parent node (None for root):
+ *       node ParentNode;
+ *   - local transform:
+ *       const matr &Transform;
+ *   - local bound box:
+ *       const vec3 &MinBB, &MaxBB;
+ * RETURNS:
+ *   (node) new node handle (None if parent is not found).
+ */
+tse::scene_graph::node tse::scene_graph::Add( node ParentNode, const matr &Transform,
+                                              const vec3 &MinBB, const vec3 &MaxBB )
+{
+  if (ParentNode != None && !IsAlive(ParentNode))
+    return None;
+
+  node h;
+  if (!FreeHandles.empty())
+    h = FreeHandles.back(), FreeHandles.pop_back();
+  else
+    h = (node)Index.size(), Index.push_back(-1);
+  INT i = (INT)Parent.size(), p = ParentNode == None ? -1 : Index[ParentNode];
+  Index[h] = i;
+
+  /* Node appended right after parent subtree keeps order (e.g. hierarchy built depth first) */
+  if (IsOrderValid && (p == -1 || SubtreeEnd[p] == i))
+    for (INT a = p; a != -1; a = Parent[a])
+      SubtreeEnd[a] = i + 1;
+  else
+    IsOrderValid = FALSE;
+  Parent.push_back(p);
+  SubtreeEnd.push_back(i + 1);
+  Handle.push_back(h);
+  Local.emplace_back();
+  World.emplace_back();
+  LocalBB.emplace_back();
+  WorldBB.emplace_back();
+  Dirty.push_back(0);
+  SetLocal(h, Transform);
+  SetBound(h, MinBB, MaxBB);
+  return h;
+} /* End of 'tse::scene_graph::Add' function */
+
+/* Remove node with its subtree function.
+ * ARGUMENTS:
+ *   - node to remove:
+ *       node Node;
+ * RETURNS: None.
+ */
+VOID tse::scene_graph::Remove( node Node )
+{
+  if (!IsAlive(Node))
+    return;
+  if (!IsOrderValid)
+    Rebuild();
+
+  /* Subtree is contiguous range, ancestors ranges shrink */
+  INT n = (INT)Parent.size(), i = Index[Node], end = SubtreeEnd[i], cnt = end - i;
+  std::vector<INT> order;
+  order.reserve(n - cnt);
+  for (INT k = 0; k < n; k++)
+    if (k < i || k >= end)
+      order.push_back(k);
+    else
+    {
+      Index[Handle[k]] = -1;
+      FreeHandles.push_back(Handle[k]);
+    }
+  Reorder(order);
+  for (INT &e : SubtreeEnd)
+    if (e >= end)
+      e -= cnt;
+  std::erase_if(ChangedNodes, [this]( node H ){ return !IsAlive(H); });
+} /* End of 'tse::scene_graph::Remove' function */
+
+/* Change node parent function.
+ * ARGUMENTS:
+ *   - node to move:
+ *       node Node;
+ *   - new parent (None for root, node subtree is not allowed):
+ *       node ParentNode;
+ * RETURNS:
+ *   (BOOL) TRUE if success.
+ */
+BOOL tse::scene_graph::SetParent( node Node, node ParentNode )
+{
+  if (!IsAlive(Node) || (ParentNode != None && !IsAlive(ParentNode)))
+    return FALSE;
+
+  INT i = Index[Node], p = ParentNode == None ? -1 : Index[ParentNode];
+  if (p == Parent[i])
+    return TRUE;
+  for (INT a = p; a != -1; a = Parent[a])
+    if (a == i)
+    {
+      tse::logger::Warn("SCENE node can't be attached to its own subtree");
+      return FALSE;
+    }
+  Parent[i] = p;
+  IsOrderValid = FALSE;
+  MarkDirty(i);
+  return TRUE;
+} /* End of 'tse::scene_graph::SetParent' function */
+
+/* Set node local transform function.
+ * ARGUMENTS:
+ *   - node:
+ *       node Node;
+ *   - local transform:
+ *       const matr &Transform;
+ * RETURNS: None.
+ */
+VOID tse::scene_graph::SetLocal( node Node, const matr &Transform )
+{
+  if (!IsAlive(Node))
+    return;
+  INT i = Index[Node];
+  memcpy(Local[i].M, Transform.M, sizeof(Local[i].M));
+  MarkDirty(i);
+} /* End of 'tse::scene_graph::SetLocal' function */
+
+/* Set node local bound box function.
+ * ARGUMENTS:
+ *   - node:
+ *       node Node;
+ *   - local bound box:
+ *       const vec3 &MinBB, &MaxBB;
+ * RETURNS: None.
+ */
+VOID tse::scene_graph::SetBound( node Node, const vec3 &MinBB, const vec3 &MaxBB )
+{
+  if (!IsAlive(Node))
+    return;
+  INT i = Index[Node];
+  LocalBB[i] = {{MinBB.X, MinBB.Y, MinBB.Z, 1}, {MaxBB.X, MaxBB.Y, MaxBB.Z, 1}};
+  MarkDirty(i);
+} /* End of 'tse::scene_graph::SetBound' function */
+
+/* Recompute world transforms and bound boxes of dirty nodes function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::scene_graph::Update( VOID )
+{
+  auto start = std::chrono::steady_clock::now();
+  if (!IsOrderValid)
+    Rebuild();
+  INT n = (INT)Parent.size(), first = FirstDirty.exchange(INT_MAX);
+
+  /* Dirty node subtree is recomputed as a whole, parents are ready before children */
+  ChangedNodes.clear();
+  Stat.Scanned = 0;
+  for (INT i = first; i < n; )
+  {
+    if (UINT64 flags; i + 8 <= n && (memcpy(&flags, &Dirty[i], 8), flags == 0))
+    {
+      i += 8;
+      Stat.Scanned += 8;
+      continue;
+    }
+    if (!Dirty[i])
+    {
+      i++;
+      Stat.Scanned++;
+      continue;
+    }
+    for (INT end = SubtreeEnd[i]; i < end; i++)
+    {
+      if (INT p = Parent[i]; p == -1)
+        World[i] = Local[i];
+      else
+        MulSSE(Local[i].M, World[p].M, World[i].M);
+      BoxSSE(LocalBB[i].Min, LocalBB[i].Max, World[i].M, WorldBB[i].Min, WorldBB[i].Max);
+      Dirty[i] = 0;
+      ChangedNodes.push_back(Handle[i]);
+    }
+  }
+
+  Stat.Nodes = n;
+  Stat.Recomputed = (INT)ChangedNodes.size();
+  Stat.Scanned += Stat.Recomputed;
+  Stat.Time = std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - start).count();
+} /* End of 'tse::scene_graph::Update' function */
+
+/* Recompute all nodes world transforms (as without dirty flags) function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::scene_graph::UpdateAll( VOID )
+{
+  std::fill(Dirty.begin(), Dirty.end(), 1);
+  FirstDirty = 0;
+  Update();
+} /* End of 'tse::scene_graph::UpdateAll' function */
+
+/* Obtain node world transform function (valid after 'Update').
+ * ARGUMENTS:
+ *   - node:
+ *       node Node;
+ * RETURNS:
+ *   (matr) world transform.
+ */
+tse::matr tse::scene_graph::GetWorld( node Node ) const
+{
+  if (!IsAlive(Node))
+    return matr::Identity();
+  return matr((FLT (*)[4])World[Index[Node]].M);
+} /* End of 'tse::scene_graph::GetWorld' function */
+
+/* Obtain node world bound box function (valid after 'Update').
+ * ARGUMENTS:
+ *   - node:
+ *       node Node;
+ *   - world bound box:
+ *       vec3 &MinBB, &MaxBB;
+ * RETURNS: None.
+ */
+VOID tse::scene_graph::GetWorldBB( node Node, vec3 &MinBB, vec3 &MaxBB ) const
+{
+  if (!IsAlive(Node))
+  {
+    MinBB = MaxBB = vec3(0);
+    return;
+  }
+  const BOX &b = WorldBB[Index[Node]];
+  MinBB = vec3(b.Min[0], b.Min[1], b.Min[2]);
+  MaxBB = vec3(b.Max[0], b.Max[1], b.Max[2]);
+} /* End of 'tse::scene_graph::GetWorldBB' function */
+
+/* Obtain node parent function.
+ * ARGUMENTS:
+ *   - node:
+ *       node Node;
+ * RETURNS:
+ *   (node) parent node (None for roots and removed nodes).
+ */
+tse::scene_graph::node tse::scene_graph::GetParent( node Node ) const
+{
+  if (!IsAlive(Node) || Parent[Index[Node]] == -1)
+    return None;
+  return Handle[Parent[Index[Node]]];
+} /* End of 'tse::scene_graph::GetParent' function */
+
+/* Remove all nodes function.
+ * ARGUMENTS: None.
+ * RETURNS: None.
+ */
+VOID tse::scene_graph::Clear( VOID )
+{
+  Parent.clear();
+  SubtreeEnd.clear();
+  Handle.clear();
+  Local.clear();
+  World.clear();
+  LocalBB.clear();
+  WorldBB.clear();
+  Dirty.clear();
+  Index.clear();
+  FreeHandles.clear();
+  ChangedNodes.clear();
+  FirstDirty = INT_MAX;
+  IsOrderValid = TRUE;
+  Stat = {};
+} /* End of 'tse::scene_graph::Clear' function */
+
+/* END OF 'scene.cpp' FILE */
@@ -0,0 +1,255 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : scene.h
+ * PURPOSE     : Tough Space Exploration project.
+ *               Scene module.
+ *               Scene graph declaration module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __scene_h_
+#define __scene_h_
+
+/* Main program namespace */
+namespace tse
+{
+  /* Scene graph class.
+   * Nodes are stored in flat arrays in depth first order: parent precedes
+   * its children and every subtree is a contiguous range. Changing local
+   * transform marks node dirty, 'Update' skips clean nodes 8 flags at once
+   * and recomputes world matrices (SSE) and world bound boxes of each dirty
+   * node subtree range. Structure changes append nodes or relink parents,
+   * depth first order is restored by next update.
+   * Node handles stay valid until node removal, array indices do not.
+   * Structure changes are render thread only, 'SetLocal' and 'SetBound' of
+   * different nodes may be called concurrently (e.g. by concurrent units). */
+  class scene_graph
+  {
+  public:
+    using node = INT;        // Node handle
+    static const node None = -1; // No node (root parent)
+
+    /* Update statistics structure */
+    struct STATS
+    {
+      INT Nodes = 0;      // Number of nodes
+      INT Scanned = 0;    // Nodes visited by last update
+      INT Recomputed = 0; // World matrices recomputed by last update
+      DBL Time = 0;       // Last update time (ms)
+    }; /* End of 'STATS' structure */
+
+  private:
+    /* 16 bytes aligned matrix structure */
+    struct alignas(16) XFORM
+    {
+      FLT M[4][4]; // Matrix (row vectors convention, as 'matr')
+    }; /* End of 'XFORM' structure */
+
+    /* 16 bytes aligned bound box structure */
+    struct alignas(16) BOX
+    {
+      FLT Min[4], Max[4]; // Corners (W is not used)
+    }; /* End of 'BOX' structure */
+
+    /* Flat arrays by node index (depth first order) */
+    std::vector<INT> Parent;      // Parent node index (-1 for roots)
+    std::vector<INT> SubtreeEnd;  // Index after node subtree
+    std::vector<node> Handle;     // Node handle
+    std::vector<XFORM> Local;     // Local transforms
+    std::vector<XFORM> World;     // World transforms
+    std::vector<BOX> LocalBB;     // Local bound boxes
+    std::vector<BOX> WorldBB;     // World bound boxes
+    std::vector<BYTE> Dirty;      // Local transform or bound change flags
+
+    /* Handles */
+    std::vector<INT> Index;       // Node index by handle (-1 for free handles)
+    std::vector<node> FreeHandles; // Free handles
+
+    std::atomic<INT> FirstDirty {INT_MAX}; // Minimal dirty node index
+    BOOL IsOrderValid = TRUE;             // Depth first order flag (FALSE after structure change)
+    std::vector<node> ChangedNodes;       // Nodes with world transform changed by last update
+    STATS Stat;                           // Last update statistics
+
+    /* Reorder nodes function.
+     * ARGUMENTS:
+     *   - new order (old indices):
+     *       const std::vector<INT> &Order;
+     * RETURNS: None.
+     */
+    VOID Reorder( const std::vector<INT> &Order );
+
+    /* Restore depth first order function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Rebuild( VOID );
+
+    /* Mark node dirty function.
+     * ARGUMENTS:
+     *   - node index:
+     *       INT I;
+     * RETURNS: None.
+     */
+    VOID MarkDirty( INT I );
+
+  public:
+    /* Class constructor */
+    scene_graph( VOID );
+
+    /* Add node function.
+     * ARGUMENTS:
+     *   - parent node (None for root):
+     *       node ParentNode;
+     *   - local transform:
+     *       const matr &Transform;
+     *   - local bound box:
+     *       const vec3 &MinBB, &MaxBB;
+     * RETURNS:
+     *   (node) new node handle (None if parent is not found).
+     */
+    node Add( node ParentNode, const matr &Transform = matr::Identity(),
+              const vec3 &MinBB = vec3(0), const vec3 &MaxBB = vec3(0) );
+
+    /* Remove node with its subtree function.
+     * ARGUMENTS:
+     *   - node to remove:
+     *       node Node;
+     * RETURNS: None.
+     */
+    VOID Remove( node Node );
+
+    /* Change node parent function.
+     * ARGUMENTS:
+     *   - node to move:
+     *       node Node;
+     *   - new parent (None for root, node subtree is not allowed):
+     *       node ParentNode;
+     * RETURNS:
+     *   (BOOL) TRUE if success.
+     */
+    BOOL SetParent( node Node, node ParentNode );
+
+    /* Set node local transform function.
+     * ARGUMENTS:
+     *   - node:
+     *       node Node;
+     *   - local transform:
+     *       const matr &Transform;
+     * RETURNS: None.
+     */
+    VOID SetLocal( node Node, const matr &Transform );
+
+    /* Set node local bound box function.
+     * ARGUMENTS:
+     *   - node:
+     *       node Node;
+     *   - local bound box:
+     *       const vec3 &MinBB, &MaxBB;
+     * RETURNS: None.
+     */
+    VOID SetBound( node Node, const vec3 &MinBB, const vec3 &MaxBB );
+
+    /* Recompute world transforms and bound boxes of dirty nodes function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Update( VOID );
+
+    /* Recompute all nodes world transforms (as without dirty flags) function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID UpdateAll( VOID );
+
+    /* Obtain node world transform function (valid after 'Update').
+     * ARGUMENTS:
+     *   - node:
+     *       node Node;
+     * RETURNS:
+     *   (matr) world transform.
+     */
+    matr GetWorld( node Node ) const;
+
+    /* Obtain node world bound box function (valid after 'Update').
+     * ARGUMENTS:
+     *   - node:
+     *       node Node;
+     *   - world bound box:
+     *       vec3 &MinBB, &MaxBB;
+     * RETURNS: None.
+     */
+    VOID GetWorldBB( node Node, vec3 &MinBB, vec3 &MaxBB ) const;
+
+    /* Obtain node parent function.
+     * ARGUMENTS:
+     *   - node:
+     *       node Node;
+     * RETURNS:
+     *   (node) parent node (None for roots and removed nodes).
+     */
+    node GetParent( node Node ) const;
+
+    /* Check node existence function.
+     * ARGUMENTS:
+     *   - node:
+     *       node Node;
+     * RETURNS:
+     *   (BOOL) TRUE if node is alive.
+     */
+    BOOL IsAlive( node Node ) const
+    {
+      return Node >= 0 && Node < (INT)Index.size() && Index[Node] != -1;
+    } /* End of 'IsAlive' function */
+
+    /* Obtain nodes changed by last update function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const std::vector<node> &) changed nodes handles.
+     */
+    const std::vector<node> & Changed( VOID ) const
+    {
+      return ChangedNodes;
+    } /* End of 'Changed' function */
+
+    /* Obtain last update statistics function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const STATS &) statistics.
+     */
+    const STATS & Stats( VOID ) const
+    {
+      return Stat;
+    } /* End of 'Stats' function */
+
+    /* Obtain number of nodes function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) number of nodes.
+     */
+    INT NumOfNodes( VOID ) const
+    {
+      return (INT)Parent.size();
+    } /* End of 'NumOfNodes' function */
+
+    /* Remove all nodes function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Clear( VOID );
+
+  }; /* End of 'scene_graph' class */
+
+} /* end of 'tse' namespace */
+
+#endif /* __scene_h_ */
+
+/* END OF 'scene.h' FILE */
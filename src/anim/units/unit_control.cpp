@@ -9,7 +9,7 @@
  *               Control handle unit.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7)
- * LAST UPDATE : 03.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -28,8 +28,13 @@ namespace tse
     class unit_sample : public unit
     {
     private:
-      anim *Ani; // Animation context pointer
-      font *F;   // Font to draw
+      anim *Ani;           // Animation context pointer
+      font *F;             // Font to draw
+      BOOL IsProfileDraw;  // GPU profile overlay draw flag
+      std::string CPUProf; // Last CPU profile capture report (empty if profiler is off)
+
+      // Frame scheduling modes names
+      static inline const CHAR *FrameModes[] {"uncapped", "capped", "vsync", "on demand"};
 
     public:
       /* Type constructor function.
@@ -37,10 +42,10 @@ namespace tse
        *   - animation context pointer:
        *       anim *NewAni;
        */
-      unit_sample( anim *NewAni ) : Ani(NewAni)
+      unit_sample( anim *NewAni ) : Ani(NewAni), IsProfileDraw(FALSE)
       {
         Ani->Cam.SetLocAtUp({8, 8, 8}, {0, 0, 0}, {0, 1, 0});
-        (F = Ani->FntCreate("Book"))->Load("bin/fonts/Book.g3df");
+        F = Ani->FntLoadAsync("bin/fonts/Book.g3df");
       } /* End of ''unit_sample' function */
 
       /* Type destructor function */
@@ -63,6 +68,37 @@ namespace tse
           DestroyWindow(Ani->hWnd);
         else if (Ani->Keys[VK_CONTROL] && Ani->KeysClick['F'])
           Ani->Cam.SetLocAtUp({8, 8, 8}, {0, 0, 0}, {0, 1, 0});
+        /* Frame pacing control */
+        else if (Ani->Keys[VK_SHIFT] && Ani->KeysClick['F'])
+          Ani->FramesInFlight = Ani->FramesInFlight % 3 + 1;
+        else if (Ani->Keys[VK_SHIFT] && Ani->KeysClick['L'])
+          Ani->IsLowLatency = !Ani->IsLowLatency;
+        else if (Ani->Keys[VK_SHIFT] && Ani->KeysClick['M'])
+        {
+          tse::logger::Info(std::format("Frame mode {}: {:.1f} FPS, CPU usage {:.0f}%",
+            FrameModes[(INT)Ani->FrameMode], Ani->FPS, Ani->CPUUsage));
+          Ani->FrameMode = (render::frame_mode)(((INT)Ani->FrameMode + 1) % 4);
+        }
+        /* GPU profiler overlay and dump */
+        else if (Ani->Keys[VK_SHIFT] && Ani->KeysClick['G'])
+          IsProfileDraw = !IsProfileDraw;
+        else if (Ani->Keys[VK_CONTROL] && Ani->KeysClick['G'])
+          Ani->GPUProf.Dump(anim::Path() + "bin/gpu_profile.csv");
+        /* CPU profiler overlay and Chrome trace dump */
+        else if (Ani->Keys[VK_SHIFT] && Ani->KeysClick['C'])
+        {
+          profiler::Enable(!profiler::IsOn());
+          CPUProf.clear();
+        }
+        else if (Ani->Keys[VK_CONTROL] && Ani->KeysClick['C'] &&
+                 profiler::DumpTrace(anim::Path() + "bin/cpu_trace.json"))
+          tse::logger::Info("CPU trace dumped: " + anim::Path() + "bin/cpu_trace.json");
+        /* Frame times dump */
+        else if (Ani->Keys[VK_CONTROL] && Ani->KeysClick['T'])
+          Ani->FrameTimesDump(anim::Path() + "bin/frame_times.csv");
+        /* Resources memory usage */
+        else if (Ani->Keys[VK_CONTROL] && Ani->KeysClick['R'])
+          tse::logger::Info("Resources usage:\n" + Ani->ResourcesReport());
         /* Wireframe / solid render switch */
         else if (INT modes[2]; Ani->Keys[VK_SHIFT] && Ani->KeysClick['W'])
         {
@@ -72,6 +108,13 @@ namespace tse
           else
             glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
         }
+        /* Scene object picking */
+        else if (FLT t; Ani->KeysClick[VK_LBUTTON] && !Ani->Keys[VK_LCONTROL])
+        {
+          INT node = Ani->SceneBVH.Pick(Ani->Cam.FrameRay(Ani->Mx, Ani->My), t);
+          if (node != -1)
+            tse::logger::Info(std::format("Picked scene node {} at distance {:.3f}", node, t));
+        }
         /* Rotate camera */
         else if (Ani->Keys[VK_LCONTROL])
         {
@@ -145,7 +188,31 @@ namespace tse
       {
         matr save_vp = Ani->Cam.VP;
         Ani->Cam.VP = matr::Ortho(0, Ani->W, -Ani->H, 0, -1, 1);
-        F->Draw(std::format("CGSG SumCamp'2025 forever!\nFPS: {:3.6}", Ani->FPS), vec3(0, 3, 0), 64);
+        F->Draw("CGSG SumCamp'2025 forever!", vec3(0, 3, 0), 64, TRUE);
+        F->Draw(std::format("FPS: {:3.6}", Ani->FPS), vec3(0, 3 - 64, 0), 64);
+        timer::FRAME_TIME_STATS ft = Ani->FrameTimeStats();
+        F->Draw(std::format("CPU: {:.2f} ms, GPU wait: {:.2f} ms, present: {:.2f} ms\n"
+                            "Frame: p50 {:.2f} p95 {:.2f} p99 {:.2f} max {:.2f} ms, hitches: {}\n"
+                            "In flight: {}{}, mode: {}{}, CPU usage: {:.0f}%",
+                            Ani->FrameStats.CPUFrameTime, Ani->FrameStats.GPUWaitTime,
+                            Ani->FrameStats.PresentTime,
+                            ft.P50, ft.P95, ft.P99, ft.Max, ft.Hitches, Ani->FramesInFlight,
+                            Ani->IsLowLatency ? " (low latency)" : "",
+                            FrameModes[(INT)Ani->FrameMode],
+                            Ani->FrameMode == render::frame_mode::CAPPED ? std::format(" {} FPS", Ani->MaxFPS) : "",
+                            Ani->CPUUsage),
+                vec3(0, -125, 0), 24);
+        if (IsProfileDraw)
+          Ani->GPUProf.Draw(F, vec3(0, -205, 0), 18);
+
+        /* CPU profile summary is refreshed by captures of 120 frames */
+        if (profiler::IsOn() && profiler::Frames() >= 120)
+        {
+          CPUProf = profiler::Report();
+          profiler::Reset();
+        }
+        if (!CPUProf.empty())
+          F->Draw("CPU profile (per frame):\n" + CPUProf, vec3(Ani->W / 2, -205, 0), 18);
         Ani->Cam.VP = save_vp;
       } /* End of 'Render' function */
 
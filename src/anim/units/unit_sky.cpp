@@ -9,7 +9,7 @@
  *               Sky unit.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7)
- * LAST UPDATE : 04.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -29,7 +29,7 @@ namespace tse
     {
     private:
       anim *Ani; // Animation context pointer
-      prim *Sky; // Sky triangle primitive
+      res_ref<prim> Sky; // Sky triangle primitive (deleted with unit)
 
     public:
       /* Type constructor function.
@@ -45,7 +45,7 @@ namespace tse
           {{-1, 3, 0}, {0, 0}, {0, 1, 0}, {0, 0, 1, 1}}};
         Sky = Ani->PrimCreate<tse::vertex_std4>(
           Ani->MtlCreate("Sky material", vec3(0.1), vec3(0.8), vec3(0.5), 30, 1,
-            Ani->ShdCreate("sky"), {Ani->TexCreate("bin/textures/sky0.bmp")}),
+            Ani->ShdCreate("sky"), {Ani->TexLoadAsync("bin/textures/sky0.bmp")}),
           prim_type::TRIMESH, V, {});
       } /* End of ''unit_sample' function */
 
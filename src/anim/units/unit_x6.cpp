@@ -9,7 +9,7 @@
  *               'X6' G3DM model test unit.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7)
- * LAST UPDATE : 03.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -28,8 +28,15 @@ namespace tse
     class unit_sample : public unit
     {
     private:
-      anim *Ani; // Animation context pointer
-      model Btr; // Car model
+      anim *Ani;                     // Animation context pointer
+      model Btr;                     // Car model
+      scene_graph::node
+        Root,                        // Ship placement scene node
+        Body;                        // Model (centered in ship) scene node
+      bvh::proxy BodyObject;         // Model node culling and picking object
+      DBL
+        Angle = 0,     // Current simulated rotation angle
+        OldAngle = 0;  // Previous step rotation angle
 
     public:
       /* Type constructor function.
@@ -39,20 +46,49 @@ namespace tse
        */
       unit_sample( anim *NewAni ) : Ani(NewAni)
       {
-        Btr.Load("bin/models/X6.g3dm", matr::RotateX(-90));
+        IsConcurrent = TRUE;
+        Root = Ani->Scene.Add(scene_graph::None);
+        Body = Ani->Scene.Add(Root);
+        /* World bound box is moved by next scene update */
+        BodyObject = Ani->SceneBVH.Track(Ani->Scene, Body);
+        Btr.LoadAsync("bin/models/X6.g3dm", matr::RotateX(-90), vec3(1, 0, 0),
+          [this]( model *Mdl, BOOL IsOk )
+          {
+            /* Model bound box is known after loading */
+            if (!IsOk)
+              return;
+            Ani->Scene.SetLocal(Body, matr::Translate(-(Mdl->MinBB + Mdl->MaxBB) / 2));
+            Ani->Scene.SetBound(Body, Mdl->MinBB, Mdl->MaxBB);
+          });
       } /* End of ''unit_sample' function */
 
       /* Type destructor function */
       ~unit_sample( VOID )
       {
+        Ani->SceneBVH.Remove(BodyObject);
+        Ani->Scene.Remove(Root);
       } /* End of ''~unit_sample' function */
 
+      /* Unit fixed step simulation function.
+       * ARGUMENTS:
+       *   - simulation step in seconds:
+       *       DBL Step;
+       * RETURNS: None.
+       */
+      VOID Simulate( DBL Step ) override
+      {
+        OldAngle = Angle;
+        Angle += 30 * Step;
+      } /* End of 'Simulate' function */
+
       /* Unit response function.
        * ARGUMENTS: None.
        * RETURNS: None.
        */
       VOID Response( VOID ) override
       {
+        /* World matrices are recomputed by scene graph update */
+        Ani->Scene.SetLocal(Root, matr::RotateY(OldAngle + (Angle - OldAngle) * Ani->SimAlpha));
       } /* End of 'Response' function */
 
       /* Unit render function.
@@ -61,8 +97,8 @@ namespace tse
        */
       VOID Render( VOID ) override
       {
-        Ani->Draw(&Btr, matr::Translate(-(Btr.MinBB + Btr.MaxBB) / 2) * 
-                        matr::RotateY(30.0 * Ani->Time));
+        if (Ani->IsVisible(Body))
+          Ani->Draw(&Btr, Ani->Scene.GetWorld(Body));
       } /* End of 'Render' function */
 
     }; /* End of 'unit_sample' class */
@@ -8,7 +8,7 @@
  *               Common definitions module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7)
- * LAST UPDATE : 03.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -58,21 +58,43 @@ static struct __Dummy
 #include <wincodec.h>
 
 #include <vector>
+#include <deque>
 #include <string>
 #include <cstring>
 #include <map>
+#include <set>
 #include <span>
+#include <algorithm>
+#include <random>
+#include <limits>
 
 #include <functional>
+#include <typeinfo>
 #include <exception>
 #include <thread>
+#include <barrier>
+#include <atomic>
 #include <mutex>
+#include <condition_variable>
+#include <future>
 #include <chrono>
+#include <ctime>
 
 #include <iostream>
 #include <format>
 #include <filesystem>
 #include <fstream>
+#include <sstream>
+
+#include <xmmintrin.h>
+
+#ifndef _WIN32
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif /* _WIN32 */
 
 /* Main program namespace */
 namespace tse
@@ -117,13 +139,114 @@ namespace tse
 
     }; /* End of 'stock' class */
 
-  /* Directory watcher class representation */
+  /* Directory watcher class representation.
+   * Changed files are reported relative to watched directory with '/'
+   * separators; empty name means unknown changes (notification overflow). */
   class dir_watcher
   {
-    OVERLAPPED Ovr {};       // Overlapped structure for changing hook
-    HANDLE hDir {};          // Traching directory handle
-    BYTE Buffer[30 * 47] {}; // Read directory changes data buffer
-    std::string Path;        // Store path
+#ifdef _WIN32
+    OVERLAPPED Ovr {};                   // Overlapped structure for changing hook
+    HANDLE hDir {};                      // Traching directory handle
+    alignas(DWORD) BYTE Buffer[16384] {}; // Read directory changes data buffer
+#else
+    INT Fd = -1;                         // Inotify instance descriptor
+    std::map<INT, std::string> Dirs;     // Watched subdirectories (with trailing '/') by watch descriptor
+#endif /* _WIN32 */
+    std::string Path;                    // Store path
+    std::vector<std::string> Changed;    // Changed files not reported yet
+
+#ifdef _WIN32
+    /* Start asynchronous changes reading function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Read( VOID )
+    {
+      ReadDirectoryChangesW(hDir,
+        Buffer, sizeof(Buffer),
+        TRUE,
+        FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_CREATION |
+          FILE_NOTIFY_CHANGE_FILE_NAME,
+        nullptr,
+        &Ovr,
+        nullptr);
+    } /* End of 'Read' function */
+#else
+    /* Add subdirectory watch function.
+     * ARGUMENTS:
+     *   - subdirectory relative path (empty or with trailing '/'):
+     *       const std::string &Rel;
+     * RETURNS: None.
+     */
+    VOID AddDir( const std::string &Rel )
+    {
+      INT wd = inotify_add_watch(Fd, (Path + "/" + Rel).c_str(),
+        IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE);
+      if (wd >= 0)
+        Dirs[wd] = Rel;
+    } /* End of 'AddDir' function */
+#endif /* _WIN32 */
+
+    /* Collect pending change notifications function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Poll( VOID )
+    {
+#ifdef _WIN32
+      DWORD size = 0;
+      if (Ovr.hEvent == nullptr || hDir == nullptr ||
+          !GetOverlappedResult(hDir, &Ovr, &size, FALSE))
+        return;
+      if (size == 0)
+        Changed.push_back("");
+      else
+        for (BYTE *ptr = Buffer; ; )
+        {
+          auto *fni = reinterpret_cast<FILE_NOTIFY_INFORMATION *>(ptr);
+          INT
+            wlen = fni->FileNameLength / sizeof(WCHAR),
+            len = WideCharToMultiByte(CP_UTF8, 0, fni->FileName, wlen, nullptr, 0, nullptr, nullptr);
+          std::string name(len, 0);
+          WideCharToMultiByte(CP_UTF8, 0, fni->FileName, wlen, name.data(), len, nullptr, nullptr);
+          std::replace(name.begin(), name.end(), '\\', '/');
+          Changed.push_back(name);
+          if (fni->NextEntryOffset == 0)
+            break;
+          ptr += fni->NextEntryOffset;
+        }
+      /* Restart monitoring */
+      ResetEvent(Ovr.hEvent);
+      Read();
+#else
+      if (Fd < 0)
+        return;
+      alignas(inotify_event) CHAR buf[4096];
+      for (INT len; (len = (INT)read(Fd, buf, sizeof(buf))) > 0; )
+        for (CHAR *ptr = buf; ptr < buf + len; )
+        {
+          auto *ev = reinterpret_cast<inotify_event *>(ptr);
+          ptr += sizeof(inotify_event) + ev->len;
+          if (ev->mask & IN_Q_OVERFLOW)
+          {
+            Changed.push_back("");
+            continue;
+          }
+          auto dir = Dirs.find(ev->wd);
+          if (dir == Dirs.end() || ev->len == 0)
+            continue;
+          std::string name = dir->second + ev->name;
+          /* Inotify is not recursive: new subdirectories are watched separately */
+          if (ev->mask & IN_ISDIR)
+          {
+            if (ev->mask & (IN_CREATE | IN_MOVED_TO))
+              AddDir(name + "/");
+          }
+          else
+            Changed.push_back(name);
+        }
+#endif /* _WIN32 */
+    } /* End of 'Poll' function */
  
   public:
     /* Start directory watching function.
@@ -135,8 +258,9 @@ namespace tse
     VOID StartWatch( const std::string &DirPath )
     {
       StopWatch();
-      ZeroMemory(&Ovr, sizeof(OVERLAPPED));
       Path = DirPath;
+#ifdef _WIN32
+      ZeroMemory(&Ovr, sizeof(OVERLAPPED));
       /* Open directory */
       hDir =
         CreateFile(DirPath.c_str(),
@@ -147,14 +271,16 @@ namespace tse
           nullptr);
       /* Start monitoring */
       Ovr.hEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
-      ReadDirectoryChangesW(hDir,
-        Buffer, sizeof(Buffer),
-        TRUE,
-        FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_CREATION |
-          FILE_NOTIFY_CHANGE_FILE_NAME,
-        nullptr,
-        &Ovr,
-        nullptr);
+      Read();
+#else
+      if ((Fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) < 0)
+        return;
+      AddDir("");
+      std::error_code ec;
+      for (auto &e : std::filesystem::recursive_directory_iterator(Path, ec))
+        if (e.is_directory())
+          AddDir(std::filesystem::relative(e.path(), Path, ec).generic_string() + "/");
+#endif /* _WIN32 */
     } /* End of 'StartWatch' function */
  
     /* Stop directory watching function.
@@ -163,13 +289,21 @@ namespace tse
      */
     VOID StopWatch( VOID )
     {
+#ifdef _WIN32
       if (Ovr.hEvent != nullptr)
         CloseHandle(Ovr.hEvent);
       if (hDir != nullptr)
         CloseHandle(hDir);
       ZeroMemory(&Ovr, sizeof(OVERLAPPED));
       hDir = nullptr;
+#else
+      if (Fd >= 0)
+        close(Fd);
+      Fd = -1;
+      Dirs.clear();
+#endif /* _WIN32 */
       Path = "";
+      Changed.clear();
     } /* End of 'StopWatch' function */
  
     /* Check if directory is changed function.
@@ -179,26 +313,26 @@ namespace tse
      */
     BOOL IsChanged( VOID )
     {
-      if (Ovr.hEvent == nullptr || hDir == nullptr)
-        return FALSE;
-      INT id = WaitForSingleObject(Ovr.hEvent, 0);
-      if (id == WAIT_OBJECT_0)
-      {
-        /* Restart monitoring */
-        ResetEvent(Ovr.hEvent);
-        ReadDirectoryChangesW(hDir,
-          Buffer, sizeof(Buffer),
-          TRUE,
-          FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_CREATION |
-            FILE_NOTIFY_CHANGE_FILE_NAME,
-          nullptr,
-          &Ovr,
-          nullptr);
-        return TRUE;
-      }
-      return FALSE;
+      Poll();
+      BOOL is_changed = !Changed.empty();
+      Changed.clear();
+      return is_changed;
     } /* End of 'IsChanged' function */
 
+    /* Obtain changed files function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (std::vector<std::string>) files changed since previous call (may repeat).
+     */
+    std::vector<std::string> Changes( VOID )
+    {
+      std::vector<std::string> res;
+
+      Poll();
+      res.swap(Changed);
+      return res;
+    } /* End of 'Changes' function */
+
   }; /* End of 'dir_watcher' class */
 
    /* Unstructured data file reader class */
@@ -253,6 +387,39 @@ namespace tse
       } /* End of 'operator()' function */
   }; /* End of 'rdr' class */
 
+  /* Evaluate data hash (64-bit FNV-1a) function.
+   * ARGUMENTS:
+   *   - data pointer:
+   *       const VOID *Data;
+   *   - data size in bytes:
+   *       SIZE_T Size;
+   *   - previous hash value (to chain several blocks):
+   *       UINT64 Hash;
+   * RETURNS:
+   *   (UINT64) hash value.
+   */
+  inline UINT64 Hash64( const VOID *Data, SIZE_T Size, UINT64 Hash = 0xCBF29CE484222325 )
+  {
+    const BYTE *ptr = (const BYTE *)Data;
+    for (SIZE_T i = 0; i < Size; i++)
+      Hash = (Hash ^ ptr[i]) * 0x100000001B3;
+    return Hash;
+  } /* End of 'Hash64' function */
+
+  /* Evaluate string hash (64-bit FNV-1a) function.
+   * ARGUMENTS:
+   *   - string:
+   *       const std::string &Str;
+   *   - previous hash value (to chain several blocks):
+   *       UINT64 Hash;
+   * RETURNS:
+   *   (UINT64) hash value.
+   */
+  inline UINT64 Hash64( const std::string &Str, UINT64 Hash = 0xCBF29CE484222325 )
+  {
+    return Hash64(Str.data(), Str.size(), Hash);
+  } /* End of 'Hash64' function */
+
 } /* end of 'tse' namespace */
 
 #endif /* __def_h_ */
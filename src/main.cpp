@@ -8,7 +8,7 @@
  *               Main entry point module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7).
- * LAST UPDATE : 01.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -29,13 +29,169 @@
  *       INT CmdShow;
  * RETURNS:
  *   (INT) Error level for operation system (0 for success).
+ * NOTE: headless benchmark modes command line:
+ *   -headless [-frames N] [-size WxH] [-units A,B,...] [-out prefix] [-novariants] [-profile]
+ *   -submitbench [-count N] [-out prefix]
+ *   -shaderbench
+ *   -vaobench [-count N]
+ *   -jobbench
+ *   -logbench [-count N]
+ *   -loadbench [-count N]
+ *   -warmupbench [-manifest file] [-count N] (e.g. bin/scenes/default.manifest, synthetic scene by default)
+ *   -logdecode file.tlog [-json] [-out file] (binary log to text/JSON)
+ *   -packbuild [-dir bin] [-out bin/data.tpk] [-store] (assets pack, mounted at startup when present)
+ *   -scenebench [-count N] [-frames N]
+ *   -bvhbench [-count N] (10K, 100K and 1M objects by default)
+ * window mode options:
+ *   -simrate N (fixed simulation ticks per second, 60 by default)
+ *   -binlog file.tlog (leveled messages go to binary structured log)
  */
 INT WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance,
                     CHAR *CmdLine, INT ShowCmd )
 {
   tse::logger::Aim("Starting up...");
 
+  /* Packed assets shadow loose files, mounted before anything is loaded */
+  if (std::filesystem::exists("bin/data.tpk"))
+    tse::vfs::Mount("bin/data.tpk");
+
   tse::anim &my_anim = tse::anim::Get();
+
+  /* Headless benchmark mode */
+  std::istringstream args(CmdLine != nullptr ? CmdLine : "");
+  if (std::string arg; args >> arg && arg == "-headless")
+  {
+    tse::anim::HEADLESS_PARAMS params;
+    params.Units = {"Sky", "Axis", "X6"};
+    while (args >> arg)
+      if (arg == "-frames")
+        args >> params.Frames;
+      else if (arg == "-size")
+      {
+        CHAR x;
+        args >> params.W >> x >> params.H;
+      }
+      else if (arg == "-units")
+      {
+        std::string list, name;
+        args >> list;
+        std::istringstream names(list);
+        params.Units.clear();
+        while (std::getline(names, name, ','))
+          params.Units.push_back(name);
+      }
+      else if (arg == "-out")
+        args >> params.OutPrefix;
+      else if (arg == "-novariants")
+        params.IsVariants = FALSE;
+      else if (arg == "-profile")
+        params.IsProfile = TRUE;
+    return my_anim.RunHeadless(params);
+  }
+  else if (arg == "-submitbench")
+  {
+    INT count = 100000;
+    std::string out = "bin/submit";
+    while (args >> arg)
+      if (arg == "-count")
+        args >> count;
+      else if (arg == "-out")
+        args >> out;
+    return my_anim.RunSubmitBench(count, out);
+  }
+  else if (arg == "-shaderbench")
+    return my_anim.RunShaderBench();
+  else if (arg == "-vaobench")
+  {
+    INT count = 10000;
+    if (args >> arg && arg == "-count")
+      args >> count;
+    return my_anim.RunVAOBench(count);
+  }
+  else if (arg == "-jobbench")
+    return my_anim.RunJobBench();
+  else if (arg == "-logbench")
+  {
+    INT count = 200000;
+    if (args >> arg && arg == "-count")
+      args >> count;
+    return my_anim.RunLogBench(count);
+  }
+  else if (arg == "-loadbench")
+  {
+    INT count = 32;
+    if (args >> arg && arg == "-count")
+      args >> count;
+    return my_anim.RunLoadBench(count);
+  }
+  else if (arg == "-warmupbench")
+  {
+    INT count = 32;
+    std::string manifest;
+    while (args >> arg)
+      if (arg == "-manifest")
+        args >> manifest;
+      else if (arg == "-count")
+        args >> count;
+    return my_anim.RunWarmupBench(manifest, count);
+  }
+  else if (arg == "-logdecode")
+  {
+    std::string in, out;
+    BOOL is_json = FALSE;
+    args >> in;
+    while (args >> arg)
+      if (arg == "-json")
+        is_json = TRUE;
+      else if (arg == "-out")
+        args >> out;
+    INT n = tse::binlog::Decode(in, out, is_json);
+    if (n < 0)
+      tse::logger::Err("Not a binary log: " + in);
+    else
+      tse::logger::Info(std::format("{} events decoded from {}", n, in));
+    return n < 0;
+  }
+  else if (arg == "-packbuild")
+  {
+    std::string dir = "bin", out = "bin/data.tpk";
+    BOOL is_compress = TRUE;
+    while (args >> arg)
+      if (arg == "-dir")
+        args >> dir;
+      else if (arg == "-out")
+        args >> out;
+      else if (arg == "-store")
+        is_compress = FALSE;
+    return my_anim.RunPackBuild(dir, out, is_compress);
+  }
+  else if (arg == "-scenebench")
+  {
+    INT count = 100000, frames = 100;
+    while (args >> arg)
+      if (arg == "-count")
+        args >> count;
+      else if (arg == "-frames")
+        args >> frames;
+    return my_anim.RunSceneBench(count, frames);
+  }
+  else if (arg == "-bvhbench")
+  {
+    INT count = 0;
+    while (args >> arg)
+      if (arg == "-count")
+        args >> count;
+    return my_anim.RunBVHBench(count);
+  }
+  else if (arg == "-simrate")
+  {
+    DBL rate = 60;
+    args >> rate;
+    my_anim.SetSimRate(rate);
+  }
+  else if (arg == "-binlog" && args >> arg)
+    tse::logger::SetBinaryOutput(arg);
+
   my_anim.Create("CGSG SumCamp'2025 AB7 Animation Window");
   my_anim << "Sky" << "Axis" << "X6" << "Control";
   my_anim.Run();
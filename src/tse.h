@@ -8,7 +8,7 @@
  *               Use PCH module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7)
- * LAST UPDATE : 31.07.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -22,8 +22,12 @@
 #include "def.h"
 
 /* Project includes */
-#include "utils/images/images.h"
+#include "utils/logger/binlog.h"
 #include "utils/logger/logger.h"
+#include "utils/profiler/profiler.h"
+#include "utils/jobs/jobs.h"
+#include "utils/vfs/vfs.h"
+#include "utils/images/images.h"
 #include "win/win.h"
 #include "anim/anim.h"
 
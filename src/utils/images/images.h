@@ -9,7 +9,7 @@
  *               Images handle module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7)
- * LAST UPDATE : 31.07.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -31,6 +31,7 @@ namespace tse
 
     // Windows Imaging Component factory
     inline static IWICImagingFactory2 *WicFactory = nullptr;
+    inline static std::mutex WicLock; // Factory creation lock (images are loaded from many threads)
 
   public:
     std::vector<DWORD *> RowsD;     // Rows access pointer by DWORD
@@ -43,6 +44,30 @@ namespace tse
     {
     } /* End of 'image' function */
  
+    /* Class construtor function.
+     * ARGUMENTS:
+     *   - image size:
+     *       INT NewW, NewH;
+     *   - BGRA pixel data (may be nullptr for black image):
+     *       const BYTE *Data;
+     */
+    image( INT NewW, INT NewH, const BYTE *Data = nullptr ) :
+      Width(NewW), Height(NewH), Pixels(NewW * NewH * 4)
+    {
+      if (Data != nullptr)
+        memcpy(Pixels.data(), Data, Pixels.size());
+      /* Setup row pointers */
+      INT i;
+      RowsD.resize(Height);
+      i = 0;
+      for (auto &r : RowsD)
+        r = (DWORD *)&Pixels[i++ * Width * 4];
+      RowsB.resize(Height);
+      i = 0;
+      for (auto &r : RowsB)
+        r = (BYTE (*)[4])&Pixels[i++ * Width * 4];
+    } /* End of 'image' function */
+
     /* Class construtor function.
      * ARGUMENTS:
      *   - image file name:
@@ -51,21 +76,36 @@ namespace tse
     image( const std::string &FileName )
     {
       BOOL is_ok = FALSE;
-      if (WicFactory == nullptr)
+      if (std::lock_guard<std::mutex> lock(WicLock); WicFactory == nullptr)
       {
         CoInitialize(nullptr);
         CoCreateInstance(CLSID_WICImagingFactory2, nullptr, CLSCTX_ALL,
           IID_PPV_ARGS(&WicFactory));
       }
+      /* Packed images are decoded from memory */
+      std::vector<BYTE> mem;
+      BOOL is_packed = vfs::IsPacked(FileName) && vfs::Read(FileName, mem);
+
       /* Load through Window Image Component */
       if (WicFactory != nullptr)
       {
-        std::wstring FileNameW {FileName.begin(), FileName.end()};
         IWICBitmapDecoder *Decoder {};
+        IWICStream *Stream {};
  
         /* Create decoder (loader) */
-        WicFactory->CreateDecoderFromFilename(FileNameW.c_str(), nullptr,
-          GENERIC_READ, WICDecodeMetadataCacheOnDemand, &Decoder);
+        if (is_packed)
+        {
+          WicFactory->CreateStream(&Stream);
+          if (Stream != nullptr && SUCCEEDED(Stream->InitializeFromMemory(mem.data(), (DWORD)mem.size())))
+            WicFactory->CreateDecoderFromStream(Stream, nullptr,
+              WICDecodeMetadataCacheOnDemand, &Decoder);
+        }
+        else
+        {
+          std::wstring FileNameW {FileName.begin(), FileName.end()};
+          WicFactory->CreateDecoderFromFilename(FileNameW.c_str(), nullptr,
+            GENERIC_READ, WICDecodeMetadataCacheOnDemand, &Decoder);
+        }
         if (Decoder != nullptr)
         {
           IWICBitmapFrameDecode *Frame {};
@@ -105,8 +145,39 @@ namespace tse
           }
           Decoder->Release();
         }
+        if (Stream != nullptr)
+          Stream->Release();
       }
-      if (!is_ok)
+      if (!is_ok && is_packed)
+      {
+        /* Case of packed *.G24 / *.G32 */
+        WORD fw = 0, fh = 0;
+        if (mem.size() >= 4)
+        {
+          memcpy(&fw, &mem[0], 2);
+          memcpy(&fh, &mem[2], 2);
+        }
+        if (mem.size() == 4 + (SIZE_T)fw * fh * 3)
+        {
+          Pixels.resize((SIZE_T)fw * fh * 4);
+          for (SIZE_T i = 0, p = 0; i < (SIZE_T)fw * fh; i++)
+          {
+            Pixels[p++] = mem[4 + i * 3];
+            Pixels[p++] = mem[4 + i * 3 + 1];
+            Pixels[p++] = mem[4 + i * 3 + 2];
+            Pixels[p++] = 255;
+          }
+          Width = fw;
+          Height = fh;
+        }
+        else if (mem.size() == 4 + (SIZE_T)fw * fh * 4)
+        {
+          Pixels.assign(mem.begin() + 4, mem.end());
+          Width = fw;
+          Height = fh;
+        }
+      }
+      else if (!is_ok)
       {
         if (HBITMAP hBm;
             (hBm = (HBITMAP)LoadImage(nullptr, FileName.c_str(),
@@ -264,6 +335,94 @@ namespace tse
                   RowsB[ty][tx][0] / 255.0);
     } /* End of 'Sample' function */
 
+    /* Save image to PNG file function.
+     * ARGUMENTS:
+     *   - file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if success, FALSE otherwise.
+     */
+    BOOL SavePNG( const std::string &FileName ) const
+    {
+      std::fstream f(FileName, std::fstream::out | std::fstream::binary);
+      if (!f.is_open())
+        return FALSE;
+
+      /* CRC-32 table (PNG chunks checksum) */
+      static const std::vector<DWORD> CrcTable = []()
+        {
+          std::vector<DWORD> t(256);
+          for (DWORD n = 0; n < 256; n++)
+          {
+            DWORD c = n;
+            for (INT k = 0; k < 8; k++)
+              c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            t[n] = c;
+          }
+          return t;
+        }();
+      auto PutBE = []( std::vector<BYTE> &Buf, DWORD X )
+        {
+          Buf.push_back(X >> 24);
+          Buf.push_back(X >> 16);
+          Buf.push_back(X >> 8);
+          Buf.push_back(X);
+        };
+      auto WriteChunk = [&]( const CHAR *Type, const std::vector<BYTE> &Data )
+        {
+          std::vector<BYTE> chunk;
+          PutBE(chunk, (DWORD)Data.size());
+          chunk.insert(chunk.end(), Type, Type + 4);
+          chunk.insert(chunk.end(), Data.begin(), Data.end());
+          DWORD crc = 0xFFFFFFFF;
+          for (size_t i = 4; i < chunk.size(); i++)
+            crc = CrcTable[(crc ^ chunk[i]) & 0xFF] ^ (crc >> 8);
+          PutBE(chunk, crc ^ 0xFFFFFFFF);
+          f.write((CHAR *)chunk.data(), chunk.size());
+        };
+
+      /* Raw scanlines: filter type 0 + RGBA row */
+      std::vector<BYTE> raw;
+      raw.reserve(Height * (Width * 4 + 1));
+      for (INT y = 0; y < Height; y++)
+      {
+        raw.push_back(0);
+        for (INT x = 0; x < Width; x++)
+        {
+          const BYTE *p = &Pixels[(y * Width + x) * 4];
+          raw.insert(raw.end(), {p[2], p[1], p[0], p[3]});
+        }
+      }
+
+      /* Zlib stream of uncompressed (stored) deflate blocks */
+      std::vector<BYTE> idat {0x78, 0x01};
+      DWORD a = 1, b = 0;
+      size_t pos = 0;
+      do
+      {
+        size_t len = std::min<size_t>(raw.size() - pos, 65535);
+        idat.push_back(pos + len >= raw.size() ? 1 : 0); // BFINAL flag
+        idat.insert(idat.end(), {BYTE(len), BYTE(len >> 8), BYTE(~len), BYTE(~len >> 8)});
+        for (size_t i = pos; i < pos + len; i++)
+          a = (a + raw[i]) % 65521, b = (b + a) % 65521;
+        idat.insert(idat.end(), raw.begin() + pos, raw.begin() + pos + len);
+        pos += len;
+      } while (pos < raw.size());
+      PutBE(idat, (b << 16) | a);
+
+      std::vector<BYTE> ihdr;
+      PutBE(ihdr, Width);
+      PutBE(ihdr, Height);
+      ihdr.insert(ihdr.end(), {8, 6, 0, 0, 0}); // 8 bit RGBA, no interlace
+
+      const BYTE signature[] {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+      f.write((CHAR *)signature, sizeof(signature));
+      WriteChunk("IHDR", ihdr);
+      WriteChunk("IDAT", idat);
+      WriteChunk("IEND", {});
+      return TRUE;
+    } /* End of 'SavePNG' function */
+
   }; /* End of 'image' class */
 
 } /* end of 'tse' namespace */
@@ -0,0 +1,396 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : jobs.h
+ * PURPOSE     : Tough Space Exploration project.
+ *               Common utilities.
+ *               Job system (work-stealing thread pool) module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __jobs_h_
+#define __jobs_h_
+
+/* Main program namespace */
+namespace tse
+{
+  /* Job system class.
+   * Fixed pool of workers, every worker owns a deque: owner pushes and pops
+   * at the back (LIFO, cache friendly), idle workers steal from the front of
+   * other deques. Threads outside the pool share one more deque and help
+   * executing jobs while waiting. */
+  class job_system
+  {
+  public:
+    /* Jobs completion counter (number of unfinished jobs) */
+    using counter = std::atomic_int;
+
+    /* Scheduler statistics structure */
+    struct STATS
+    {
+      UINT64 Executed;      // Executed jobs
+      UINT64 Stolen;        // Jobs taken from other threads deques
+      UINT64 StealAttempts; // Victim deques probed
+    }; /* End of 'STATS' structure */
+
+  private:
+    /* Job structure */
+    struct JOB
+    {
+      std::function<VOID( VOID )> Func; // Job function
+      counter *Counter;                 // Completion counter
+    }; /* End of 'JOB' structure */
+
+    /* Worker queue structure (cache line aligned to avoid false sharing) */
+    struct alignas(64) QUEUE
+    {
+      std::mutex Lock;                         // Deque lock
+      std::deque<JOB> Jobs;                    // Jobs deque
+      std::atomic<UINT64>
+        Executed {0},                          // Executed jobs counter
+        Stolen {0},                            // Stolen jobs counter
+        StealAttempts {0};                     // Steal attempts counter
+    }; /* End of 'QUEUE' structure */
+
+    std::vector<std::unique_ptr<QUEUE>> Queues; // Workers queues + one shared queue for external threads
+    std::vector<std::thread> Workers;           // Worker threads
+    std::atomic_int NumOfQueued {0};            // Number of jobs in all queues
+    std::atomic_int NumOfSleeping {0};          // Number of sleeping workers
+    std::atomic_bool IsStop {FALSE};            // Pool shutdown flag
+    std::mutex SleepLock;                       // Sleep lock
+    std::condition_variable WakeUp;             // New jobs notification
+
+    static inline thread_local job_system *Owner {};  // Pool current thread belongs to
+    static inline thread_local INT WorkerIndex = -1;  // Current thread worker index
+    static inline thread_local UINT RandomState = 0;  // Victim selection random state
+
+    /* Obtain current thread queue index function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) queue index.
+     */
+    INT Self( VOID ) const
+    {
+      return Owner == this ? WorkerIndex : (INT)Workers.size();
+    } /* End of 'Self' function */
+
+    /* Take job from own queue back function.
+     * ARGUMENTS:
+     *   - queue index:
+     *       INT Index;
+     *   - taken job:
+     *       JOB &Job;
+     * RETURNS:
+     *   (BOOL) TRUE if job is taken.
+     */
+    BOOL Pop( INT Index, JOB &Job )
+    {
+      QUEUE &q = *Queues[Index];
+      std::lock_guard<std::mutex> lock(q.Lock);
+      if (q.Jobs.empty())
+        return FALSE;
+      Job = std::move(q.Jobs.back());
+      q.Jobs.pop_back();
+      NumOfQueued--;
+      return TRUE;
+    } /* End of 'Pop' function */
+
+    /* Steal job from other queues front function.
+     * ARGUMENTS:
+     *   - thief queue index:
+     *       INT Index;
+     *   - stolen job:
+     *       JOB &Job;
+     * RETURNS:
+     *   (BOOL) TRUE if job is stolen.
+     */
+    BOOL Steal( INT Index, JOB &Job )
+    {
+      INT n = (INT)Queues.size();
+      if (RandomState == 0)
+        RandomState = (UINT)std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+      /* Xorshift random start victim */
+      RandomState ^= RandomState << 13;
+      RandomState ^= RandomState >> 17;
+      RandomState ^= RandomState << 5;
+      for (INT i = 0, start = RandomState % n; i < n; i++)
+      {
+        INT victim = (start + i) % n;
+        if (victim == Index)
+          continue;
+        QUEUE &q = *Queues[victim];
+        Queues[Index]->StealAttempts.fetch_add(1, std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lock(q.Lock, std::try_to_lock);
+        if (!lock.owns_lock() || q.Jobs.empty())
+          continue;
+        Job = std::move(q.Jobs.front());
+        q.Jobs.pop_front();
+        NumOfQueued--;
+        Queues[Index]->Stolen.fetch_add(1, std::memory_order_relaxed);
+        return TRUE;
+      }
+      return FALSE;
+    } /* End of 'Steal' function */
+
+    /* Execute one job if any function.
+     * ARGUMENTS:
+     *   - current thread queue index:
+     *       INT Index;
+     * RETURNS:
+     *   (BOOL) TRUE if job was executed.
+     */
+    BOOL TryRun( INT Index )
+    {
+      JOB job;
+      if (NumOfQueued.load() == 0 || (!Pop(Index, job) && !Steal(Index, job)))
+        return FALSE;
+      job.Func();
+      job.Counter->fetch_sub(1, std::memory_order_release);
+      Queues[Index]->Executed.fetch_add(1, std::memory_order_relaxed);
+      return TRUE;
+    } /* End of 'TryRun' function */
+
+    /* Worker thread function.
+     * ARGUMENTS:
+     *   - worker index:
+     *       INT Index;
+     * RETURNS: None.
+     */
+    VOID WorkerMain( INT Index )
+    {
+      Owner = this;
+      WorkerIndex = Index;
+      profiler::SetThreadName(std::format("Job worker {}", Index));
+      while (!IsStop)
+      {
+        if (TryRun(Index))
+          continue;
+        /* Nothing to do: sleep until new jobs */
+        std::unique_lock<std::mutex> lock(SleepLock);
+        NumOfSleeping++;
+        WakeUp.wait(lock, [this]( VOID ){ return IsStop || NumOfQueued > 0; });
+        NumOfSleeping--;
+      }
+    } /* End of 'WorkerMain' function */
+
+  public:
+    /* Class constructor.
+     * ARGUMENTS:
+     *   - number of worker threads (0 for number of cores - 1):
+     *       INT NumOfWorkers;
+     */
+    job_system( INT NumOfWorkers = 0 )
+    {
+      if (NumOfWorkers <= 0)
+        NumOfWorkers = std::max(1, (INT)std::thread::hardware_concurrency() - 1);
+      for (INT i = 0; i <= NumOfWorkers; i++)
+        Queues.push_back(std::make_unique<QUEUE>());
+      for (INT i = 0; i < NumOfWorkers; i++)
+        Workers.emplace_back(&job_system::WorkerMain, this, i);
+    } /* End of 'job_system' function */
+
+    /* Class destructor */
+    ~job_system( VOID )
+    {
+      {
+        std::lock_guard<std::mutex> lock(SleepLock);
+        IsStop = TRUE;
+      }
+      WakeUp.notify_all();
+      for (auto &w : Workers)
+        w.join();
+    } /* End of '~job_system' function */
+
+    /* Obtain number of worker threads function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) number of workers.
+     */
+    INT NumOfWorkers( VOID ) const
+    {
+      return (INT)Workers.size();
+    } /* End of 'NumOfWorkers' function */
+
+    /* Spawn job function.
+     * ARGUMENTS:
+     *   - completion counter (incremented here, decremented after job run):
+     *       counter &Counter;
+     *   - job function:
+     *       std::function<VOID( VOID )> Func;
+     * RETURNS: None.
+     */
+    VOID Spawn( counter &Counter, std::function<VOID( VOID )> Func )
+    {
+      QUEUE &q = *Queues[Self()];
+
+      Counter.fetch_add(1, std::memory_order_relaxed);
+      {
+        std::lock_guard<std::mutex> lock(q.Lock);
+        q.Jobs.push_back({std::move(Func), &Counter});
+      }
+      NumOfQueued++;
+      /* Sleeping worker registers itself before checking queue - no lost wake up */
+      if (NumOfSleeping > 0)
+      {
+        { std::lock_guard<std::mutex> lock(SleepLock); }
+        WakeUp.notify_one();
+      }
+    } /* End of 'Spawn' function */
+
+    /* Wait jobs completion (executing jobs meanwhile) function.
+     * ARGUMENTS:
+     *   - completion counter:
+     *       counter &Counter;
+     * RETURNS: None.
+     */
+    VOID Wait( counter &Counter )
+    {
+      INT self = Self();
+      while (Counter.load(std::memory_order_acquire) > 0)
+        if (!TryRun(self))
+          std::this_thread::yield();
+    } /* End of 'Wait' function */
+
+    /* Parallel for loop function.
+     * ARGUMENTS:
+     *   - index range:
+     *       INT Begin, End;
+     *   - range chunk function:
+     *       const std::function<VOID( INT ChunkBegin, INT ChunkEnd )> &Func;
+     *   - chunk size (0 for automatic):
+     *       INT Grain;
+     * RETURNS: None.
+     */
+    VOID ParallelFor( INT Begin, INT End, const std::function<VOID( INT, INT )> &Func, INT Grain = 0 )
+    {
+      if (End <= Begin)
+        return;
+      if (Grain <= 0)
+        Grain = std::max(1, (End - Begin) / ((NumOfWorkers() + 1) * 4));
+      counter cnt {0};
+      for (INT i = Begin; i < End; i += Grain)
+        Spawn(cnt, [&Func, i, e = std::min(End, i + Grain)]( VOID ){ Func(i, e); });
+      Wait(cnt);
+    } /* End of 'ParallelFor' function */
+
+    /* Obtain scheduler statistics function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (STATS) statistics sum over all queues.
+     */
+    STATS Stats( VOID ) const
+    {
+      STATS st {};
+      for (auto &q : Queues)
+      {
+        st.Executed += q->Executed;
+        st.Stolen += q->Stolen;
+        st.StealAttempts += q->StealAttempts;
+      }
+      return st;
+    } /* End of 'Stats' function */
+
+    /* Reset scheduler statistics function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID ResetStats( VOID )
+    {
+      for (auto &q : Queues)
+        q->Executed = q->Stolen = q->StealAttempts = 0;
+    } /* End of 'ResetStats' function */
+
+  }; /* End of 'job_system' class */
+
+  /* Task graph class.
+   * Tasks with dependencies: a task is spawned when all tasks it depends on
+   * are finished. Graph may be run many times (e.g. every frame). */
+  class task_graph
+  {
+  private:
+    /* Graph node structure */
+    struct NODE
+    {
+      std::function<VOID( VOID )> Func; // Task function
+      std::vector<INT> Next;            // Dependent tasks
+      INT NumOfDeps = 0;                // Number of tasks this one depends on
+      std::atomic_int Remaining {0};    // Unfinished dependencies during run
+    }; /* End of 'NODE' structure */
+
+    std::deque<NODE> Nodes; // Graph nodes (deque keeps atomics in place)
+
+    /* Spawn task function.
+     * ARGUMENTS:
+     *   - job system:
+     *       job_system &Jobs;
+     *   - graph completion counter:
+     *       job_system::counter &Counter;
+     *   - task index:
+     *       INT Index;
+     * RETURNS: None.
+     */
+    VOID Launch( job_system &Jobs, job_system::counter &Counter, INT Index )
+    {
+      Jobs.Spawn(Counter, [this, &Jobs, &Counter, Index]( VOID )
+        {
+          Nodes[Index].Func();
+          for (INT n : Nodes[Index].Next)
+            if (Nodes[n].Remaining.fetch_sub(1) == 1)
+              Launch(Jobs, Counter, n);
+        });
+    } /* End of 'Launch' function */
+
+  public:
+    /* Add task function.
+     * ARGUMENTS:
+     *   - task function:
+     *       std::function<VOID( VOID )> Func;
+     *   - tasks (indices) this one depends on:
+     *       std::initializer_list<INT> Deps;
+     * RETURNS:
+     *   (INT) task index.
+     */
+    INT Add( std::function<VOID( VOID )> Func, std::initializer_list<INT> Deps = {} )
+    {
+      INT index = (INT)Nodes.size();
+      NODE &node = Nodes.emplace_back();
+
+      node.Func = std::move(Func);
+      node.NumOfDeps = (INT)Deps.size();
+      for (INT d : Deps)
+        Nodes[d].Next.push_back(index);
+      return index;
+    } /* End of 'Add' function */
+
+    /* Run all tasks and wait completion function.
+     * ARGUMENTS:
+     *   - job system:
+     *       job_system &Jobs;
+     * RETURNS: None.
+     */
+    VOID Run( job_system &Jobs )
+    {
+      job_system::counter cnt {0};
+      for (auto &n : Nodes)
+        n.Remaining = n.NumOfDeps;
+      for (INT i = 0; i < (INT)Nodes.size(); i++)
+        if (Nodes[i].NumOfDeps == 0)
+          Launch(Jobs, cnt, i);
+      Jobs.Wait(cnt);
+    } /* End of 'Run' function */
+
+  }; /* End of 'task_graph' class */
+
+} /* end of 'tse' namespace */
+
+#endif /* __jobs_h_ */
+
+/* END OF 'jobs.h' FILE */
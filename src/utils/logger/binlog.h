@@ -0,0 +1,751 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : binlog.h
+ * PURPOSE     : Tough Space Exploration project.
+ *               Common utilities.
+ *               Binary structured event log module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : File layout: "TSEBLOG1" magic, INT64 start wall clock time (ns),
+ *               then records started with tag byte:
+ *                 'D' - format descriptor: UINT32 id, BYTE level, UINT32 line,
+ *                       format and source file strings (UINT16 length + bytes);
+ *                 'S' - interned string: UINT32 id, string (UINT16 length + bytes);
+ *                 'B' - thread events block: UINT16 thread, UINT32 size, events.
+ *               Event: UINT32 descriptor id, UINT64 time since start (ns),
+ *               BYTE number of arguments, arguments (type byte + value).
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __binlog_h_
+#define __binlog_h_
+
+/* Main program namespace */
+namespace tse
+{
+  /* Binary structured event log class.
+   * Call site registers static format descriptor once, event stores only
+   * descriptor id, time stamp and raw arguments into per-thread buffer;
+   * strings are interned. Text is produced by offline 'Decode' only. */
+  class binlog
+  {
+  public:
+    static const INT BufferSize = 1 << 16;     // Thread buffer size to hand it to writer
+    static const INT MaxStrings = 1 << 16;     // Interned strings limit (later strings are stored inline)
+    static const INT MaxStringLength = 0xFFFF; // String argument length limit
+
+    /* Argument types */
+    enum class arg_type : BYTE
+    {
+      I64,  // Signed integer
+      U64,  // Unsigned integer
+      F64,  // Floating point number
+      STR,  // Interned string id
+      TEXT, // Inline string
+    };
+
+    /* Static format descriptor class (lives at call site) */
+    class descriptor
+    {
+    public:
+      BYTE Level;         // Message level (see 'logger::level')
+      const CHAR *Format; // Format string (std::format syntax)
+      const CHAR *File;   // Source file name
+      INT Line;           // Source line
+      UINT32 Id;          // Descriptor id in log
+
+      /* Class constructor (registers descriptor).
+       * ARGUMENTS:
+       *   - message level:
+       *       BYTE NewLevel;
+       *   - format string (pointer is stored):
+       *       const CHAR *NewFormat;
+       *   - source file name and line:
+       *       const CHAR *NewFile;
+       *       INT NewLine;
+       */
+      descriptor( BYTE NewLevel, const CHAR *NewFormat, const CHAR *NewFile = "", INT NewLine = 0 ) :
+        Level(NewLevel), Format(NewFormat), File(NewFile), Line(NewLine)
+      {
+        std::lock_guard<std::mutex> lock(Lock);
+        Id = (UINT32)Descs.size();
+        Descs.push_back(this);
+      } /* End of 'descriptor' function */
+    }; /* End of 'descriptor' class */
+
+  private:
+    /* Thread events buffer structure */
+    struct THREAD_BUFFER
+    {
+      std::mutex Lock;                                    // Owner thread and flush lock (not contended)
+      std::vector<BYTE> Data;                             // Events data
+      std::map<std::string, UINT32, std::less<>> Strings; // Interned strings cache
+      UINT64 NumOfEvents = 0;                             // Pushed events counter
+      UINT16 Id = 0;                                      // Thread number in log (buffer slot)
+      std::atomic_bool IsFree {FALSE};                    // Owner thread exited flag
+    }; /* End of 'THREAD_BUFFER' structure */
+
+    /* Thread buffer owner structure (buffer is given back for reuse when thread exits) */
+    struct OWNER
+    {
+      THREAD_BUFFER *Buf; // Thread buffer
+
+      /* Class constructor */
+      OWNER( VOID ) : Buf(nullptr)
+      {
+      } /* End of 'OWNER' function */
+
+      /* Class destructor */
+      ~OWNER( VOID )
+      {
+        if (Buf != nullptr)
+          Buf->IsFree = TRUE;
+      } /* End of '~OWNER' function */
+    }; /* End of 'OWNER' structure */
+    static inline thread_local OWNER Owner; // Current thread buffer owner
+
+    static inline std::mutex Lock;                                           // Tables, pending blocks and file lock
+    static inline std::vector<const descriptor *> Descs;                     // Registered descriptors
+    static inline std::vector<std::string> Strings;                          // Interned strings
+    static inline std::map<std::string, UINT32, std::less<>> StringIds;      // Interned strings ids
+    static inline std::vector<std::pair<UINT16, std::vector<BYTE>>> Pending; // Full blocks to write
+    static inline std::vector<std::unique_ptr<THREAD_BUFFER>> Buffers;       // All threads buffers
+    static inline std::atomic_bool IsEnabled {FALSE};                        // Recording flag
+    static inline FILE *File = nullptr;                                      // Output file
+    static inline size_t WrittenDescs = 0, WrittenStrings = 0;               // Tables part already in file
+    static inline std::chrono::steady_clock::time_point
+      StartTime,                                                             // Log start time
+      LastFlush;                                                             // Last full flush time
+    static inline UINT64 NumOfBytes = 0;                                     // Written bytes
+
+    /* Obtain current thread buffer function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (THREAD_BUFFER *) buffer pointer.
+     */
+    static THREAD_BUFFER * Buffer( VOID )
+    {
+      if (Owner.Buf == nullptr)
+      {
+        std::lock_guard<std::mutex> lock(Lock);
+        for (auto &b : Buffers)
+          if (b->IsFree)
+          {
+            Owner.Buf = b.get();
+            break;
+          }
+        if (Owner.Buf == nullptr)
+        {
+          Owner.Buf = Buffers.emplace_back(std::make_unique<THREAD_BUFFER>()).get();
+          Owner.Buf->Id = (UINT16)(Buffers.size() - 1);
+        }
+        Owner.Buf->IsFree = FALSE;
+      }
+      return Owner.Buf;
+    } /* End of 'Buffer' function */
+
+    /* Put raw value into buffer function.
+     * ARGUMENTS:
+     *   - buffer data:
+     *       std::vector<BYTE> &Data;
+     *   - value:
+     *       const Type &Value;
+     * RETURNS: None.
+     */
+    template<class Type>
+      static VOID Put( std::vector<BYTE> &Data, const Type &Value )
+      {
+        size_t size = Data.size();
+        Data.resize(size + sizeof(Type));
+        std::memcpy(Data.data() + size, &Value, sizeof(Type));
+      } /* End of 'Put' function */
+
+    /* Put string with length into buffer function.
+     * ARGUMENTS:
+     *   - buffer data:
+     *       std::vector<BYTE> &Data;
+     *   - string:
+     *       std::string_view Str;
+     * RETURNS: None.
+     */
+    static VOID PutString( std::vector<BYTE> &Data, std::string_view Str )
+    {
+      Str = Str.substr(0, MaxStringLength);
+      Put(Data, (UINT16)Str.size());
+      Data.insert(Data.end(), Str.begin(), Str.end());
+    } /* End of 'PutString' function */
+
+    /* Put string argument function.
+     * ARGUMENTS:
+     *   - thread buffer:
+     *       THREAD_BUFFER *Buf;
+     *   - string:
+     *       std::string_view Str;
+     * RETURNS: None.
+     */
+    static VOID PutStringArg( THREAD_BUFFER *Buf, std::string_view Str )
+    {
+      UINT32 id = 0;
+      BOOL is_interned = FALSE;
+
+      if (auto it = Buf->Strings.find(Str); it != Buf->Strings.end())
+        id = it->second, is_interned = TRUE;
+      else if (Str.size() <= 256)
+      {
+        std::lock_guard<std::mutex> lock(Lock);
+        if (auto it = StringIds.find(Str); it != StringIds.end())
+          id = it->second, is_interned = TRUE;
+        else if (Strings.size() < MaxStrings)
+        {
+          id = (UINT32)Strings.size();
+          Strings.emplace_back(Str);
+          StringIds.emplace(Str, id);
+          is_interned = TRUE;
+        }
+        if (is_interned)
+          Buf->Strings.emplace(Str, id);
+      }
+      if (is_interned)
+      {
+        Put(Buf->Data, arg_type::STR);
+        Put(Buf->Data, id);
+      }
+      else
+      {
+        Put(Buf->Data, arg_type::TEXT);
+        PutString(Buf->Data, Str);
+      }
+    } /* End of 'PutStringArg' function */
+
+    /* Put argument function.
+     * ARGUMENTS:
+     *   - thread buffer:
+     *       THREAD_BUFFER *Buf;
+     *   - argument:
+     *       const Type &Arg;
+     * RETURNS: None.
+     */
+    template<class Type>
+      static VOID PutArg( THREAD_BUFFER *Buf, const Type &Arg )
+      {
+        if constexpr (std::is_convertible_v<const Type &, std::string_view>)
+          PutStringArg(Buf, std::string_view(Arg));
+        else if constexpr (std::is_floating_point_v<Type>)
+        {
+          Put(Buf->Data, arg_type::F64);
+          Put(Buf->Data, (DBL)Arg);
+        }
+        else if constexpr (std::is_unsigned_v<Type> && !std::is_same_v<Type, bool>)
+        {
+          Put(Buf->Data, arg_type::U64);
+          Put(Buf->Data, (UINT64)Arg);
+        }
+        else
+        {
+          static_assert(std::is_integral_v<Type> || std::is_enum_v<Type>, "unsupported binary log argument type");
+          Put(Buf->Data, arg_type::I64);
+          Put(Buf->Data, (INT64)Arg);
+        }
+      } /* End of 'PutArg' function */
+
+    /* Finish event in thread buffer function (thread buffer lock is held).
+     * ARGUMENTS:
+     *   - thread buffer:
+     *       THREAD_BUFFER *Buf;
+     * RETURNS: None.
+     */
+    static VOID Commit( THREAD_BUFFER *Buf )
+    {
+      Buf->NumOfEvents++;
+      if (Buf->Data.size() >= BufferSize)
+      {
+        std::lock_guard<std::mutex> lock(Lock);
+        Pending.push_back({Buf->Id, std::exchange(Buf->Data, {})});
+      }
+    } /* End of 'Commit' function */
+
+    /* Write tables tail and blocks into file function (log lock is held).
+     * ARGUMENTS:
+     *   - blocks to write:
+     *       std::vector<std::pair<UINT16, std::vector<BYTE>>> &Blocks;
+     * RETURNS: None.
+     */
+    static VOID WriteBlocks( std::vector<std::pair<UINT16, std::vector<BYTE>>> &Blocks )
+    {
+      std::vector<BYTE> out;
+
+      /* Everything referenced by blocks is registered before blocks were taken */
+      for (; WrittenDescs < Descs.size(); WrittenDescs++)
+      {
+        const descriptor *d = Descs[WrittenDescs];
+        Put(out, 'D');
+        Put(out, d->Id);
+        Put(out, d->Level);
+        Put(out, (UINT32)d->Line);
+        PutString(out, d->Format);
+        PutString(out, d->File);
+      }
+      for (; WrittenStrings < Strings.size(); WrittenStrings++)
+      {
+        Put(out, 'S');
+        Put(out, (UINT32)WrittenStrings);
+        PutString(out, Strings[WrittenStrings]);
+      }
+      for (auto &[thread, data] : Blocks)
+      {
+        Put(out, 'B');
+        Put(out, thread);
+        Put(out, (UINT32)data.size());
+        out.insert(out.end(), data.begin(), data.end());
+      }
+      if (!out.empty())
+      {
+        std::fwrite(out.data(), 1, out.size(), File);
+        std::fflush(File);
+        NumOfBytes += out.size();
+      }
+    } /* End of 'WriteBlocks' function */
+
+    /* Decoded argument structure */
+    struct ARG
+    {
+      arg_type Type; // Argument type
+      INT64 I = 0;   // Signed value
+      UINT64 U = 0;  // Unsigned value
+      DBL F = 0;     // Floating value
+      std::string S; // String value
+    }; /* End of 'ARG' structure */
+
+    /* Decoded event structure */
+    struct EVENT
+    {
+      UINT64 Time;           // Time since log start (ns)
+      UINT16 Thread;         // Thread number
+      UINT32 Desc;           // Descriptor id
+      std::vector<ARG> Args; // Arguments
+    }; /* End of 'EVENT' structure */
+
+    /* Decoded descriptor structure */
+    struct DESC
+    {
+      BYTE Level = 1;                  // Message level
+      INT Line = 0;                    // Source line
+      std::string Format = "{}", File; // Format string and source file
+    }; /* End of 'DESC' structure */
+
+    /* Format one argument by std::format specification function.
+     * ARGUMENTS:
+     *   - argument:
+     *       const ARG &A;
+     *   - format specification (after ':'):
+     *       const std::string &Spec;
+     * RETURNS:
+     *   (std::string) formatted argument.
+     */
+    static std::string FormatArg( const ARG &A, const std::string &Spec )
+    {
+      std::string fmt = "{:" + Spec + "}";
+      try
+      {
+        switch (A.Type)
+        {
+        case arg_type::I64:
+          return std::vformat(fmt, std::make_format_args(A.I));
+        case arg_type::U64:
+          return std::vformat(fmt, std::make_format_args(A.U));
+        case arg_type::F64:
+          return std::vformat(fmt, std::make_format_args(A.F));
+        default:
+          return std::vformat(fmt, std::make_format_args(A.S));
+        }
+      }
+      catch (const std::format_error &)
+      {
+        return "{?}";
+      }
+    } /* End of 'FormatArg' function */
+
+    /* Render message by format string function.
+     * ARGUMENTS:
+     *   - format string:
+     *       const std::string &Fmt;
+     *   - arguments:
+     *       const std::vector<ARG> &Args;
+     * RETURNS:
+     *   (std::string) message text.
+     */
+    static std::string Render( const std::string &Fmt, const std::vector<ARG> &Args )
+    {
+      std::string out;
+      size_t next = 0;
+
+      for (size_t i = 0; i < Fmt.size(); i++)
+        if ((Fmt[i] == '{' || Fmt[i] == '}') && i + 1 < Fmt.size() && Fmt[i + 1] == Fmt[i])
+          out += Fmt[i++];
+        else if (Fmt[i] == '{')
+        {
+          size_t end = Fmt.find('}', i);
+          if (end == std::string::npos)
+            break;
+          std::string field = Fmt.substr(i + 1, end - i - 1), spec;
+          size_t colon = field.find(':'), index = next++;
+          if (colon != std::string::npos)
+            spec = field.substr(colon + 1), field.resize(colon);
+          if (!field.empty())
+            index = std::strtoul(field.c_str(), nullptr, 10);
+          out += index < Args.size() ? FormatArg(Args[index], spec) : "{?}";
+          i = end;
+        }
+        else
+          out += Fmt[i];
+      return out;
+    } /* End of 'Render' function */
+
+    /* Escape string for JSON function.
+     * ARGUMENTS:
+     *   - string:
+     *       const std::string &Str;
+     * RETURNS:
+     *   (std::string) escaped string.
+     */
+    static std::string EscapeJSON( const std::string &Str )
+    {
+      std::string out;
+      for (CHAR ch : Str)
+        if (ch == '"' || ch == '\\')
+          out += '\\', out += ch;
+        else if (ch == '\n')
+          out += "\\n";
+        else if ((BYTE)ch < 32)
+          out += std::format("\\u{:04x}", (INT)(BYTE)ch);
+        else
+          out += ch;
+      return out;
+    } /* End of 'EscapeJSON' function */
+
+  public:
+    /* Start binary log into file function.
+     * ARGUMENTS:
+     *   - log file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if success.
+     */
+    static BOOL Start( const std::string &FileName )
+    {
+      Stop();
+      std::lock_guard<std::mutex> lock(Lock);
+      if ((File = std::fopen(FileName.c_str(), "wb")) == nullptr)
+        return FALSE;
+      StartTime = LastFlush = std::chrono::steady_clock::now();
+      INT64 wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+      std::fwrite("TSEBLOG1", 1, 8, File);
+      std::fwrite(&wall, sizeof(wall), 1, File);
+      WrittenDescs = WrittenStrings = 0;
+      NumOfBytes = 16;
+      IsEnabled = TRUE;
+      return TRUE;
+    } /* End of 'Start' function */
+
+    /* Stop binary log (all events are written) function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    static VOID Stop( VOID )
+    {
+      if (!IsEnabled)
+        return;
+      IsEnabled = FALSE;
+      Flush(TRUE);
+      std::lock_guard<std::mutex> lock(Lock);
+      std::fclose(File);
+      File = nullptr;
+    } /* End of 'Stop' function */
+
+    /* Check binary log is recording function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (BOOL) TRUE if events go to binary log.
+     */
+    static BOOL IsOn( VOID )
+    {
+      return IsEnabled.load(std::memory_order_relaxed);
+    } /* End of 'IsOn' function */
+
+    /* Push event function.
+     * ARGUMENTS:
+     *   - call site format descriptor:
+     *       const descriptor &Desc;
+     *   - format arguments (integers, floats, strings):
+     *       const Args &...A;
+     * RETURNS: None.
+     */
+    template<class... Args>
+      static VOID Push( const descriptor &Desc, const Args &...A )
+      {
+        static_assert(sizeof...(A) < 256, "too many binary log arguments");
+        UINT64 time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - StartTime).count();
+        THREAD_BUFFER *buf = Buffer();
+        std::lock_guard<std::mutex> lock(buf->Lock);
+
+        Put(buf->Data, Desc.Id);
+        Put(buf->Data, time);
+        Put(buf->Data, (BYTE)sizeof...(A));
+        (PutArg(buf, A), ...);
+        Commit(buf);
+      } /* End of 'Push' function */
+
+    /* Push already formatted text event function.
+     * ARGUMENTS:
+     *   - message level (see 'logger::level'):
+     *       BYTE Level;
+     *   - message text:
+     *       const std::string &Str;
+     * RETURNS: None.
+     */
+    static VOID PushText( BYTE Level, const std::string &Str )
+    {
+      static const descriptor Texts[]
+      {
+        {0, "{}"}, {1, "{}"}, {2, "{}"}, {3, "{}"}, {4, "{}"}, {5, "{}"},
+      };
+      UINT64 time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - StartTime).count();
+      THREAD_BUFFER *buf = Buffer();
+      std::lock_guard<std::mutex> lock(buf->Lock);
+
+      Put(buf->Data, Texts[std::min<BYTE>(Level, 5)].Id);
+      Put(buf->Data, time);
+      Put(buf->Data, (BYTE)1);
+      Put(buf->Data, arg_type::TEXT);
+      PutString(buf->Data, Str);
+      Commit(buf);
+    } /* End of 'PushText' function */
+
+    /* Write buffered events function.
+     * ARGUMENTS:
+     *   - write partially filled thread buffers flag:
+     *       BOOL IsAll;
+     * RETURNS: None.
+     */
+    static VOID Flush( BOOL IsAll )
+    {
+      std::vector<std::pair<UINT16, std::vector<BYTE>>> blocks;
+      std::vector<THREAD_BUFFER *> bufs;
+      {
+        std::lock_guard<std::mutex> lock(Lock);
+        if (File == nullptr || (!IsAll && Pending.empty()))
+          return;
+        blocks = std::move(Pending);
+        Pending.clear();
+        if (IsAll)
+          for (auto &b : Buffers)
+            bufs.push_back(b.get());
+      }
+      /* Thread buffers are taken without log lock (same order as 'Push') */
+      for (THREAD_BUFFER *b : bufs)
+      {
+        std::lock_guard<std::mutex> lock(b->Lock);
+        if (!b->Data.empty())
+          blocks.push_back({b->Id, std::exchange(b->Data, {})});
+      }
+      std::lock_guard<std::mutex> lock(Lock);
+      if (File != nullptr)
+        WriteBlocks(blocks);
+      if (IsAll)
+        LastFlush = std::chrono::steady_clock::now();
+    } /* End of 'Flush' function */
+
+    /* Background flush step function (called by logger writer thread).
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    static VOID Update( VOID )
+    {
+      if (IsOn())
+        Flush(std::chrono::steady_clock::now() - LastFlush > std::chrono::seconds(1));
+    } /* End of 'Update' function */
+
+    /* Obtain written statistics function.
+     * ARGUMENTS:
+     *   - events and bytes counters:
+     *       UINT64 &Events, &Bytes;
+     * RETURNS: None.
+     */
+    static VOID Stats( UINT64 &Events, UINT64 &Bytes )
+    {
+      std::vector<THREAD_BUFFER *> bufs;
+      {
+        std::lock_guard<std::mutex> lock(Lock);
+        for (auto &b : Buffers)
+          bufs.push_back(b.get());
+        Bytes = NumOfBytes;
+      }
+      Events = 0;
+      for (THREAD_BUFFER *b : bufs)
+      {
+        std::lock_guard<std::mutex> lock(b->Lock);
+        Events += b->NumOfEvents;
+      }
+    } /* End of 'Stats' function */
+
+    /* Decode binary log to text or JSON function.
+     * ARGUMENTS:
+     *   - binary log file name:
+     *       const std::string &InFileName;
+     *   - output file name (empty for standard output):
+     *       const std::string &OutFileName;
+     *   - JSON output flag:
+     *       BOOL IsJSON;
+     * RETURNS:
+     *   (INT) number of decoded events (-1 if file is not binary log).
+     */
+    static INT Decode( const std::string &InFileName, const std::string &OutFileName, BOOL IsJSON )
+    {
+      static const CHAR *Levels[] {"DEBUG", "INFO", "SYS", "WARN", "ERROR", "RAW"};
+
+      std::ifstream in(InFileName, std::ios_base::binary);
+      std::vector<BYTE> data((std::istreambuf_iterator<CHAR>(in)), std::istreambuf_iterator<CHAR>());
+      if (data.size() < 16 || std::memcmp(data.data(), "TSEBLOG1", 8) != 0)
+        return -1;
+
+      /* Bounds checked reader */
+      size_t pos = 8;
+      BOOL is_ok = TRUE;
+      auto Get = [&]<class Type>( Type &Value )
+        {
+          if (pos + sizeof(Type) > data.size())
+            return is_ok = FALSE;
+          std::memcpy(&Value, data.data() + pos, sizeof(Type));
+          pos += sizeof(Type);
+          return TRUE;
+        };
+      auto GetString = [&]( std::string &Str )
+        {
+          UINT16 len = 0;
+          if (!Get(len) || pos + len > data.size())
+            return is_ok = FALSE;
+          Str.assign((const CHAR *)data.data() + pos, len);
+          pos += len;
+          return TRUE;
+        };
+
+      INT64 wall = 0;
+      Get(wall);
+      std::vector<DESC> descs;
+      std::vector<std::string> strs;
+      std::vector<EVENT> events;
+
+      while (is_ok && pos < data.size())
+      {
+        CHAR tag = 0;
+        UINT32 id = 0;
+        Get(tag);
+        if (tag == 'D' && Get(id))
+        {
+          if (descs.size() <= id)
+            descs.resize(id + 1);
+          DESC &d = descs[id];
+          UINT32 line = 0;
+          Get(d.Level), Get(line), GetString(d.Format), GetString(d.File);
+          d.Line = (INT)line;
+        }
+        else if (tag == 'S' && Get(id))
+        {
+          if (strs.size() <= id)
+            strs.resize(id + 1);
+          GetString(strs[id]);
+        }
+        else if (UINT16 thread = 0; tag == 'B' && Get(thread))
+        {
+          UINT32 size = 0;
+          Get(size);
+          for (size_t end = std::min(pos + size, data.size()); is_ok && pos < end; )
+          {
+            EVENT &e = events.emplace_back(EVENT {0, thread, 0, {}});
+            BYTE argc = 0;
+            Get(e.Desc), Get(e.Time), Get(argc);
+            for (INT i = 0; is_ok && i < argc; i++)
+            {
+              ARG &a = e.Args.emplace_back();
+              Get(a.Type);
+              if (a.Type == arg_type::I64)
+                Get(a.I);
+              else if (a.Type == arg_type::U64)
+                Get(a.U);
+              else if (a.Type == arg_type::F64)
+                Get(a.F);
+              else if (a.Type == arg_type::STR && Get(id))
+                a.S = id < strs.size() ? strs[id] : "<?>";
+              else if (a.Type == arg_type::TEXT)
+                GetString(a.S);
+              else
+                is_ok = FALSE;
+            }
+            /* Only truncated or damaged event is dropped */
+            if (!is_ok)
+              events.pop_back();
+          }
+        }
+        else
+          is_ok = FALSE;
+      }
+
+      /* Thread blocks are written in flush order: restore time order */
+      std::stable_sort(events.begin(), events.end(),
+        []( const EVENT &A, const EVENT &B ){ return A.Time < B.Time; });
+
+      FILE *out = OutFileName.empty() ? stdout : std::fopen(OutFileName.c_str(), "w");
+      if (out == nullptr)
+        return -1;
+      if (IsJSON)
+        std::fputs("[\n", out);
+      for (size_t i = 0; i < events.size(); i++)
+      {
+        const EVENT &e = events[i];
+        static const DESC unknown;
+        const DESC &d = e.Desc < descs.size() ? descs[e.Desc] : unknown;
+        std::string msg = Render(d.Format, e.Args);
+        const CHAR *level = Levels[std::min<BYTE>(d.Level, 5)];
+
+        if (IsJSON)
+        {
+          std::string args;
+          for (const ARG &a : e.Args)
+            args += (args.empty() ? "" : ", ") +
+              (a.Type == arg_type::STR || a.Type == arg_type::TEXT ? "\"" + EscapeJSON(a.S) + "\"" : FormatArg(a, ""));
+          std::fputs(std::format("  {{\"time_ms\": {:.6f}, \"thread\": {}, \"level\": \"{}\", \"file\": \"{}\", \"line\": {}, "
+                                 "\"format\": \"{}\", \"args\": [{}], \"message\": \"{}\"}}{}\n",
+            e.Time / 1e6, e.Thread, level, EscapeJSON(d.File), d.Line, EscapeJSON(d.Format), args,
+            EscapeJSON(msg), i + 1 < events.size() ? "," : "").c_str(), out);
+        }
+        else
+        {
+          std::time_t t_c = (std::time_t)((wall + (INT64)e.Time) / 1000000000);
+          std::ostringstream ss;
+          ss << std::put_time(std::localtime(&t_c), "%H:%M:%S");
+          std::fputs(std::format("[{}] [{}.{:03}] (T{}) {}{}", level, ss.str(), (wall + e.Time) / 1000000 % 1000,
+            e.Thread, msg, msg.ends_with('\n') ? "" : "\n").c_str(), out);
+        }
+      }
+      if (IsJSON)
+        std::fputs("]\n", out);
+      if (out != stdout)
+        std::fclose(out);
+      return (INT)events.size();
+    } /* End of 'Decode' function */
+  }; /* End of 'binlog' class */
+
+} /* end of 'tse' namespace */
+
+#endif /* __binlog_h_ */
+
+/* END OF 'binlog.h' FILE */
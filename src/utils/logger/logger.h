@@ -9,7 +9,7 @@
  *               Console handle module.
  * PROGRAMMER  : CGSG-Jr'2024-25.
  *               Belykh Andrey (AB7)
- * LAST UPDATE : 02.08.2025.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : None.
  *
  * No part of this file may be changed without agreement of
@@ -19,12 +19,287 @@
 #ifndef __logger_h_
 #define __logger_h_
 
+/* Minimal compiled in message level (see 'logger::level'): lower level macro calls are stripped */
+#ifndef TSE_LOG_LEVEL
+#  define TSE_LOG_LEVEL 0
+#endif /* TSE_LOG_LEVEL */
+
+/* Level checked log macros (message expression is evaluated only if level passes) */
+#define TSE_LOG(Level, Func, Str)                                                   \
+  do                                                                                \
+  {                                                                                 \
+    if constexpr ((INT)tse::logger::level::Level >= TSE_LOG_LEVEL)                  \
+      if (tse::logger::IsLevel(tse::logger::level::Level))                          \
+        tse::logger::Func(Str);                                                     \
+  } while (0)
+#define TSE_LOG_DEBUG(Str) TSE_LOG(DBG, Debug, Str)
+#define TSE_LOG_INFO(Str) TSE_LOG(INFO, Info, Str)
+
+/* Structured log macro: format string is registered once per call site, in binary
+ * log mode only arguments are stored (formatting is done by offline decoder) */
+#define TSE_LOGF(Level, Fmt, ...)                                                   \
+  do                                                                                \
+  {                                                                                 \
+    if constexpr ((INT)tse::logger::level::Level >= TSE_LOG_LEVEL)                  \
+      if (tse::logger::IsLevel(tse::logger::level::Level))                          \
+      {                                                                             \
+        static const tse::binlog::descriptor TSE_LOG_desc                           \
+          {(BYTE)tse::logger::level::Level, Fmt, __FILE__, __LINE__};               \
+        if (tse::binlog::IsOn())                                                    \
+          tse::binlog::Push(TSE_LOG_desc, ##__VA_ARGS__);                           \
+        else                                                                        \
+          tse::logger::Write(tse::logger::level::Level, std::format(Fmt, ##__VA_ARGS__)); \
+      }                                                                             \
+  } while (0)
+
 /* Main program namespace */
 namespace tse
 {
-  /* Logger type class representation */
+  /* Logger type class representation.
+   * Callers only put message with level and time stamp into lock-free bounded
+   * ring (many producers, one consumer); background thread decorates messages
+   * and writes them in batches. Callers never wait: message is dropped when
+   * ring is full (dropped messages are counted and reported in output). */
   class logger
   {
+  public:
+    /* Message levels */
+    enum class level : INT
+    {
+      DBG,  // Debug details (every resource creation)
+      INFO, // Information
+      SYS,  // System state changes
+      WARN, // Warnings
+      ERR,  // Errors
+      RAW,  // Undecorated output (never filtered)
+    };
+
+    static const INT RingSize = 1 << 13; // Messages ring capacity (power of 2)
+
+    /* Writer statistics structure */
+    struct STATS
+    {
+      UINT64
+        Pushed,  // Messages put into ring
+        Written, // Messages written to output
+        Dropped, // Messages lost due to full ring
+        Batches; // Output write calls
+    }; /* End of 'STATS' structure */
+
+  private:
+    /* Message structure */
+    struct MESSAGE
+    {
+      level Level;      // Message level
+      INT64 Time;       // System clock time stamp
+      std::string Text; // Message text
+    }; /* End of 'MESSAGE' structure */
+
+    /* Ring slot structure */
+    struct SLOT
+    {
+      std::atomic<UINT64> Seq; // Slot sequence (position it is ready for)
+      MESSAGE Msg;             // Stored message
+    }; /* End of 'SLOT' structure */
+
+    /* Background writer structure */
+    struct WRITER
+    {
+      std::unique_ptr<SLOT[]> Slots {new SLOT[RingSize]}; // Messages ring
+      std::atomic<UINT64> Head {0};                      // Next push position
+      UINT64 Tail = 0;                                   // Next pop position (writer thread only)
+      std::atomic<UINT64>
+        Pushed {0},                                      // Pushed messages counter
+        Written {0},                                     // Written messages counter
+        Dropped {0},                                     // Dropped messages counter
+        Batches {0};                                     // Write calls counter
+      UINT64 ReportedDropped = 0;                        // Dropped messages already reported
+      std::atomic_bool IsStop {FALSE};                   // Writer shutdown flag
+      static inline std::atomic_bool IsAlive {FALSE};    // Writer existence flag (for shutdown order)
+      std::mutex OutLock;                                // Output stream lock
+      FILE *Out = stdout;                                // Output stream
+      std::thread Thread;                                // Writer thread
+
+      /* Class constructor */
+      WRITER( VOID )
+      {
+        for (INT i = 0; i < RingSize; i++)
+          Slots[i].Seq = i;
+        Thread = std::thread(&WRITER::Main, this);
+        IsAlive = TRUE;
+      } /* End of 'WRITER' function */
+
+      /* Class destructor */
+      ~WRITER( VOID )
+      {
+        IsAlive = FALSE;
+        IsStop = TRUE;
+        Thread.join();
+      } /* End of '~WRITER' function */
+
+      /* Put message into ring function.
+       * ARGUMENTS:
+       *   - message:
+       *       MESSAGE &&Msg;
+       * RETURNS:
+       *   (BOOL) TRUE if success, FALSE if ring is full.
+       */
+      BOOL Push( MESSAGE &&Msg )
+      {
+        UINT64 pos = Head.load(std::memory_order_relaxed);
+        SLOT *slot;
+
+        while (TRUE)
+        {
+          slot = &Slots[pos & (RingSize - 1)];
+          INT64 dif = (INT64)slot->Seq.load(std::memory_order_acquire) - (INT64)pos;
+          if (dif == 0)
+          {
+            if (Head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+              break;
+          }
+          else if (dif < 0)
+            return FALSE;
+          else
+            pos = Head.load(std::memory_order_relaxed);
+        }
+        slot->Msg = std::move(Msg);
+        slot->Seq.store(pos + 1, std::memory_order_release);
+        return TRUE;
+      } /* End of 'Push' function */
+
+      /* Take message from ring (writer thread only) function.
+       * ARGUMENTS:
+       *   - taken message:
+       *       MESSAGE &Msg;
+       * RETURNS:
+       *   (BOOL) TRUE if message is taken.
+       */
+      BOOL Pop( MESSAGE &Msg )
+      {
+        SLOT &slot = Slots[Tail & (RingSize - 1)];
+        if (slot.Seq.load(std::memory_order_acquire) != Tail + 1)
+          return FALSE;
+        Msg = std::move(slot.Msg);
+        slot.Seq.store(Tail + RingSize, std::memory_order_release);
+        Tail++;
+        return TRUE;
+      } /* End of 'Pop' function */
+
+      /* Writer thread function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID Main( VOID )
+      {
+        std::string batch, stamp;
+        INT64 stamp_sec = -1;
+        MESSAGE msg;
+
+        while (TRUE)
+        {
+          BOOL is_stop = IsStop;
+          INT n = 0;
+
+          for (; n < 512 && Pop(msg); n++)
+          {
+            /* Time stamp text changes once per second */
+            INT64 sec = std::chrono::duration_cast<std::chrono::seconds>(
+              std::chrono::system_clock::duration(msg.Time)).count();
+            if (sec != stamp_sec)
+            {
+              std::time_t t_c = (std::time_t)sec;
+              std::ostringstream ss;
+              ss << std::put_time(std::localtime(&t_c), "[%H:%M:%S]");
+              stamp = ss.str();
+              stamp_sec = sec;
+            }
+            Decorate(batch, msg, stamp);
+          }
+          if (UINT64 dropped = Dropped; dropped != ReportedDropped)
+          {
+            batch += std::format("[LOG] {} messages dropped (ring is full)\n", dropped - ReportedDropped);
+            ReportedDropped = dropped;
+          }
+          if (!batch.empty())
+          {
+            std::lock_guard<std::mutex> lock(OutLock);
+            std::fwrite(batch.data(), 1, batch.size(), Out);
+            std::fflush(Out);
+            batch.clear();
+            Written += n;
+            Batches++;
+          }
+          else if (is_stop)
+            break;
+          else
+          {
+            binlog::Update();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          }
+        }
+      } /* End of 'Main' function */
+    }; /* End of 'WRITER' structure */
+
+    /* Minimal runtime message level */
+    static inline std::atomic_int MinLevel
+    {
+#ifdef _DEBUG
+      (INT)level::DBG
+#else
+      (INT)level::INFO
+#endif /* _DEBUG */
+    };
+
+    /* Obtain background writer function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (WRITER &) writer reference.
+     */
+    static WRITER & Writer( VOID )
+    {
+      static WRITER writer;
+      return writer;
+    } /* End of 'Writer' function */
+
+    /* Decorate message for output function.
+     * ARGUMENTS:
+     *   - output text:
+     *       std::string &Out;
+     *   - message:
+     *       const MESSAGE &Msg;
+     *   - message time stamp text:
+     *       const std::string &Stamp;
+     * RETURNS: None.
+     */
+    static VOID Decorate( std::string &Out, const MESSAGE &Msg, const std::string &Stamp )
+    {
+      /* Label colors, label, text color */
+      static const CHAR *Styles[][3]
+      {
+        {"\x1b[38;2;255;255;255m\x1b[48;2;90;90;90m", "[DEBUG]", "\x1b[38;2;190;190;190m"},
+        {"\x1b[38;2;255;255;255m\x1b[48;2;0;127;190m", "[INFO]", "\x1b[38;2;127;255;255m"},
+        {"\x1b[38;2;255;255;255m\x1b[48;2;0;127;0m", "[SYS]", "\x1b[38;2;127;255;127m"},
+        {"\x1b[38;2;255;255;255m\x1b[48;2;190;127;0m", "[WARN]", "\x1b[38;2;255;190;63m"},
+        {"\x1b[38;2;255;255;255m\x1b[48;2;255;0;0m", "[ERROR]", "\x1b[38;2;255;127;127m"},
+      };
+
+      if (Msg.Level == level::RAW)
+      {
+        Out += Msg.Text;
+        return;
+      }
+      const CHAR **st = Styles[(INT)Msg.Level];
+      Out += st[0];
+      Out += st[1];
+      Out += "\x1b[38;0;0;0;0m\x1b[48;0;0;0;0m ";
+      Out += Stamp;
+      Out += " ";
+      Out += st[2];
+      Out += Msg.Text;
+      Out += "\x1b[38;0;0;0;0m\n";
+    } /* End of 'Decorate' function */
+
   public:
     /* Default type constructor */
     logger( VOID )
@@ -37,19 +312,116 @@ namespace tse
     /* Type destructor function */
     ~logger( VOID )
     {
+      /* Writer drains ring itself if it is destroyed first */
+      if (WRITER::IsAlive)
+        Flush();
+      binlog::Stop();
       std::fclose(stdout);
       FreeConsole();
     } /* End of '~logger' function */
 
-    /* Log current time function.
+    /* Check message level passes filters function.
+     * ARGUMENTS:
+     *   - message level:
+     *       level Level;
+     * RETURNS:
+     *   (BOOL) TRUE if message of this level is logged.
+     */
+    static BOOL IsLevel( level Level )
+    {
+      return Level == level::RAW ||
+        ((INT)Level >= TSE_LOG_LEVEL && (INT)Level >= MinLevel.load(std::memory_order_relaxed));
+    } /* End of 'IsLevel' function */
+
+    /* Set minimal runtime message level function.
+     * ARGUMENTS:
+     *   - minimal level:
+     *       level Level;
+     * RETURNS: None.
+     */
+    static VOID SetLevel( level Level )
+    {
+      MinLevel = (INT)Level;
+    } /* End of 'SetLevel' function */
+
+    /* Put message to log function (never blocks).
+     * ARGUMENTS:
+     *   - message level:
+     *       level Level;
+     *   - message text:
+     *       std::string Str;
+     * RETURNS: None.
+     */
+    static VOID Write( level Level, std::string Str )
+    {
+      if (!IsLevel(Level))
+        return;
+      if (Level != level::RAW && binlog::IsOn())
+      {
+        binlog::PushText((BYTE)Level, Str);
+        return;
+      }
+      WRITER &w = Writer();
+      if (w.Push({Level, std::chrono::system_clock::now().time_since_epoch().count(), std::move(Str)}))
+        w.Pushed.fetch_add(1, std::memory_order_relaxed);
+      else
+        w.Dropped.fetch_add(1, std::memory_order_relaxed);
+    } /* End of 'Write' function */
+
+    /* Wait all put messages are written function.
      * ARGUMENTS: None.
      * RETURNS: None.
      */
-    static VOID CollectTimestamp( VOID )
+    static VOID Flush( VOID )
+    {
+      WRITER &w = Writer();
+      while (w.Written < w.Pushed)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      binlog::Flush(TRUE);
+    } /* End of 'Flush' function */
+
+    /* Redirect output function.
+     * ARGUMENTS:
+     *   - output stream (nullptr for console):
+     *       FILE *F;
+     * RETURNS: None.
+     */
+    static VOID SetOutput( FILE *F )
+    {
+      Flush();
+      WRITER &w = Writer();
+      std::lock_guard<std::mutex> lock(w.OutLock);
+      w.Out = F != nullptr ? F : stdout;
+    } /* End of 'SetOutput' function */
+
+    /* Switch leveled messages to binary log function.
+     * ARGUMENTS:
+     *   - binary log file name (empty to return to text output):
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if success.
+     */
+    static BOOL SetBinaryOutput( const std::string &FileName )
+    {
+      Flush();
+      if (FileName.empty())
+      {
+        binlog::Stop();
+        return TRUE;
+      }
+      return binlog::Start(FileName);
+    } /* End of 'SetBinaryOutput' function */
+
+    /* Obtain writer statistics function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (STATS) statistics.
+     */
+    static STATS Stats( VOID )
     {
-      std::time_t t_c = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-      std::cout << std::put_time(std::localtime(&t_c), "[%H:%M:%S]");
-    } /* End of 'CollectTimestamp' function */
+      WRITER &w = Writer();
+      return {w.Pushed, w.Written, w.Dropped, w.Batches};
+    } /* End of 'Stats' function */
 
     /* Get rainbow color by coefficient function.
      * ARGUMENTS:
@@ -111,22 +483,34 @@ namespace tse
       return ((BYTE)(R * 255) << 16) | ((BYTE)(G * 255) << 8) | ((BYTE)(B * 255) << 0);
     } /* End of 'InterpolateRainbow' function */
 
-    /* Log color into console function.
+    /* Obtain color mark text function.
      * ARGUMENTS:
-     *   - color to log:
+     *   - color (format 0x??RRGGBB):
      *       DWORD Color;
-     * RETURNS: None.
+     * RETURNS:
+     *   (std::string) colored mark.
      */
-    static VOID LogColor( DWORD Color )
+    static std::string ColorMark( DWORD Color )
     {
       INT
         R = (Color >> 16) & 0xFF,
         G = (Color >> 8) & 0xFF,
         B = (Color >> 0) & 0xFF;
-      std::cout << std::format("\x1b[38;2;{};{};{}m\x1b[38;3;0;0;0m",
+      return std::format("\x1b[38;2;{};{};{}m\x1b[38;3;0;0;0m",
         static_cast<INT>(R),
         static_cast<INT>(G),
         static_cast<INT>(B));
+    } /* End of 'ColorMark' function */
+
+    /* Log color into console function.
+     * ARGUMENTS:
+     *   - color to log:
+     *       DWORD Color;
+     * RETURNS: None.
+     */
+    static VOID LogColor( DWORD Color )
+    {
+      Write(level::RAW, ColorMark(Color));
     } /* End of 'LogColor' function */
 
     /* Log string into console function.
@@ -137,7 +521,7 @@ namespace tse
      */
     static VOID Log( const std::string &Str )
     {
-      std::cout << " " << Str;
+      Write(level::RAW, " " + Str);
     } /* End of 'Log' function */
 
     /* Log string into console with new line function.
@@ -148,7 +532,7 @@ namespace tse
      */
     static VOID LogLn( const std::string &Str )
     {
-      std::cout << Str << std::endl;
+      Write(level::RAW, Str + "\n");
     } /* End of 'LogLn' function */
 
     /* Log loading function.
@@ -165,12 +549,12 @@ namespace tse
      */
     static VOID Load( const std::string &Prefix, const std::string &Postfix, INT Width, DBL Completeness, INT Offset = 0 )
     {
-      std::cout << Prefix << "[";
+      std::string str = Prefix + "[";
       for (INT i = 0; i < Width * Completeness; i++)
-        LogColor(InterpolateRainbow(((Offset + i) % (3 * Width)) / (3.0 * Width)));
+        str += ColorMark(InterpolateRainbow(((Offset + i) % (3 * Width)) / (3.0 * Width)));
       for (INT i = Width * Completeness; i < Width; i++)
-        std::cout << "";
-      std::cout << "] " << std::format("({}%)", static_cast<INT>(Completeness * 100)) << Postfix << "\r";
+        str += "";
+      Write(level::RAW, str + "] " + std::format("({}%)", static_cast<INT>(Completeness * 100)) + Postfix + "\r");
     } /* End of 'Load' function */
 
     /* Log important string into console function.
@@ -181,10 +565,21 @@ namespace tse
      */
     static VOID Aim( const std::string &Str )
     {
-      std::cout << "\x1b[38;2;255;127;63m\x1b[48;2;0;0;0m" <<
-        "-----===+ " << Str << " +===-----" << "\x1b[38;0;0;0;0m\x1b[48;0;0;0;0m" << std::endl;
+      Write(level::RAW, "\x1b[38;2;255;127;63m\x1b[48;2;0;0;0m-----===+ " + Str +
+        " +===-----\x1b[38;0;0;0;0m\x1b[48;0;0;0;0m\n");
     } /* End of 'Aim' function */
 
+    /* Debug string into console function.
+     * ARGUMENTS:
+     *   - string to log:
+     *       const std::string &Str;
+     * RETURNS: None.
+     */
+    static VOID Debug( const std::string &Str )
+    {
+      Write(level::DBG, Str);
+    } /* End of 'Debug' function */
+
     /* Info string into console function.
      * ARGUMENTS:
      *   - string to log:
@@ -193,10 +588,7 @@ namespace tse
      */
     static VOID Info( const std::string &Str )
     {
-      std::cout << "\x1b[38;2;255;255;255m\x1b[48;2;0;127;190m" <<
-        "[INFO]" << "\x1b[38;0;0;0;0m\x1b[48;0;0;0;0m" << " ";
-      CollectTimestamp();
-      std::cout << " \x1b[38;2;127;255;255m" << Str << "\x1b[38;0;0;0;0m" << std::endl;
+      Write(level::INFO, Str);
     } /* End of 'Info' function */
 
     /* System string into console function.
@@ -207,10 +599,7 @@ namespace tse
      */
     static VOID Sys( const std::string &Str )
     {
-      std::cout << "\x1b[38;2;255;255;255m\x1b[48;2;0;127;0m" <<
-        "[SYS]" << "\x1b[38;0;0;0;0m\x1b[48;0;0;0;0m" << " ";
-      CollectTimestamp();
-      std::cout << " \x1b[38;2;127;255;127m" << Str << "\x1b[38;0;0;0;0m" << std::endl;
+      Write(level::SYS, Str);
     } /* End of 'Sys' function */
 
     /* Warn string into console function.
@@ -221,10 +610,7 @@ namespace tse
      */
     static VOID Warn( const std::string &Str )
     {
-      std::cout << "\x1b[38;2;255;255;255m\x1b[48;2;190;127;0m" <<
-        "[WARN]" << "\x1b[38;0;0;0;0m\x1b[48;0;0;0;0m" << " ";
-      CollectTimestamp();
-      std::cout << " \x1b[38;2;255;190;63m" << Str << "\x1b[38;0;0;0;0m" << std::endl;
+      Write(level::WARN, Str);
     } /* End of 'Warn' function */
 
     /* Error string into console function.
@@ -235,10 +621,7 @@ namespace tse
      */
     static VOID Err( const std::string &Str )
     {
-      std::cout << "\x1b[38;2;255;255;255m\x1b[48;2;255;0;0m" <<
-        "[ERROR]" << "\x1b[38;0;0;0;0m\x1b[48;0;0;0;0m" << " ";
-      CollectTimestamp();
-      std::cout << " \x1b[38;2;255;127;127m" << Str << "\x1b[38;0;0;0;0m" << std::endl;
+      Write(level::ERR, Str);
     } /* End of 'Err' function */
 
   } _{}; /* End of 'logger' class */
@@ -0,0 +1,466 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : profiler.h
+ * PURPOSE     : Tough Space Exploration project.
+ *               Common utilities.
+ *               Scoped CPU profiler module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __profiler_h_
+#define __profiler_h_
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif /* _MSC_VER */
+
+/* Profile zone until end of scope macro (name is string literal or 'std::string' to be interned) */
+#define TSE_PROFILE_CONCAT2(A, B) A##B
+#define TSE_PROFILE_CONCAT(A, B) TSE_PROFILE_CONCAT2(A, B)
+#define TSE_PROFILE(Name) tse::profiler::scope TSE_PROFILE_CONCAT(__tse_profile_, __LINE__)(Name)
+
+/* Main program namespace */
+namespace tse
+{
+  /* Scoped CPU profiler class.
+   * Every thread writes finished zones into its own fixed size buffer:
+   * hot path is two timestamps and one store without any locks. Capture is
+   * restarted by bumping epoch, threads drop their old events on next write
+   * (buffer sequence number lets readers detect such restarts).
+   * Results are exported as Chrome trace JSON (chrome://tracing, Perfetto). */
+  class profiler
+  {
+  public:
+    static const INT BufferSize = 1 << 16; // Events per thread capture
+
+    /* Zone summary structure (times in milliseconds) */
+    struct ZONE_STATS
+    {
+      std::string Name; // Zone name
+      INT Count;        // Number of calls
+      DBL Total, Max;   // Total and maximal time
+    }; /* End of 'ZONE_STATS' structure */
+
+  private:
+    /* Finished zone event structure */
+    struct EVENT
+    {
+      const CHAR *Name;  // Zone name
+      UINT64 Start, End; // Timestamps (ticks)
+    }; /* End of 'EVENT' structure */
+
+    /* Thread events buffer structure */
+    struct THREAD_BUFFER
+    {
+      std::unique_ptr<EVENT[]> Events {new EVENT[BufferSize]}; // Events storage
+      std::atomic_int Count {0};                              // Number of published events
+      std::atomic<UINT64> Epoch {0};                          // Capture events belong to
+      std::atomic<UINT64> Seq {0};                            // Restarts sequence number (odd while restarting)
+      std::atomic<UINT64> Dropped {0};                        // Events lost due to full buffer
+      INT Id = 0;                                             // Trace thread id
+      std::string Name;                                       // Thread name
+      std::atomic_bool IsFree {FALSE};                        // Owner thread exited flag
+    }; /* End of 'THREAD_BUFFER' structure */
+
+    static inline std::mutex Lock;                                  // Buffers list lock
+    static inline std::vector<std::unique_ptr<THREAD_BUFFER>> Buffers; // All threads buffers
+    static inline std::atomic_bool IsEnabled {FALSE};                 // Recording flag
+    static inline std::atomic<UINT64> Epoch {1};                      // Current capture number
+    static inline std::atomic_int NumOfFrames {0};                    // Frames in current capture
+    static inline DBL TicksPerUs = 0;                                 // Timestamp frequency
+    static inline std::mutex NamesLock;                               // Interned names lock
+    static inline std::set<std::string> Names;                        // Interned zone names (never freed)
+
+    /* Thread buffer owner structure (buffer is given back for reuse when thread exits) */
+    struct OWNER
+    {
+      THREAD_BUFFER *Buf = nullptr; // Thread buffer
+      std::string Name;             // Thread name
+
+      /* Class destructor */
+      ~OWNER( VOID )
+      {
+        if (Buf != nullptr)
+          Buf->IsFree = TRUE;
+      } /* End of '~OWNER' function */
+    }; /* End of 'OWNER' structure */
+    static inline thread_local OWNER Owner; // Current thread buffer owner
+
+    /* Obtain current thread buffer function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (THREAD_BUFFER *) buffer pointer.
+     */
+    static THREAD_BUFFER * Buffer( VOID )
+    {
+      if (Owner.Buf == nullptr)
+      {
+        std::lock_guard<std::mutex> lock(Lock);
+        /* Exited threads buffers are reused only when their capture is over */
+        for (auto &b : Buffers)
+          if (b->IsFree && b->Epoch != Epoch)
+          {
+            Owner.Buf = b.get();
+            break;
+          }
+        if (Owner.Buf == nullptr)
+          Owner.Buf = Buffers.emplace_back(std::make_unique<THREAD_BUFFER>()).get();
+        Owner.Buf->Id = (INT)Buffers.size() * 1000 + (INT)(std::hash<std::thread::id>()(std::this_thread::get_id()) % 1000);
+        Owner.Buf->Name = Owner.Name.empty() ? "Thread " + std::to_string(Owner.Buf->Id) : Owner.Name;
+        Owner.Buf->Epoch = 0;
+        Owner.Buf->IsFree = FALSE;
+      }
+      return Owner.Buf;
+    } /* End of 'Buffer' function */
+
+    /* Store finished zone function.
+     * ARGUMENTS:
+     *   - zone name:
+     *       const CHAR *Name;
+     *   - zone timestamps:
+     *       UINT64 Start, End;
+     * RETURNS: None.
+     */
+    static VOID Record( const CHAR *Name, UINT64 Start, UINT64 End )
+    {
+      THREAD_BUFFER *buf = Buffer();
+      UINT64 epoch = Epoch.load(std::memory_order_relaxed);
+
+      if (buf->Epoch.load(std::memory_order_relaxed) != epoch)
+      {
+        /* Readers drop events copied while sequence number is changed (see 'Walk') */
+        UINT64 seq = buf->Seq.load(std::memory_order_relaxed);
+        buf->Seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        buf->Count.store(0, std::memory_order_relaxed);
+        buf->Epoch.store(epoch, std::memory_order_relaxed);
+        buf->Seq.store(seq + 2, std::memory_order_release);
+      }
+      INT n = buf->Count.load(std::memory_order_relaxed);
+      if (n >= BufferSize)
+      {
+        buf->Dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      buf->Events[n] = {Name, Start, End};
+      buf->Count.store(n + 1, std::memory_order_release);
+    } /* End of 'Record' function */
+
+    /* Walk through current capture events function.
+     * ARGUMENTS:
+     *   - walker function:
+     *       WalkType W;
+     * RETURNS: None.
+     */
+    template<class WalkType>
+      static VOID Walk( WalkType W )
+      {
+        std::lock_guard<std::mutex> lock(Lock);
+        UINT64 epoch = Epoch;
+        std::vector<EVENT> events;
+        for (auto &b : Buffers)
+        {
+          /* Owner thread may restart buffer meanwhile: events are copied and used if it did not */
+          UINT64 seq = b->Seq.load(std::memory_order_acquire);
+          if ((seq & 1) != 0 || b->Epoch.load(std::memory_order_relaxed) != epoch)
+            continue;
+          INT n = b->Count.load(std::memory_order_acquire);
+          events.assign(b->Events.get(), b->Events.get() + n);
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if (b->Seq.load(std::memory_order_relaxed) != seq)
+            continue;
+          for (const EVENT &e : events)
+            W(*b, e);
+        }
+      } /* End of 'Walk' function */
+
+    /* Obtain interned zone name function.
+     * ARGUMENTS:
+     *   - zone name:
+     *       const std::string &Name;
+     * RETURNS:
+     *   (const CHAR *) name pointer valid until program end.
+     */
+    static const CHAR * Intern( const std::string &Name )
+    {
+      std::lock_guard<std::mutex> lock(NamesLock);
+      return Names.insert(Name).first->c_str();
+    } /* End of 'Intern' function */
+
+  public:
+    /* Zone scope class */
+    class scope
+    {
+      const CHAR *Name; // Zone name
+      UINT64 Start;     // Start timestamp
+      BOOL IsActive;    // Recording flag (captured at zone start)
+
+    public:
+      /* Class constructor.
+       * ARGUMENTS:
+       *   - zone name (string literal, pointer is stored):
+       *       const CHAR *NewName;
+       */
+      scope( const CHAR *NewName ) :
+        Name(NewName), Start(0), IsActive(IsEnabled.load(std::memory_order_relaxed))
+      {
+        if (IsActive)
+          Start = Ticks();
+      } /* End of 'scope' function */
+
+      /* Class constructor.
+       * ARGUMENTS:
+       *   - zone name (interned, may be destroyed before capture):
+       *       const std::string &NewName;
+       */
+      scope( const std::string &NewName ) :
+        Name(nullptr), Start(0), IsActive(IsEnabled.load(std::memory_order_relaxed))
+      {
+        if (IsActive)
+        {
+          Name = Intern(NewName);
+          Start = Ticks();
+        }
+      } /* End of 'scope' function */
+
+      /* Class destructor */
+      ~scope( VOID )
+      {
+        if (IsActive)
+          Record(Name, Start, Ticks());
+      } /* End of '~scope' function */
+    }; /* End of 'scope' class */
+
+    /* Obtain timestamp function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) CPU timestamp counter (steady clock where unavailable).
+     */
+    static UINT64 Ticks( VOID )
+    {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+      return __rdtsc();
+#else
+      return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif /* x86 */
+    } /* End of 'Ticks' function */
+
+    /* Enable/disable recording function.
+     * ARGUMENTS:
+     *   - enable flag:
+     *       BOOL Enable;
+     * RETURNS: None.
+     */
+    static VOID Enable( BOOL Enable )
+    {
+      if (Enable && TicksPerUs == 0)
+      {
+        /* Calibrate timestamps by steady clock */
+        auto t0 = std::chrono::steady_clock::now();
+        UINT64 c0 = Ticks();
+        while (std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(10))
+          ;
+        UINT64 c1 = Ticks();
+        TicksPerUs = (c1 - c0) / std::chrono::duration<DBL, std::micro>(std::chrono::steady_clock::now() - t0).count();
+      }
+      if (Enable && !IsEnabled)
+        Reset();
+      IsEnabled = Enable;
+    } /* End of 'Enable' function */
+
+    /* Obtain recording flag function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (BOOL) TRUE if profiler records zones.
+     */
+    static BOOL IsOn( VOID )
+    {
+      return IsEnabled;
+    } /* End of 'IsOn' function */
+
+    /* Start new capture (drop all recorded events) function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    static VOID Reset( VOID )
+    {
+      Epoch++;
+      NumOfFrames = 0;
+    } /* End of 'Reset' function */
+
+    /* Mark frame end function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    static VOID FrameMark( VOID )
+    {
+      if (IsEnabled)
+        NumOfFrames++;
+    } /* End of 'FrameMark' function */
+
+    /* Obtain number of frames in capture function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) number of frames.
+     */
+    static INT Frames( VOID )
+    {
+      return NumOfFrames;
+    } /* End of 'Frames' function */
+
+    /* Set current thread name (shown in trace) function.
+     * ARGUMENTS:
+     *   - thread name:
+     *       const std::string &Name;
+     * RETURNS: None.
+     */
+    static VOID SetThreadName( const std::string &Name )
+    {
+      std::lock_guard<std::mutex> lock(Lock);
+      Owner.Name = Name;
+      if (Owner.Buf != nullptr)
+        Owner.Buf->Name = Name;
+    } /* End of 'SetThreadName' function */
+
+    /* Obtain capture summary function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (std::vector<ZONE_STATS>) zones sorted by total time.
+     */
+    static std::vector<ZONE_STATS> Summary( VOID )
+    {
+      std::map<std::string, ZONE_STATS> zones;
+      Walk([&]( THREAD_BUFFER &B, const EVENT &E )
+        {
+          ZONE_STATS &z = zones[E.Name];
+          DBL ms = (E.End - E.Start) / TicksPerUs / 1000;
+          z.Name = E.Name;
+          z.Count++;
+          z.Total += ms;
+          z.Max = std::max(z.Max, ms);
+        });
+      std::vector<ZONE_STATS> res;
+      for (auto &z : zones)
+        res.push_back(z.second);
+      std::sort(res.begin(), res.end(), []( const ZONE_STATS &A, const ZONE_STATS &B ){ return A.Total > B.Total; });
+      return res;
+    } /* End of 'Summary' function */
+
+    /* Build text report function.
+     * ARGUMENTS:
+     *   - maximal number of zones:
+     *       INT MaxZones;
+     * RETURNS:
+     *   (std::string) report text (one zone per line, times per frame).
+     */
+    static std::string Report( INT MaxZones = 16 )
+    {
+      INT frames = std::max(1, (INT)NumOfFrames);
+      std::string rep;
+      for (auto &z : Summary())
+      {
+        if (MaxZones-- <= 0)
+          break;
+        rep += std::format("{:<16} {:7.3f} ms/frame {:6.1f} calls/frame max {:7.3f} ms\n",
+          z.Name, z.Total / frames, (DBL)z.Count / frames, z.Max);
+      }
+      return rep;
+    } /* End of 'Report' function */
+
+    /* Obtain number of recorded events function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) number of events in current capture.
+     */
+    static INT NumOfEvents( VOID )
+    {
+      INT n = 0;
+      Walk([&]( THREAD_BUFFER &B, const EVENT &E ){ n++; });
+      return n;
+    } /* End of 'NumOfEvents' function */
+
+    /* Dump capture to Chrome trace JSON file function.
+     * ARGUMENTS:
+     *   - file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if success, FALSE otherwise.
+     */
+    static BOOL DumpTrace( const std::string &FileName )
+    {
+      std::ofstream f(FileName);
+      if (!f.is_open())
+        return FALSE;
+
+      auto Escape = []( const std::string &S )
+        {
+          std::string r;
+          for (CHAR ch : S)
+            if (ch == '"' || ch == '\\')
+              r += '\\', r += ch;
+            else if ((BYTE)ch >= ' ')
+              r += ch;
+          return r;
+        };
+      UINT64 base = ~0ull;
+      Walk([&]( THREAD_BUFFER &B, const EVENT &E ){ base = std::min(base, E.Start); });
+
+      BOOL is_first = TRUE;
+      std::set<INT> threads;
+      f << "{\"traceEvents\":[\n";
+      Walk([&]( THREAD_BUFFER &B, const EVENT &E )
+        {
+          if (threads.insert(B.Id).second)
+          {
+            f << std::format("{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+              is_first ? "" : ",\n", B.Id, Escape(B.Name));
+            is_first = FALSE;
+          }
+          f << std::format("{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+            is_first ? "" : ",\n", Escape(E.Name), B.Id,
+            (E.Start - base) / TicksPerUs, (E.End - E.Start) / TicksPerUs);
+          is_first = FALSE;
+        });
+      f << "\n],\"displayTimeUnit\":\"ms\"}\n";
+      return TRUE;
+    } /* End of 'DumpTrace' function */
+
+    /* Measure zone recording cost function (starts new capture).
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (DBL) cost of one recorded zone in nanoseconds.
+     */
+    static DBL ZoneCost( VOID )
+    {
+      BOOL was_enabled = IsEnabled;
+      const INT n = BufferSize / 2;
+
+      Enable(TRUE);
+      Reset();
+      auto start = std::chrono::steady_clock::now();
+      for (INT i = 0; i < n; i++)
+        scope zone("ZoneCost");
+      DBL ns = std::chrono::duration<DBL, std::nano>(std::chrono::steady_clock::now() - start).count();
+      Reset();
+      IsEnabled = was_enabled;
+      return ns / n;
+    } /* End of 'ZoneCost' function */
+
+  }; /* End of 'profiler' class */
+
+} /* end of 'tse' namespace */
+
+#endif /* __profiler_h_ */
+
+/* END OF 'profiler.h' FILE */
@@ -0,0 +1,239 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : lz4.h
+ * PURPOSE     : Tough Space Exploration project.
+ *               Common utilities.
+ *               LZ4 block format compression module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Block is sequences of: token (literals length << 4 |
+ *               match length - 4, 15 means more length bytes follow),
+ *               extra literals length bytes (255 means more), literals,
+ *               UINT16 match offset, extra match length bytes. Last
+ *               sequence has literals only, last 5 bytes are literals.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __lz4_h_
+#define __lz4_h_
+
+/* Main program namespace */
+namespace tse
+{
+  /* LZ4 block format compression class.
+   * Greedy single pass compressor with hash table of last positions,
+   * decompressor checks all bounds (data may come from damaged file). */
+  class lz4
+  {
+  private:
+    static const INT MinMatch = 4;         // Minimal match length
+    static const INT LastLiterals = 5;     // Block tail always stored as literals
+    static const INT MatchStartLimit = 12; // Last match start distance to block end
+    static const INT HashLog = 16;         // Hash table size log
+    static const INT MaxOffset = 65535;    // Maximal match offset
+
+    /* Read unaligned 32-bit value function.
+     * ARGUMENTS:
+     *   - data pointer:
+     *       const BYTE *Ptr;
+     * RETURNS:
+     *   (UINT32) value.
+     */
+    static UINT32 Read32( const BYTE *Ptr )
+    {
+      UINT32 v;
+      memcpy(&v, Ptr, sizeof(v));
+      return v;
+    } /* End of 'Read32' function */
+
+    /* Write length extra bytes function.
+     * ARGUMENTS:
+     *   - output pointer:
+     *       BYTE *&Out;
+     *   - length above 15:
+     *       SIZE_T Len;
+     * RETURNS: None.
+     */
+    static VOID WriteLength( BYTE *&Out, SIZE_T Len )
+    {
+      for (; Len >= 255; Len -= 255)
+        *Out++ = 255;
+      *Out++ = (BYTE)Len;
+    } /* End of 'WriteLength' function */
+
+    /* Read length extra bytes function.
+     * ARGUMENTS:
+     *   - input pointer and its end:
+     *       const BYTE *&In, *End;
+     *   - length to add to:
+     *       SIZE_T &Len;
+     * RETURNS:
+     *   (BOOL) TRUE if success, FALSE if input is over.
+     */
+    static BOOL ReadLength( const BYTE *&In, const BYTE *End, SIZE_T &Len )
+    {
+      BYTE b;
+      do
+      {
+        if (In >= End)
+          return FALSE;
+        b = *In++;
+        Len += b;
+      } while (b == 255);
+      return TRUE;
+    } /* End of 'ReadLength' function */
+
+  public:
+    /* Obtain worst case compressed size function.
+     * ARGUMENTS:
+     *   - source size:
+     *       SIZE_T Size;
+     * RETURNS:
+     *   (SIZE_T) compressed size bound.
+     */
+    static SIZE_T Bound( SIZE_T Size )
+    {
+      return Size + Size / 255 + 16;
+    } /* End of 'Bound' function */
+
+    /* Compress block function.
+     * ARGUMENTS:
+     *   - source data:
+     *       const BYTE *Src;
+     *       SIZE_T Size;
+     *   - destination buffer:
+     *       BYTE *Dst;
+     *       SIZE_T Capacity;
+     * RETURNS:
+     *   (SIZE_T) compressed size, 0 if destination buffer is too small.
+     */
+    static SIZE_T Compress( const BYTE *Src, SIZE_T Size, BYTE *Dst, SIZE_T Capacity )
+    {
+      const BYTE *ip = Src, *anchor = Src, *end = Src + Size;
+      BYTE *op = Dst, *out_end = Dst + Capacity;
+
+      if (Size > MatchStartLimit)
+      {
+        std::vector<UINT32> table(1 << HashLog, 0);
+        const BYTE
+          *match_end = end - LastLiterals,   // Matches end before
+          *start_end = end - MatchStartLimit; // Matches start before or at
+
+        while (ip <= start_end)
+        {
+          UINT32 seq = Read32(ip);
+          UINT32 h = (seq * 2654435761u) >> (32 - HashLog);
+          const BYTE *ref = Src + table[h];
+          table[h] = (UINT32)(ip - Src);
+          if (ref >= ip || ip - ref > MaxOffset || Read32(ref) != seq)
+          {
+            ip++;
+            continue;
+          }
+
+          /* Extend match forward and backward */
+          const BYTE *mp = ip + MinMatch, *rp = ref + MinMatch;
+          while (mp < match_end && *mp == *rp)
+            mp++, rp++;
+          while (ip > anchor && ref > Src && ip[-1] == ref[-1])
+            ip--, ref--;
+
+          /* Sequence: token, literals, offset, match length */
+          SIZE_T lit = ip - anchor, len = mp - ip - MinMatch;
+          if ((SIZE_T)(out_end - op) < 1 + lit / 255 + 1 + lit + 2 + len / 255 + 1)
+            return 0;
+          BYTE *token = op++;
+          *token = (BYTE)(std::min<SIZE_T>(lit, 15) << 4 | std::min<SIZE_T>(len, 15));
+          if (lit >= 15)
+            WriteLength(op, lit - 15);
+          memcpy(op, anchor, lit);
+          op += lit;
+          UINT32 offset = (UINT32)(ip - ref);
+          *op++ = (BYTE)offset;
+          *op++ = (BYTE)(offset >> 8);
+          if (len >= 15)
+            WriteLength(op, len - 15);
+          ip = anchor = mp;
+        }
+      }
+
+      /* Last literals */
+      SIZE_T lit = end - anchor;
+      if ((SIZE_T)(out_end - op) < 1 + lit / 255 + 1 + lit)
+        return 0;
+      *op++ = (BYTE)(std::min<SIZE_T>(lit, 15) << 4);
+      if (lit >= 15)
+        WriteLength(op, lit - 15);
+      memcpy(op, anchor, lit);
+      op += lit;
+      return op - Dst;
+    } /* End of 'Compress' function */
+
+    /* Decompress block function.
+     * ARGUMENTS:
+     *   - compressed data:
+     *       const BYTE *Src;
+     *       SIZE_T Size;
+     *   - destination buffer (exactly original size):
+     *       BYTE *Dst;
+     *       SIZE_T DstSize;
+     * RETURNS:
+     *   (BOOL) TRUE if success, FALSE if data is damaged.
+     */
+    static BOOL Decompress( const BYTE *Src, SIZE_T Size, BYTE *Dst, SIZE_T DstSize )
+    {
+      const BYTE *ip = Src, *in_end = Src + Size;
+      BYTE *op = Dst, *out_end = Dst + DstSize;
+
+      while (ip < in_end)
+      {
+        BYTE token = *ip++;
+
+        /* Literals */
+        SIZE_T lit = token >> 4;
+        if (lit == 15 && !ReadLength(ip, in_end, lit))
+          return FALSE;
+        if (lit > (SIZE_T)(in_end - ip) || lit > (SIZE_T)(out_end - op))
+          return FALSE;
+        memcpy(op, ip, lit);
+        op += lit;
+        ip += lit;
+        if (ip == in_end)
+          break;
+
+        /* Match (may overlap output being written) */
+        if (in_end - ip < 2)
+          return FALSE;
+        SIZE_T offset = ip[0] | ip[1] << 8;
+        ip += 2;
+        if (offset == 0 || offset > (SIZE_T)(op - Dst))
+          return FALSE;
+        SIZE_T len = token & 15;
+        if (len == 15 && !ReadLength(ip, in_end, len))
+          return FALSE;
+        len += MinMatch;
+        if (len > (SIZE_T)(out_end - op))
+          return FALSE;
+        const BYTE *ref = op - offset;
+        if (offset >= len)
+          memcpy(op, ref, len), op += len;
+        else
+          while (len-- > 0)
+            *op++ = *ref++;
+      }
+      return op == out_end;
+    } /* End of 'Decompress' function */
+
+  }; /* End of 'lz4' class */
+
+} /* end of 'tse' namespace */
+
+#endif /* __lz4_h_ */
+
+/* END OF 'lz4.h' FILE */
@@ -0,0 +1,550 @@
+/*************************************************************
+ * Copyright (C) 2025
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ *************************************************************/
+
+/* FILE NAME   : vfs.h
+ * PURPOSE     : Tough Space Exploration project.
+ *               Common utilities.
+ *               Virtual file system (packed assets archives) module.
+ * PROGRAMMER  : CGSG-Jr'2024-25.
+ *               Belykh Andrey (AB7).
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Pack file format (little endian):
+ *               header page (4096 bytes): 'TPAK', UINT32 version,
+ *               UINT32 number of entries, UINT32 number of buckets
+ *               (power of 2), UINT64 table of contents offset and size;
+ *               entries data at 4096 bytes aligned offsets (stored or
+ *               LZ4 block compressed);
+ *               table of contents: entries ('vfs::ENTRY'), buckets
+ *               (UINT32 entry index + 1, 0 for empty, linear probing
+ *               from name hash), names block (no terminators).
+ *               Names are normalized: lower case, '/' separators,
+ *               relative to working directory.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum
+ */
+
+#ifndef __vfs_h_
+#define __vfs_h_
+
+#include "lz4.h"
+
+/* Main program namespace */
+namespace tse
+{
+  /* Virtual file system class.
+   * Mounted packs are memory mapped once, file lookup is a hash table probe
+   * in mapped table of contents. Files absent in packs are read from disk.
+   * Packs shadow loose files unless loose files are preferred by reader
+   * (shader sources are, to be hot reloaded).
+   * Packs are mounted at startup before any loading starts. */
+  class vfs
+  {
+  public:
+    static const UINT32 Version = 1;     // Pack format version
+    static const UINT64 Alignment = 4096; // Entries data alignment
+
+    /* Entry data compression */
+    enum class codec : UINT32
+    {
+      STORE, // Data is stored as is
+      LZ4,   // LZ4 block
+    };
+
+    /* Pack header structure */
+    struct HEADER
+    {
+      CHAR Sign[4];        // Signature 'TPAK'
+      UINT32 Version;      // Format version
+      UINT32 NumOfEntries; // Number of entries
+      UINT32 NumOfBuckets; // Number of hash table buckets (power of 2)
+      UINT64 TocOffset;    // Table of contents offset
+      UINT64 TocSize;      // Table of contents size
+    }; /* End of 'HEADER' structure */
+
+    /* Table of contents entry structure */
+    struct ENTRY
+    {
+      UINT64 Hash;         // Normalized name hash
+      UINT64 Offset;       // Data offset in pack (aligned)
+      UINT64 Size;         // Stored data size
+      UINT64 OrigSize;     // Original data size
+      UINT32 NameOffset;   // Name offset in names block
+      UINT32 NameLength;   // Name length
+      codec Codec;         // Data compression
+      UINT32 Reserved;     // Zero
+    }; /* End of 'ENTRY' structure */
+
+    /* Reading statistics structure */
+    struct STATS
+    {
+      UINT64 PackReads;    // Files read from packs
+      UINT64 LooseReads;   // Files read from disk
+      UINT64 PackBytes;    // Data size read from packs (original)
+      UINT64 LooseBytes;   // Data size read from disk
+      INT Mappings;        // Mounted packs
+    }; /* End of 'STATS' structure */
+
+    /* Pack building statistics structure */
+    struct BUILD_STATS
+    {
+      INT Files = 0;           // Packed files
+      INT Compressed = 0;      // Compressed files
+      UINT64 Bytes = 0;        // Original files size
+      UINT64 StoredBytes = 0;  // Stored data size
+      UINT64 PackSize = 0;     // Pack file size
+      DBL Time = 0;            // Building time (ms)
+    }; /* End of 'BUILD_STATS' structure */
+
+  private:
+    /* Mounted pack structure */
+    struct PACK
+    {
+      std::string FileName;            // Pack file name
+      const BYTE *Data = nullptr;      // Mapped pack
+      SIZE_T Size = 0;                 // Pack size
+#ifdef _WIN32
+      HANDLE hFile = INVALID_HANDLE_VALUE; // File handle
+      HANDLE hMap = nullptr;           // File mapping handle
+#else
+      INT Fd = -1;                     // File descriptor
+#endif /* _WIN32 */
+      const HEADER *Hdr = nullptr;     // Header
+      const ENTRY *Entries = nullptr;  // Table of contents entries
+      const UINT32 *Buckets = nullptr; // Hash table buckets
+      const CHAR *Names = nullptr;     // Names block
+
+      /* Structure destructor */
+      ~PACK( VOID )
+      {
+#ifdef _WIN32
+        if (Data != nullptr)
+          UnmapViewOfFile(Data);
+        if (hMap != nullptr)
+          CloseHandle(hMap);
+        if (hFile != INVALID_HANDLE_VALUE)
+          CloseHandle(hFile);
+#else
+        if (Data != nullptr)
+          munmap((VOID *)Data, Size);
+        if (Fd != -1)
+          close(Fd);
+#endif /* _WIN32 */
+      } /* End of '~PACK' function */
+    }; /* End of 'PACK' structure */
+
+    static inline std::vector<std::unique_ptr<PACK>> Packs; // Mounted packs (last mounted is searched first)
+    static inline std::atomic<UINT64>
+      PackReads {0},                                       // Files read from packs
+      LooseReads {0},                                      // Files read from disk
+      PackBytes {0},                                       // Data size read from packs
+      LooseBytes {0};                                      // Data size read from disk
+
+    /* Find pack entry function.
+     * ARGUMENTS:
+     *   - file name:
+     *       const std::string &FileName;
+     *   - pack entry is found at:
+     *       const PACK **Pack;
+     * RETURNS:
+     *   (const ENTRY *) entry or nullptr if file is not packed.
+     */
+    static const ENTRY * Find( const std::string &FileName, const PACK **Pack )
+    {
+      if (Packs.empty())
+        return nullptr;
+      std::string name = Normalize(FileName);
+      UINT64 hash = Hash64(name);
+      for (auto p = Packs.rbegin(); p != Packs.rend(); p++)
+      {
+        UINT32 mask = (*p)->Hdr->NumOfBuckets - 1;
+        for (UINT32 b = (UINT32)hash & mask; (*p)->Buckets[b] != 0; b = (b + 1) & mask)
+        {
+          const ENTRY &e = (*p)->Entries[(*p)->Buckets[b] - 1];
+          if (e.Hash == hash && name == std::string_view((*p)->Names + e.NameOffset, e.NameLength))
+          {
+            *Pack = p->get();
+            return &e;
+          }
+        }
+      }
+      return nullptr;
+    } /* End of 'Find' function */
+
+  public:
+    /* Normalize file name for packs lookup function.
+     * ARGUMENTS:
+     *   - file name (relative to working directory or absolute):
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (std::string) normalized name.
+     */
+    static std::string Normalize( const std::string &FileName )
+    {
+      auto Lower = []( std::string Name )
+        {
+          for (auto &c : Name)
+            c = c == '\\' ? '/' : (CHAR)tolower((UCHAR)c);
+          return Name;
+        };
+      static const std::string root = [&Lower]( VOID )
+        {
+          std::string r = Lower(std::filesystem::current_path().string());
+          if (!r.empty() && r.back() != '/')
+            r += '/';
+          return r;
+        }();
+
+      std::string name = Lower(FileName);
+      if (name.starts_with(root))
+        name.erase(0, root.size());
+      while (name.starts_with("./"))
+        name.erase(0, 2);
+      return name;
+    } /* End of 'Normalize' function */
+
+    /* Mount pack function.
+     * ARGUMENTS:
+     *   - pack file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if success.
+     */
+    static BOOL Mount( const std::string &FileName )
+    {
+      auto pack = std::make_unique<PACK>();
+      pack->FileName = FileName;
+
+#ifdef _WIN32
+      pack->hFile = CreateFileA(FileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      LARGE_INTEGER size {};
+      if (pack->hFile != INVALID_HANDLE_VALUE && GetFileSizeEx(pack->hFile, &size) && size.QuadPart > 0)
+      {
+        pack->Size = (SIZE_T)size.QuadPart;
+        pack->hMap = CreateFileMappingA(pack->hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (pack->hMap != nullptr)
+          pack->Data = (const BYTE *)MapViewOfFile(pack->hMap, FILE_MAP_READ, 0, 0, 0);
+      }
+#else
+      pack->Fd = open(FileName.c_str(), O_RDONLY);
+      struct stat st {};
+      if (pack->Fd != -1 && fstat(pack->Fd, &st) == 0 && st.st_size > 0)
+      {
+        pack->Size = (SIZE_T)st.st_size;
+        VOID *mem = mmap(nullptr, pack->Size, PROT_READ, MAP_PRIVATE, pack->Fd, 0);
+        pack->Data = mem != MAP_FAILED ? (const BYTE *)mem : nullptr;
+      }
+#endif /* _WIN32 */
+      if (pack->Data == nullptr)
+      {
+        tse::logger::Warn("VFS can't map pack " + FileName);
+        return FALSE;
+      }
+
+      /* Validate everything lookups touch */
+      const HEADER *hdr = (const HEADER *)pack->Data;
+      BOOL is_ok = pack->Size >= Alignment && memcmp(hdr->Sign, "TPAK", 4) == 0 && hdr->Version == Version &&
+        hdr->NumOfBuckets > hdr->NumOfEntries && (hdr->NumOfBuckets & (hdr->NumOfBuckets - 1)) == 0 &&
+        hdr->TocOffset <= pack->Size && hdr->TocSize <= pack->Size - hdr->TocOffset &&
+        (UINT64)hdr->NumOfEntries * sizeof(ENTRY) + (UINT64)hdr->NumOfBuckets * sizeof(UINT32) <= hdr->TocSize;
+      if (is_ok)
+      {
+        pack->Hdr = hdr;
+        pack->Entries = (const ENTRY *)(pack->Data + hdr->TocOffset);
+        pack->Buckets = (const UINT32 *)(pack->Entries + hdr->NumOfEntries);
+        pack->Names = (const CHAR *)(pack->Buckets + hdr->NumOfBuckets);
+        UINT64 names_size = hdr->TocSize - ((const BYTE *)pack->Names - (pack->Data + hdr->TocOffset));
+        for (UINT32 i = 0; is_ok && i < hdr->NumOfEntries; i++)
+        {
+          const ENTRY &e = pack->Entries[i];
+          is_ok = e.Offset <= pack->Size && e.Size <= pack->Size - e.Offset &&
+            (UINT64)e.NameOffset + e.NameLength <= names_size &&
+            (e.Codec == codec::STORE ? e.Size == e.OrigSize : e.Codec == codec::LZ4);
+        }
+        /* Probing stops at empty bucket, so there should be one */
+        UINT32 used = 0;
+        for (UINT32 b = 0; is_ok && b < hdr->NumOfBuckets; b++)
+          is_ok = pack->Buckets[b] <= hdr->NumOfEntries, used += pack->Buckets[b] != 0;
+        is_ok = is_ok && used <= hdr->NumOfEntries;
+      }
+      if (!is_ok)
+      {
+        tse::logger::Warn("VFS damaged pack " + FileName);
+        return FALSE;
+      }
+      tse::logger::Info(std::format("VFS mounted {}: {} files, {:.1f} MB", FileName, hdr->NumOfEntries,
+        pack->Size / 1048576.0));
+      Packs.push_back(std::move(pack));
+      return TRUE;
+    } /* End of 'Mount' function */
+
+    /* Unmount all packs function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    static VOID Unmount( VOID )
+    {
+      Packs.clear();
+    } /* End of 'Unmount' function */
+
+    /* Check if file is in mounted pack function.
+     * ARGUMENTS:
+     *   - file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if file is packed.
+     */
+    static BOOL IsPacked( const std::string &FileName )
+    {
+      const PACK *pack;
+      return Find(FileName, &pack) != nullptr;
+    } /* End of 'IsPacked' function */
+
+    /* Check file existence function.
+     * ARGUMENTS:
+     *   - file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if file is packed or exists on disk.
+     */
+    static BOOL Exists( const std::string &FileName )
+    {
+      std::error_code ec;
+      return IsPacked(FileName) || std::filesystem::is_regular_file(FileName, ec);
+    } /* End of 'Exists' function */
+
+    /* Read whole file function.
+     * ARGUMENTS:
+     *   - file name:
+     *       const std::string &FileName;
+     *   - file data:
+     *       std::vector<BYTE> &Data;
+     *   - existing loose file is read instead of packed one flag:
+     *       BOOL IsLooseFirst;
+     * RETURNS:
+     *   (BOOL) TRUE if success.
+     */
+    static BOOL Read( const std::string &FileName, std::vector<BYTE> &Data, BOOL IsLooseFirst = FALSE )
+    {
+      const PACK *pack;
+      const ENTRY *e = nullptr;
+      if (std::error_code ec; !IsLooseFirst || !std::filesystem::is_regular_file(FileName, ec))
+        e = Find(FileName, &pack);
+      if (e != nullptr)
+      {
+        const BYTE *src = pack->Data + e->Offset;
+        if (e->Codec == codec::STORE)
+          Data.assign(src, src + e->Size);
+        else
+        {
+          Data.resize(e->OrigSize);
+          if (!lz4::Decompress(src, e->Size, Data.data(), Data.size()))
+          {
+            tse::logger::Warn("VFS damaged entry " + FileName + " in " + pack->FileName);
+            Data.clear();
+            return FALSE;
+          }
+        }
+        PackReads++;
+        PackBytes += Data.size();
+        return TRUE;
+      }
+
+      std::fstream f(FileName, std::fstream::in | std::fstream::binary);
+      if (!f.is_open())
+        return FALSE;
+      f.seekg(0, std::fstream::end);
+      SIZE_T flen = f.tellg();
+      f.seekg(0, std::fstream::beg);
+      Data.resize(flen);
+      f.read((CHAR *)Data.data(), flen);
+      LooseReads++;
+      LooseBytes += flen;
+      return TRUE;
+    } /* End of 'Read' function */
+
+    /* Read whole text file function.
+     * ARGUMENTS:
+     *   - file name:
+     *       const std::string &FileName;
+     *   - existing loose file is read instead of packed one flag:
+     *       BOOL IsLooseFirst;
+     * RETURNS:
+     *   (std::string) file text (empty if file is not found).
+     */
+    static std::string ReadText( const std::string &FileName, BOOL IsLooseFirst = FALSE )
+    {
+      std::vector<BYTE> data;
+      if (!Read(FileName, data, IsLooseFirst))
+        return {};
+      /* Text mode reading drops carriage returns */
+      std::string text;
+      text.reserve(data.size());
+      for (BYTE c : data)
+        if (c != '\r')
+          text += (CHAR)c;
+      return text;
+    } /* End of 'ReadText' function */
+
+    /* Obtain mounted packs files list function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (std::vector<std::string>) normalized file names.
+     */
+    static std::vector<std::string> List( VOID )
+    {
+      std::vector<std::string> names;
+      for (auto &p : Packs)
+        for (UINT32 i = 0; i < p->Hdr->NumOfEntries; i++)
+          names.emplace_back(p->Names + p->Entries[i].NameOffset, p->Entries[i].NameLength);
+      return names;
+    } /* End of 'List' function */
+
+    /* Obtain reading statistics function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (STATS) statistics.
+     */
+    static STATS Stats( VOID )
+    {
+      return {PackReads, LooseReads, PackBytes, LooseBytes, (INT)Packs.size()};
+    } /* End of 'Stats' function */
+
+    /* Build pack from directory files function.
+     * Files and directories starting with '~' (caches, logs) are skipped.
+     * ARGUMENTS:
+     *   - directory to pack (relative to working directory):
+     *       const std::string &Dir;
+     *   - pack file name:
+     *       const std::string &PackFileName;
+     *   - compression flag (entries which do not shrink are stored):
+     *       BOOL IsCompress;
+     *   - building statistics:
+     *       BUILD_STATS &Stats;
+     * RETURNS:
+     *   (BOOL) TRUE if success.
+     */
+    static BOOL Build( const std::string &Dir, const std::string &PackFileName, BOOL IsCompress, BUILD_STATS &Stats )
+    {
+      auto start = std::chrono::steady_clock::now();
+      Stats = {};
+
+      /* Collect files (sorted for reproducible packs) */
+      std::error_code ec;
+      std::string pack_name = Normalize(PackFileName);
+      std::vector<std::pair<std::string, std::string>> files; // Normalized and disk names
+      for (auto &de : std::filesystem::recursive_directory_iterator(Dir, ec))
+      {
+        std::string name = Normalize(de.path().generic_string());
+        if (!de.is_regular_file(ec) || name == pack_name || name.ends_with(".tpk") ||
+            name.starts_with("~") || name.find("/~") != std::string::npos)
+          continue;
+        files.emplace_back(name, de.path().string());
+      }
+      std::sort(files.begin(), files.end());
+      if (files.size() >= 0x7FFFFFFF)
+        return FALSE;
+
+      std::fstream out(PackFileName, std::fstream::out | std::fstream::binary | std::fstream::trunc);
+      if (!out.is_open())
+      {
+        tse::logger::Warn("VFS can't create pack " + PackFileName);
+        return FALSE;
+      }
+      auto Align = [&out]( VOID )
+        {
+          UINT64 pos = out.tellp();
+          static const CHAR zeros[Alignment] {};
+          if (pos % Alignment != 0)
+            out.write(zeros, Alignment - pos % Alignment);
+          return (UINT64)out.tellp();
+        };
+      HEADER hdr {};
+      out.write((const CHAR *)&hdr, sizeof(hdr));
+      Align();
+
+      /* Entries data */
+      std::vector<ENTRY> entries;
+      std::string names;
+      std::vector<BYTE> data, packed;
+      for (auto &[name, disk_name] : files)
+      {
+        if (!Read(disk_name, data))
+        {
+          tse::logger::Warn("VFS can't read " + disk_name);
+          continue;
+        }
+        ENTRY e {};
+        e.Hash = Hash64(name);
+        e.Offset = Align();
+        e.OrigSize = data.size();
+        e.NameOffset = (UINT32)names.size();
+        e.NameLength = (UINT32)name.size();
+        names += name;
+
+        /* Compression should save at least 1/16 */
+        SIZE_T size = 0;
+        if (IsCompress && data.size() >= 64)
+        {
+          packed.resize(lz4::Bound(data.size()));
+          size = lz4::Compress(data.data(), data.size(), packed.data(), packed.size());
+        }
+        if (size != 0 && size < data.size() - data.size() / 16)
+        {
+          e.Codec = codec::LZ4;
+          e.Size = size;
+          out.write((const CHAR *)packed.data(), size);
+          Stats.Compressed++;
+        }
+        else
+        {
+          e.Codec = codec::STORE;
+          e.Size = data.size();
+          out.write((const CHAR *)data.data(), data.size());
+        }
+        entries.push_back(e);
+        Stats.Files++;
+        Stats.Bytes += e.OrigSize;
+        Stats.StoredBytes += e.Size;
+      }
+
+      /* Table of contents: entries, hash table with half load at most, names */
+      UINT32 num_of_buckets = 16;
+      while (num_of_buckets < entries.size() * 2)
+        num_of_buckets *= 2;
+      std::vector<UINT32> buckets(num_of_buckets, 0);
+      for (UINT32 i = 0; i < entries.size(); i++)
+      {
+        UINT32 b = (UINT32)entries[i].Hash & (num_of_buckets - 1);
+        while (buckets[b] != 0)
+          b = (b + 1) & (num_of_buckets - 1);
+        buckets[b] = i + 1;
+      }
+      hdr.TocOffset = Align();
+      out.write((const CHAR *)entries.data(), entries.size() * sizeof(ENTRY));
+      out.write((const CHAR *)buckets.data(), buckets.size() * sizeof(UINT32));
+      out.write(names.data(), names.size());
+      hdr.TocSize = (UINT64)out.tellp() - hdr.TocOffset;
+
+      memcpy(hdr.Sign, "TPAK", 4);
+      hdr.Version = Version;
+      hdr.NumOfEntries = (UINT32)entries.size();
+      hdr.NumOfBuckets = num_of_buckets;
+      Stats.PackSize = out.tellp();
+      out.seekp(0);
+      out.write((const CHAR *)&hdr, sizeof(hdr));
+      out.close();
+      Stats.Time = std::chrono::duration<DBL, std::milli>(std::chrono::steady_clock::now() - start).count();
+      return !out.fail();
+    } /* End of 'Build' function */
+
+  }; /* End of 'vfs' class */
+
+} /* end of 'tse' namespace */
+
+#endif /* __vfs_h_ */
+
+/* END OF 'vfs.h' FILE */